@@ -0,0 +1,46 @@
+/**
+ * @file deepSeekBaseline.cpp
+ * @brief Wraps the serial solver in misc/deepSeekPSO.cpp so it can be benchmarked.
+ *
+ * The file is compiled inside its own namespace so its Particle struct and free
+ * functions do not collide with the library, and its main() is renamed.
+ */
+
+#include "ObjectiveFunction.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "deepSeekBaseline.hpp"
+
+namespace deepseek {
+#define main deepSeekMain
+#include "../misc/deepSeekPSO.cpp"
+#undef main
+}
+
+/**
+ * @brief Run the serial baseline without writing any files.
+ *
+ * @return double The best distance found.
+ */
+double runDeepSeekBaseline() {
+    using namespace deepseek;
+    std::vector<Particle> particles(NUM_PARTICLES);
+    std::vector<int> globalBestPosition(NUM_CITIES);
+    double globalBestFitness = INFINITY;
+
+    auto cityCoordinates = generateCityCoordinates(NUM_CITIES);
+    auto distances = initializeDistanceMatrix(cityCoordinates);
+
+    std::ofstream discard;
+    initializeParticles(particles, globalBestPosition, globalBestFitness, distances);
+    runPSO(particles, globalBestPosition, globalBestFitness, discard, distances);
+    return globalBestFitness;
+}
@@ -0,0 +1,8 @@
+#ifndef DEEP_SEEK_BASELINE_HPP
+#define DEEP_SEEK_BASELINE_HPP
+
+// Runs the serial reference solver from misc/deepSeekPSO.cpp once, end to end,
+// on NUM_CITIES random cities and returns the best distance found.
+double runDeepSeekBaseline();
+
+#endif
@@ -0,0 +1,519 @@
+/**
+ * @file psoBenchmarks.cpp
+ * @brief Google Benchmark suite for the PSO-TSP hot paths.
+ *
+ * Each stage of a solve is measured on its own, parameterised over city count,
+ * particle count and thread count. Run `pso_bench --benchmark_out=run.json
+ * --benchmark_out_format=json` (or the pso_bench_json target) to get JSON that can be
+ * diffed between commits. Instances whose dense matrix would exceed
+ * PSO_BENCH_MAX_MATRIX_MB (default 2048) are skipped. Real instances are read from
+ * the instances directory.
+ */
+
+#include <benchmark/benchmark.h>
+#include "psoDefinition.hpp"
+#include "solveServiceDefinition.hpp"
+#include "fleetPlannerDefinition.hpp"
+#include "deepSeekBaseline.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+namespace {
+
+const std::vector<std::int64_t> CITY_COUNTS = {40, 200, 1000, 5000, 10000, 50000};
+const std::vector<std::int64_t> SOLVER_CITY_COUNTS = {40, 1000, 5000};
+const std::vector<std::int64_t> PARTICLE_COUNTS = {4, 64, 512};
+const std::vector<std::int64_t> THREAD_COUNTS = {1, 2, 4, 8};
+const std::vector<std::int64_t> TABLE_STORAGES = {static_cast<std::int64_t>(DistanceMatrix::Storage::Dense),
+                                                   static_cast<std::int64_t>(DistanceMatrix::Storage::Float32),
+                                                   static_cast<std::int64_t>(DistanceMatrix::Storage::Fixed32),
+                                                   static_cast<std::int64_t>(DistanceMatrix::Storage::Fixed16)};
+
+/**
+ * @brief Skip the benchmark if a dense matrix for numCities would exceed the memory cap.
+ */
+bool skipIfTooLarge(benchmark::State &state, std::int64_t numCities) {
+    std::size_t capMB = 2048;
+    if (const char *env = std::getenv("PSO_BENCH_MAX_MATRIX_MB")) {
+        capMB = std::strtoull(env, nullptr, 10);
+    }
+    double bytes = static_cast<double>(numCities) * static_cast<double>(numCities) * sizeof(double);
+    if (bytes > static_cast<double>(capMB) * 1024.0 * 1024.0) {
+        state.SkipWithError("distance matrix exceeds PSO_BENCH_MAX_MATRIX_MB");
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Seed a solver and generate its cities; tracing is off so only solver work is timed.
+ */
+void prepare(PSO &algo, int numCities, int numThreads) {
+    algo.setSeed(12345);
+    algo.setNumThreads(numThreads);
+    algo.setTraceSampling(TraceSampling::Off);
+    algo.generateCityCoordinates(numCities);
+}
+
+}
+
+static void BM_InitializeDistanceMatrix(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    if (skipIfTooLarge(state, numCities)) {
+        return;
+    }
+    PSO algo;
+    prepare(algo, numCities, static_cast<int>(state.range(1)));
+    for (auto _ : state) {
+        algo.initializeDistanceMatrix();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numCities * numCities);
+}
+BENCHMARK(BM_InitializeDistanceMatrix)
+    ->ArgsProduct({CITY_COUNTS, THREAD_COUNTS})
+    ->ArgNames({"cities", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_CalculateDistance(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    if (skipIfTooLarge(state, numCities)) {
+        return;
+    }
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.initializeDistanceMatrix();
+    std::vector<int> route(numCities);
+    std::iota(route.begin(), route.end(), 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algo.calculateDistance(route, numCities));
+    }
+    state.SetItemsProcessed(state.iterations() * numCities);
+}
+BENCHMARK(BM_CalculateDistance)->ArgsProduct({CITY_COUNTS})->ArgNames({"cities"});
+
+static void BM_CalculateDistanceOnDemand(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.setDistanceStorage(DistanceMatrix::Storage::OnDemand);
+    algo.initializeDistanceMatrix();
+    std::vector<int> route(numCities);
+    std::iota(route.begin(), route.end(), 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algo.calculateDistance(route, numCities));
+    }
+    state.SetItemsProcessed(state.iterations() * numCities);
+}
+BENCHMARK(BM_CalculateDistanceOnDemand)->ArgsProduct({CITY_COUNTS})->ArgNames({"cities"});
+
+/**
+ * @brief Random-access tour scoring; range(1) is the DistanceMatrix::Storage of the table.
+ *
+ * A shuffled tour touches a new table row on every edge, so the time per edge tracks how
+ * much of the table fits in cache. tableMB reports the footprint.
+ */
+static void BM_CalculateDistanceStorage(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    if (skipIfTooLarge(state, numCities)) {
+        return;
+    }
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.setDistanceStorage(static_cast<DistanceMatrix::Storage>(state.range(1)));
+    algo.initializeDistanceMatrix();
+    std::vector<int> route(numCities);
+    std::iota(route.begin(), route.end(), 0);
+    std::shuffle(route.begin(), route.end(), std::mt19937(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algo.calculateDistance(route, numCities));
+    }
+    state.SetItemsProcessed(state.iterations() * numCities);
+    state.counters["tableMB"] = algo.getDistanceMatrix().memoryBytes() / (1024.0 * 1024.0);
+}
+BENCHMARK(BM_CalculateDistanceStorage)
+    ->ArgsProduct({{1000, 5000, 10000}, TABLE_STORAGES})
+    ->ArgNames({"cities", "storage"});
+
+/**
+ * @brief A full seeded solve on each table layout, reporting the exact length it found.
+ *
+ * Compare exactDistance across storage values to see what the rounding costs in tour
+ * quality; searchedDistance is the length on the table the search used.
+ */
+static void BM_RunPSOStorage(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.setDistanceStorage(static_cast<DistanceMatrix::Storage>(state.range(1)));
+    algo.initializeDistanceMatrix();
+    std::ofstream discard;
+    for (auto _ : state) {
+        state.PauseTiming();
+        algo.initializeParticles(64, numCities);
+        state.ResumeTiming();
+        algo.runPSO(discard, numCities);
+    }
+    state.counters["searchedDistance"] = algo.getGlobalBestFitness();
+    state.counters["exactDistance"] = algo.getExactBestFitness();
+    state.counters["tableMB"] = algo.getDistanceMatrix().memoryBytes() / (1024.0 * 1024.0);
+}
+BENCHMARK(BM_RunPSOStorage)
+    ->ArgsProduct({{200, 1000}, TABLE_STORAGES})
+    ->ArgNames({"cities", "storage"})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_BuildCandidateLists(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    bool kdTree = state.range(1) != 0;
+    if (!kdTree && skipIfTooLarge(state, numCities)) {
+        return;
+    }
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.setDistanceStorage(kdTree ? DistanceMatrix::Storage::OnDemand : DistanceMatrix::Storage::Dense);
+    algo.initializeDistanceMatrix();
+    NeighbourLists lists;
+    for (auto _ : state) {
+        if (kdTree) {
+            lists.build(algo.getCityList(), 8);
+        } else {
+            lists.build(algo.getDistanceMatrix(), 8);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numCities);
+}
+BENCHMARK(BM_BuildCandidateLists)
+    ->ArgsProduct({CITY_COUNTS, {0, 1}})
+    ->ArgNames({"cities", "kdtree"})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_EvaluateSwarm(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    int numParticles = static_cast<int>(state.range(1));
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.initializeDistanceMatrix();
+    algo.initializeParticles(numParticles, numCities);
+    const Swarm &swarm = algo.getSwarm();
+    std::vector<double> lengths(numParticles);
+    for (auto _ : state) {
+        evaluateTours(algo.getDistanceMatrix(), swarm.getRouteArena(), swarm.getRouteStride(), numParticles,
+                      numCities, lengths.data());
+        benchmark::DoNotOptimize(lengths.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numParticles * numCities);
+}
+BENCHMARK(BM_EvaluateSwarm)
+    ->ArgsProduct({SOLVER_CITY_COUNTS, PARTICLE_COUNTS})
+    ->ArgNames({"cities", "particles"});
+
+static void BM_InitializeParticles(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    int numParticles = static_cast<int>(state.range(1));
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.initializeDistanceMatrix();
+    for (auto _ : state) {
+        algo.initializeParticles(numParticles, numCities);
+    }
+    state.SetItemsProcessed(state.iterations() * numParticles);
+}
+BENCHMARK(BM_InitializeParticles)
+    ->ArgsProduct({SOLVER_CITY_COUNTS, PARTICLE_COUNTS})
+    ->ArgNames({"cities", "particles"});
+
+/**
+ * @brief One swarm iteration; range(3) selects 0 = work-stealing pool, 1 = thread per particle.
+ */
+static void BM_UpdateParticles(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    int numParticles = static_cast<int>(state.range(1));
+    PSO algo;
+    prepare(algo, numCities, static_cast<int>(state.range(2)));
+    algo.setExecutionMode(state.range(3) == 0 ? ExecutionMode::WorkStealingPool : ExecutionMode::ThreadPerParticle);
+    algo.initializeDistanceMatrix();
+    algo.initializeParticles(numParticles, numCities);
+    std::ofstream discard;
+    algo.beginRun(discard, numCities);
+    int iteration = 0;
+    for (auto _ : state) {
+        algo.updateParticles(iteration++, discard, numCities);
+    }
+    algo.endRun();
+    state.SetItemsProcessed(state.iterations() * numParticles);
+}
+BENCHMARK(BM_UpdateParticles)
+    ->ArgsProduct({SOLVER_CITY_COUNTS, PARTICLE_COUNTS, THREAD_COUNTS, {0}})
+    ->ArgsProduct({SOLVER_CITY_COUNTS, PARTICLE_COUNTS, {1}, {1}})
+    ->ArgNames({"cities", "particles", "threads", "perParticle"})
+    ->UseRealTime();
+
+/**
+ * @brief One swarm iteration on a small mission; range(2) selects 1 = fixed-size kernels, 0 = generic update.
+ */
+static void BM_UpdateParticlesSmall(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    int numParticles = static_cast<int>(state.range(1));
+    PSO algo;
+    prepare(algo, numCities, 1);
+    algo.setFixedSizeKernels(state.range(2) != 0);
+    algo.initializeDistanceMatrix();
+    algo.initializeParticles(numParticles, numCities);
+    std::ofstream discard;
+    algo.beginRun(discard, numCities);
+    int iteration = 0;
+    for (auto _ : state) {
+        algo.updateParticles(iteration++, discard, numCities);
+    }
+    algo.endRun();
+    state.SetItemsProcessed(state.iterations() * numParticles);
+}
+BENCHMARK(BM_UpdateParticlesSmall)
+    ->ArgsProduct({{10, 16, 32, 64}, {4, 64}, {0, 1}})
+    ->ArgNames({"cities", "particles", "fixed"});
+
+static void BM_RunPSO(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    int numParticles = static_cast<int>(state.range(1));
+    PSO algo;
+    prepare(algo, numCities, static_cast<int>(state.range(2)));
+    algo.initializeDistanceMatrix();
+    std::ofstream discard;
+    for (auto _ : state) {
+        state.PauseTiming();
+        algo.initializeParticles(numParticles, numCities);
+        state.ResumeTiming();
+        algo.runPSO(discard, numCities);
+    }
+    state.counters["bestDistance"] = algo.getGlobalBestFitness();
+}
+BENCHMARK(BM_RunPSO)
+    ->ArgsProduct({{40, 1000}, {4, 64}, {1, 4}})
+    ->ArgNames({"cities", "particles", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief Re-planning after a waypoint is added and another removed; range(2) selects
+ *        0 = patch the matrix and repair the swarm, 1 = rebuild both from scratch.
+ *
+ * The cold variant loads the already changed waypoint set, so it times only the rebuild.
+ */
+static void BM_ReplanCity(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    int numParticles = static_cast<int>(state.range(1));
+    bool cold = state.range(2) != 0;
+    PSO algo;
+    prepare(algo, numCities, 1);
+    TSPInstance replanned{"replanned", algo.getCityList()};
+    replanned.cityList.erase(replanned.cityList.begin());
+    replanned.cityList.push_back(std::make_shared<City>(numCities));
+    replanned.cityList.back()->setCoordinates(0.5, 0.5, 0.5);
+    algo.initializeDistanceMatrix();
+    algo.initializeParticles(numParticles, numCities);
+    for (auto _ : state) {
+        if (cold) {
+            algo.loadInstance(replanned);
+            algo.initializeDistanceMatrix();
+            algo.initializeParticles(numParticles, numCities);
+        } else {
+            algo.insertCity(0.5, 0.5, 0.5);
+            algo.removeCity(0);
+        }
+    }
+    state.counters["bestDistance"] = algo.getGlobalBestFitness();
+}
+BENCHMARK(BM_ReplanCity)
+    ->ArgsProduct({{1000, 5000}, {64}, {0, 1}})
+    ->ArgNames({"cities", "particles", "cold"})
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Parse a generated instance file; range(1) selects 0 = City,X,Y,Z CSV, 1 = TSPLIB EUC_3D.
+ *
+ * TSPLIB loading includes computing the rounded distance table, so it is only run on
+ * sizes whose table fits the memory cap.
+ */
+static void BM_LoadInstance(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    bool tsplib = state.range(1) != 0;
+    if (tsplib && skipIfTooLarge(state, numCities)) {
+        return;
+    }
+    PSO algo;
+    prepare(algo, numCities, 1);
+    std::string path = tsplib ? "pso_bench_instance.tsp" : "pso_bench_instance.csv";
+    {
+        std::ofstream out(path);
+        out << (tsplib ? "NAME: bench\nTYPE: TSP\nDIMENSION: " + std::to_string(numCities) +
+                             "\nEDGE_WEIGHT_TYPE: EUC_3D\nNODE_COORD_SECTION\n"
+                       : std::string("City,X,Y,Z\n"));
+        std::vector<std::shared_ptr<City>> cityList = algo.getCityList();
+        for (int i = 0; i < numCities; i++) {
+            auto [x, y, z] = cityList[i]->getCoordinates();
+            out << (tsplib ? i + 1 : i) << (tsplib ? " " : ",") << x * 1000.0 << (tsplib ? " " : ",") << y * 1000.0
+                << (tsplib ? " " : ",") << z * 1000.0 << "\n";
+        }
+    }
+    for (auto _ : state) {
+        TSPInstance instance = loadInstance(path);
+        benchmark::DoNotOptimize(instance.cityList.data());
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * numCities);
+}
+BENCHMARK(BM_LoadInstance)
+    ->ArgsProduct({{1000, 10000, 100000}, {0, 1}})
+    ->ArgNames({"cities", "tsplib"})
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief A seeded memetic solve of berlin52 from TSPLIB, reporting the gap to its optimum of 7542.
+ */
+static void BM_RunPSOBerlin52(benchmark::State &state) {
+    TSPInstance instance = loadInstance(PSO_INSTANCE_DIR "/berlin52.tsp");
+    PSOConfig config;
+    config.numCities = instance.size();
+    config.numParticles = 32;
+    config.maxIterations = 200;
+    config.memeticMode = MemeticMode::GlobalBest;
+    PSO algo(config);
+    algo.setSeed(12345);
+    algo.setNumThreads(1);
+    algo.setTraceSampling(TraceSampling::Off);
+    algo.loadInstance(instance);
+    algo.initializeDistanceMatrix();
+    std::ofstream discard;
+    for (auto _ : state) {
+        state.PauseTiming();
+        algo.initializeParticles(config.numParticles, config.numCities);
+        state.ResumeTiming();
+        algo.runPSO(discard, config.numCities);
+    }
+    state.counters["bestDistance"] = algo.getExactBestFitness();
+    state.counters["gapPercent"] = 100.0 * optimalityGap(algo.getExactBestFitness(), algo.getKnownOptimum());
+}
+BENCHMARK(BM_RunPSOBerlin52)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Throughput of 64 small independent jobs through a SolveService with range(0) workers.
+ */
+static void BM_SolveServiceThroughput(benchmark::State &state) {
+    constexpr int NUM_JOBS = 64;
+    SolveService service(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        std::vector<std::future<SolveResult>> results;
+        for (int i = 0; i < NUM_JOBS; i++) {
+            SolveRequest request;
+            request.seed = static_cast<std::uint64_t>(i);
+            request.config.numCities = 30;
+            request.config.numParticles = 16;
+            request.config.maxIterations = 200;
+            results.push_back(service.submit(std::move(request)));
+        }
+        for (auto &result : results) {
+            benchmark::DoNotOptimize(result.get().fitness);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_JOBS);
+}
+BENCHMARK(BM_SolveServiceThroughput)
+    ->ArgsProduct({{1, 2, 4}})
+    ->ArgNames({"workers"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief A full multi-drone plan of 400 waypoints for range(0) drones, reporting the makespan.
+ */
+static void BM_FleetPlan(benchmark::State &state) {
+    PSOConfig config;
+    config.numCities = 400;
+    config.numParticles = 16;
+    config.maxIterations = 200;
+    FleetConfig fleetConfig;
+    fleetConfig.numDrones = static_cast<int>(state.range(0));
+    double makespan = 0.0, total = 0.0;
+    for (auto _ : state) {
+        FleetPlanner planner(config, fleetConfig, 12345);
+        planner.run();
+        makespan = planner.getMakespan();
+        total = planner.getTotalLength();
+    }
+    state.counters["makespan"] = makespan;
+    state.counters["totalDistance"] = total;
+}
+BENCHMARK(BM_FleetPlan)
+    ->ArgsProduct({{1, 2, 4, 8}})
+    ->ArgNames({"drones"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * @brief Re-solving a mission of range(0) waypoints; range(1) selects 0 = no solution
+ *        cache, 1 = a cache that already holds the mission's tour.
+ */
+static void BM_RepeatMission(benchmark::State &state) {
+    int numCities = static_cast<int>(state.range(0));
+    bool cached = state.range(1) != 0;
+    std::string path = "pso_bench_cache.psoc";
+    std::remove(path.c_str());
+    PSOConfig config;
+    config.numCities = numCities;
+    PSO algo(config);
+    prepare(algo, numCities, 1);
+    std::ofstream discard;
+    if (cached) {
+        algo.setSolutionCache(std::make_shared<SolutionCache>(path));
+        algo.initializeDistanceMatrix();
+        algo.initializeParticles(config.numParticles, numCities);
+        algo.runPSO(discard, numCities);
+    }
+    for (auto _ : state) {
+        algo.initializeDistanceMatrix();
+        algo.initializeParticles(config.numParticles, numCities);
+        algo.runPSO(discard, numCities);
+    }
+    std::remove(path.c_str());
+    state.counters["bestDistance"] = algo.getExactBestFitness();
+}
+BENCHMARK(BM_RepeatMission)
+    ->ArgsProduct({{100, 1000}, {0, 1}})
+    ->ArgNames({"cities", "cached"})
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief The serial solver from misc/deepSeekPSO.cpp (NUM_CITIES cities, NUM_PARTICLES particles).
+ */
+static void BM_DeepSeekBaseline(benchmark::State &state) {
+    double best = 0.0;
+    for (auto _ : state) {
+        best = runDeepSeekBaseline();
+    }
+    state.counters["bestDistance"] = best;
+}
+BENCHMARK(BM_DeepSeekBaseline)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief The library solver on the same end-to-end workload as BM_DeepSeekBaseline.
+ */
+static void BM_RunPSOBaselineShape(benchmark::State &state) {
+    PSO algo;
+    prepare(algo, NUM_CITIES, 1);
+    std::ofstream discard;
+    for (auto _ : state) {
+        algo.generateCityCoordinates(NUM_CITIES);
+        algo.initializeDistanceMatrix();
+        algo.initializeParticles(NUM_PARTICLES, NUM_CITIES);
+        algo.runPSO(discard, NUM_CITIES);
+    }
+    state.counters["bestDistance"] = algo.getGlobalBestFitness();
+}
+BENCHMARK(BM_RunPSOBaselineShape)->Unit(benchmark::kMillisecond)->UseRealTime();
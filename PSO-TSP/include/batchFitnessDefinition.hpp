@@ -0,0 +1,10 @@
+#ifndef BATCH_FITNESS_DEFINITION_HPP
+#define BATCH_FITNESS_DEFINITION_HPP
+
+#include <cstddef>
+#include "distanceMatrixDefinition.hpp"
+
+void evaluateTours(const DistanceMatrix &distances, const int *routes, std::size_t routeStride, int numRoutes,
+                   int numCities, double *out);
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef DISTANCE_MATRIX_DEFINITION_HPP
+#define DISTANCE_MATRIX_DEFINITION_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+#include "cityDefinition.hpp"
+
+class ThreadPool;
+
+class DistanceMatrix {
+    public:
+        enum class Storage {
+            Dense,
+            PackedUpper,
+            OnDemand,
+            Float32,
+            Fixed32,
+            Fixed16
+        };
+
+        // Row-major n x n table, rows padded to a whole number of cache lines.
+        struct DenseView {
+            const double *data;
+            std::size_t stride;
+            double operator()(int i, int j) const {return data[i * stride + j];}
+        };
+
+        // Strict upper triangle of a symmetric table, row by row.
+        struct PackedView {
+            const double *data;
+            std::size_t numCities;
+            double operator()(int i, int j) const {
+                if (i == j) {
+                    return 0.0;
+                }
+                std::size_t a = i < j ? i : j;
+                std::size_t b = i < j ? j : i;
+                return data[a * numCities - a * (a + 1) / 2 + (b - a - 1)];
+            }
+        };
+
+        // City coordinates only; every lookup computes the distance. Linear memory for
+        // instances too large for a table.
+        struct OnDemandView {
+            const double *xs;
+            const double *ys;
+            const double *zs;
+            double operator()(int i, int j) const {
+                double dx = xs[i] - xs[j];
+                double dy = ys[i] - ys[j];
+                double dz = zs[i] - zs[j];
+                return std::sqrt(dx * dx + dy * dy + dz * dz);
+            }
+        };
+
+        // Dense table of single-precision distances; half the footprint of DenseView.
+        struct FloatView {
+            const float *data;
+            std::size_t stride;
+            double operator()(int i, int j) const {return data[i * stride + j];}
+        };
+
+        // Dense table of fixed-point distances in units of scale. The scale maps the
+        // diagonal of the cities' bounding box to the largest value of T, so every
+        // distance is within scale / 2 of the exact one.
+        template <typename T>
+        struct FixedView {
+            const T *data;
+            std::size_t stride;
+            double scale;
+            double operator()(int i, int j) const {return data[i * stride + j] * scale;}
+        };
+
+        static constexpr std::size_t CACHE_LINE_BYTES = 64;
+        static constexpr int TILE_SIZE = 64;
+
+        DistanceMatrix() {};
+        ~DistanceMatrix() {};
+
+        void build(const std::vector<std::shared_ptr<City>> &cityList, Storage storage = Storage::Dense,
+                   ThreadPool *pool = nullptr);
+        void build(std::span<const double> table, int numCities, Storage storage = Storage::Dense);
+        void insertCity(const std::vector<std::shared_ptr<City>> &cityList);
+        void removeCity(int city, const std::vector<std::shared_ptr<City>> &cityList);
+
+        int size() const {return numCities;}
+        Storage getStorage() const {return storage;}
+        std::size_t memoryBytes() const {
+            return capacity * sizeof(double) + reducedBytes;
+        }
+        bool isReducedPrecision() const {
+            return storage == Storage::Float32 || storage == Storage::Fixed32 || storage == Storage::Fixed16;
+        }
+        double getScale() const {return scale;}
+        double exactTourLength(std::span<const int> route) const;
+
+        double operator()(int i, int j) const {
+            switch (storage) {
+                case Storage::Dense: return DenseView{data.get(), stride}(i, j);
+                case Storage::PackedUpper: return PackedView{data.get(), static_cast<std::size_t>(numCities)}(i, j);
+                case Storage::OnDemand: return onDemandView()(i, j);
+                case Storage::Float32: return FloatView{reducedData<float>(), reducedStride}(i, j);
+                case Storage::Fixed32: return fixedView<std::uint32_t>()(i, j);
+                case Storage::Fixed16: break;
+            }
+            return fixedView<std::uint16_t>()(i, j);
+        }
+
+        /**
+         * @brief Call visitor with the concrete view of the current storage.
+         *
+         * Hot loops dispatch once per call through this function so that every
+         * lookup inside the loop is a plain indexed load.
+         */
+        template <typename Visitor>
+        decltype(auto) visit(Visitor &&visitor) const {
+            if (storage == Storage::Dense) {
+                return visitor(DenseView{data.get(), stride});
+            }
+            if (storage == Storage::OnDemand) {
+                return visitor(onDemandView());
+            }
+            if (storage == Storage::Float32) {
+                return visitor(FloatView{reducedData<float>(), reducedStride});
+            }
+            if (storage == Storage::Fixed32) {
+                return visitor(fixedView<std::uint32_t>());
+            }
+            if (storage == Storage::Fixed16) {
+                return visitor(fixedView<std::uint16_t>());
+            }
+            return visitor(PackedView{data.get(), static_cast<std::size_t>(numCities)});
+        }
+
+        /**
+         * @brief Like visit, but with full double-precision distances.
+         *
+         * The reduced-precision layouts keep the city coordinates next to their table,
+         * so this visits an OnDemandView over them; the other layouts are already exact.
+         */
+        template <typename Visitor>
+        decltype(auto) visitExact(Visitor &&visitor) const {
+            if (isReducedPrecision()) {
+                return visitor(onDemandView());
+            }
+            return visit(std::forward<Visitor>(visitor));
+        }
+
+    private:
+        struct AlignedDeleter {
+            void operator()(void *ptr) const {std::free(ptr);}
+        };
+
+        int numCities = 0;
+        std::size_t stride = 0;
+        std::size_t capacity = 0;
+        Storage storage = Storage::Dense;
+        std::unique_ptr<double[], AlignedDeleter> data;
+        std::unique_ptr<std::byte[], AlignedDeleter> reduced;
+        std::size_t reducedStride = 0;
+        std::size_t reducedBytes = 0;
+        double scale = 1.0;
+
+        OnDemandView onDemandView() const {return {data.get(), data.get() + stride, data.get() + 2 * stride};}
+        template <typename T>
+        const T *reducedData() const {return reinterpret_cast<const T *>(reduced.get());}
+        template <typename T>
+        FixedView<T> fixedView() const {return {reducedData<T>(), reducedStride, scale};}
+
+        void allocate(std::size_t count);
+        void growStride(std::size_t newStride, std::size_t rows);
+        template <typename T>
+        void buildReduced(ThreadPool *pool);
+        void buildTile(int rowTile, int colTile, const std::vector<double> &xs, const std::vector<double> &ys,
+                       const std::vector<double> &zs);
+};
+
+void computeRowDistances(double x, double y, double z, const double *xs, const double *ys, const double *zs,
+                         int count, double *out);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef FIXED_SIZE_KERNEL_DEFINITION_HPP
+#define FIXED_SIZE_KERNEL_DEFINITION_HPP
+
+#include <memory>
+#include <span>
+#include "distanceMatrixDefinition.hpp"
+#include "psoConfigDefinition.hpp"
+
+/**
+ * @brief Particle-update steps specialised at compile time for one city count.
+ *
+ * Small missions spend most of their time in loop overhead and indexed loads from a
+ * table sized at run time. An implementation for exactly N cities keeps its own
+ * N x N copy of the distances (32 KB at N = 64, so it stays in L1), works on the tour
+ * in a std::array and lets the compiler unroll every loop over the cities. The steps
+ * do the same arithmetic in the same order as the generic update, so a seeded run
+ * gives the same tours either way.
+ */
+class SmallTourKernel {
+    public:
+        static constexpr int MIN_CITIES = 4;
+        static constexpr int MAX_CITIES = 64;
+
+        virtual ~SmallTourKernel() {};
+
+        virtual int numCities() const = 0;
+        virtual double tourLength(std::span<const int> route) const = 0;
+        virtual void steer(std::span<double> velocity, std::span<const double> draws, std::span<const int> bestRoute,
+                           std::span<const int> route, std::span<const int> globalBestRoute,
+                           const PSOConfig &config) const = 0;
+        virtual double applySwaps(std::span<const double> velocity, std::span<const int> route,
+                                  std::span<int> candidate, double length) const = 0;
+};
+
+std::unique_ptr<SmallTourKernel> makeSmallTourKernel(const DistanceMatrix &distances);
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef FLEET_PLANNER_DEFINITION_HPP
+#define FLEET_PLANNER_DEFINITION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "psoDefinition.hpp"
+
+/**
+ * @brief How the waypoints are first split among the drones.
+ *
+ * Clusters assigns every waypoint to its nearest k-means centroid. Balanced uses the
+ * same centroids but caps every drone at ceil(n / K) waypoints, placing the waypoints
+ * with the most to lose first, so no drone starts with far more work than the others.
+ */
+enum class PartitionMethod {
+    Clusters,
+    Balanced
+};
+
+/**
+ * @brief Shape of a multi-drone plan: how many drones and how their tours are balanced.
+ *
+ * After the first solve, up to rebalanceRounds rounds move boundary waypoints off the
+ * drone with the longest tour; the drones that changed then continue their search for
+ * rebalanceIterations iterations.
+ */
+struct FleetConfig {
+    int numDrones = 4;
+    PartitionMethod partition = PartitionMethod::Balanced;
+    int rebalanceRounds = 3;
+    int rebalanceIterations = 50;
+
+    void validate() const;
+};
+
+bool parseFleetArgument(FleetConfig &config, const std::string &argument);
+
+/**
+ * @brief One drone's closed tour, in the waypoint indices of the whole mission.
+ */
+struct DroneRoute {
+    std::vector<int> route;
+    double length = 0.0;
+};
+
+/**
+ * @brief Plans closed tours for K drones that together visit every waypoint once (mTSP).
+ *
+ * The waypoints are partitioned among the drones, and every drone's tour is solved by
+ * its own PSO, all drones in parallel. The plan minimises the makespan, the longest
+ * tour: rebalancing rounds move waypoints from the longest tour to the drone that can
+ * take them most cheaply, patch both solvers in place with `PSO::insertCity` and
+ * `PSO::removeCity`, and let the changed drones keep searching. Distances are
+ * Euclidean between the waypoint coordinates. Every drone keeps at least
+ * MIN_WAYPOINTS waypoints.
+ */
+class FleetPlanner {
+    private:
+        PSOConfig config;
+        FleetConfig fleetConfig;
+        std::uint64_t seed;
+        std::vector<std::shared_ptr<City>> cityList;
+        std::vector<int> assignment;
+        std::vector<std::vector<int>> members;
+        std::vector<std::unique_ptr<PSO>> drones;
+        int roundsRun = 0;
+
+        void partition();
+        void solve(const std::vector<int> &changed, int iterations);
+        bool moveWaypoint(std::vector<DroneRoute> &routes, std::vector<int> &changed);
+
+    public:
+        static constexpr int MIN_WAYPOINTS = 3;
+
+        FleetPlanner(const PSOConfig &config, const FleetConfig &fleetConfig, std::uint64_t seed);
+        ~FleetPlanner() {};
+
+        void setCities(const std::vector<std::shared_ptr<City>> &cities);
+        void initialize();
+        int rebalance();
+        void run();
+        void printResults(double executionTime) const;
+
+        int size() const {return static_cast<int>(drones.size());}
+        int getRoundsRun() const {return roundsRun;}
+        const std::vector<int> &getAssignment() const {return assignment;}
+        std::vector<DroneRoute> getRoutes() const;
+        double getMakespan() const;
+        double getTotalLength() const;
+};
+
+#endif
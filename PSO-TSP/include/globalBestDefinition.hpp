@@ -0,0 +1,40 @@
+#ifndef GLOBAL_BEST_DEFINITION_HPP
+#define GLOBAL_BEST_DEFINITION_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Lock-free publication channel for the swarm's global best route.
+ *
+ * The route is double buffered: a writer fills the inactive buffer and then flips the
+ * published index, and a sequence counter lets readers detect the rare case where two
+ * writes overlapped their copy. Readers never take a lock. Writers first compare against
+ * an atomic fitness and only take the writer mutex when they actually improve the best.
+ */
+class GlobalBest {
+    private:
+        std::atomic<double> bestFitness{std::numeric_limits<double>::max()};
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<int> published{0};
+        mutable std::vector<int> routeBuffers[2];
+        std::atomic<double> fitnessBuffers[2];
+        std::mutex writerMutex;
+
+    public:
+        GlobalBest() {};
+        ~GlobalBest() {};
+
+        void reset(int numCities);
+
+        double getFitness() const {return bestFitness.load(std::memory_order_acquire);}
+        bool offer(double fitness, std::span<const int> route);
+        double snapshot(std::span<int> route) const;
+        std::vector<int> getRoute() const;
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef INSTANCE_DEFINITION_HPP
+#define INSTANCE_DEFINITION_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "cityDefinition.hpp"
+
+/**
+ * @brief A problem instance read from disk.
+ *
+ * TSPLIB instances carry their own distance table: EUC_2D and EUC_3D distances are
+ * rounded to the nearest integer as the format specifies, so known optima apply, and
+ * EXPLICIT instances list the table itself. The table is dense, row-major and n x n.
+ * CSV waypoint files have no table; their distances come from the coordinates.
+ */
+struct TSPInstance {
+    std::string name;
+    std::vector<std::shared_ptr<City>> cityList;
+    std::shared_ptr<const std::vector<double>> distances = nullptr;
+    double optimum = 0.0;
+
+    int size() const {return static_cast<int>(cityList.size());}
+    double tourLength(const std::vector<int> &route) const;
+};
+
+TSPInstance loadTsplibInstance(const std::string &path);
+TSPInstance loadCsvInstance(const std::string &path);
+TSPInstance loadInstance(const std::string &path);
+std::vector<int> loadTsplibTour(const std::string &path);
+double optimalityGap(double length, double optimum);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef ISLAND_MODEL_DEFINITION_HPP
+#define ISLAND_MODEL_DEFINITION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "psoDefinition.hpp"
+
+enum class MigrationTopology {
+    Ring,
+    FullyConnected
+};
+
+/**
+ * @brief Shape of an island model: how many swarms and how they exchange routes.
+ */
+struct IslandConfig {
+    int numIslands = static_cast<int>(std::thread::hardware_concurrency());
+    int migrationInterval = 10;
+    int numMigrants = 2;
+    MigrationTopology topology = MigrationTopology::Ring;
+
+    void validate() const;
+};
+
+bool parseIslandArgument(IslandConfig &config, const std::string &argument);
+
+/**
+ * @brief K independent PSO swarms on one shared instance, with periodic migration.
+ *
+ * Every island is a full PSO with its own particles, global best and random streams,
+ * and runs serially on its own thread, so islands never contend with each other.
+ * Every migrationInterval iterations all islands pause, and each sends numMigrants
+ * elites to its neighbours: its global best first, then its best distinct
+ * personal-best routes. The neighbours are the next island in a ring, or every other
+ * island when fully connected. The migrants replace the receiver's worst particles.
+ * Migration happens at fixed iterations in island order, so a run is reproducible
+ * from its seed.
+ */
+class IslandModel {
+    private:
+        PSOConfig config;
+        IslandConfig islandConfig;
+        std::uint64_t seed;
+        std::vector<std::unique_ptr<PSO>> islands;
+        std::shared_ptr<const TSPInstance> instance;
+        int iterationsRun = 0;
+        StopReason stopReason = StopReason::MaxIterations;
+
+        void migrate();
+
+    public:
+        IslandModel(const PSOConfig &config, const IslandConfig &islandConfig, std::uint64_t seed);
+        ~IslandModel() {};
+
+        void setInstance(const TSPInstance &loaded) {instance = std::make_shared<const TSPInstance>(loaded);}
+        void initialize();
+        StopReason run();
+        void printResults(double executionTime) const;
+
+        int size() const {return static_cast<int>(islands.size());}
+        const PSO &getIsland(int i) const {return *islands[i];}
+        int getBestIsland() const;
+        double getBestFitness() const {return islands[getBestIsland()]->getGlobalBestFitness();}
+        std::vector<int> getBestRoute() const {return islands[getBestIsland()]->getGlobalBestRoute();}
+        std::vector<std::shared_ptr<City>> getCityList() const {return islands.front()->getCityList();}
+        int getIterationsRun() const {return iterationsRun;}
+        StopReason getStopReason() const {return stopReason;}
+        std::uint64_t getSeed() const {return seed;}
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef ISLAND_WORKER_DEFINITION_HPP
+#define ISLAND_WORKER_DEFINITION_HPP
+
+#include <cstdint>
+#include <string>
+#include "islandModelDefinition.hpp"
+#include "migrationTransportDefinition.hpp"
+
+/**
+ * @brief Everything one island worker process needs to know about its run.
+ */
+struct WorkerOptions {
+    int worker = 0;
+    int numWorkers = 1;
+    std::uint64_t seed = 1;
+    PSOConfig config;
+    IslandConfig islandConfig;
+    bool resume = false;
+    int crashAfterEpochs = -1;
+};
+
+bool parseWorkerArgument(WorkerOptions &options, const std::string &argument);
+MigrantPacket runIslandWorker(const WorkerOptions &options, MigrationTransport &transport);
+
+#endif
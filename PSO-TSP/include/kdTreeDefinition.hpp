@@ -0,0 +1,37 @@
+#ifndef KD_TREE_DEFINITION_HPP
+#define KD_TREE_DEFINITION_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "cityDefinition.hpp"
+
+/**
+ * @brief Static 3-D k-d tree over city coordinates for nearest-neighbour queries.
+ *
+ * The tree is stored implicitly: the cities are permuted so that every range's
+ * median is its node, split along the range's widest axis. Building takes
+ * O(N log N) time and O(N) memory, and a k-nearest query visits O(k log N) nodes on
+ * typical inputs, so candidate lists no longer need a full distance table.
+ */
+class KdTree {
+    private:
+        std::vector<double> points;
+        std::vector<int> cities;
+        std::vector<unsigned char> axes;
+
+        void buildRange(int begin, int end);
+        void searchRange(int begin, int end, const double *query, int exclude, int k,
+                         std::vector<std::pair<double, int>> &heap) const;
+
+    public:
+        KdTree() {};
+        ~KdTree() {};
+
+        void build(const std::vector<std::shared_ptr<City>> &cityList);
+        void nearest(double x, double y, double z, int k, std::vector<int> &out, int exclude = -1) const;
+
+        int size() const {return static_cast<int>(cities.size());}
+};
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef LOCAL_SEARCH_DEFINITION_HPP
+#define LOCAL_SEARCH_DEFINITION_HPP
+
+#include <span>
+#include <vector>
+#include "distanceMatrixDefinition.hpp"
+
+class ThreadPool;
+
+/**
+ * @brief The k nearest other cities of every city, nearest first.
+ *
+ * Local search only tries moves that create an edge to one of these candidates, which
+ * turns the quadratic 2-opt and Or-opt neighbourhoods into linear ones. The lists are
+ * built either by scanning a distance matrix row by row, or from the city coordinates
+ * through a k-d tree in O(N log N) without any table.
+ */
+class NeighbourLists {
+    private:
+        int numCities = 0;
+        int count = 0;
+        std::vector<int> neighbours;
+
+    public:
+        NeighbourLists() {};
+        ~NeighbourLists() {};
+
+        void build(const DistanceMatrix &distances, int k);
+        void build(const std::vector<std::shared_ptr<City>> &cityList, int k, ThreadPool *pool = nullptr);
+
+        int size() const {return numCities;}
+        int getCount() const {return count;}
+        std::span<const int> operator[](int city) const {
+            return {neighbours.data() + static_cast<std::size_t>(city) * count, static_cast<std::size_t>(count)};
+        }
+};
+
+/**
+ * @brief 2-opt and Or-opt descent over candidate neighbour lists with don't-look bits.
+ *
+ * Cities whose surroundings have not changed since they last failed to yield an
+ * improving move are skipped: only the endpoints of applied moves are queued again.
+ * The scratch arrays are reused between calls, so one instance per thread keeps the
+ * search allocation-free once it has seen the instance size.
+ */
+class LocalSearch {
+    private:
+        static constexpr double EPSILON = 1e-10;
+        static constexpr int MAX_SEGMENT = 3;
+
+        int numCities = 0;
+        std::vector<int> position;
+        std::vector<unsigned char> queued;
+        std::vector<int> queue;
+        int queueHead = 0;
+        int queueSize = 0;
+        int segment[MAX_SEGMENT];
+        long long movesApplied = 0;
+
+        int next(int pos) const {return pos + 1 == numCities ? 0 : pos + 1;}
+        int prev(int pos) const {return pos == 0 ? numCities - 1 : pos - 1;}
+        void prepare(std::span<const int> route);
+        void push(int city);
+        bool pop(int &city);
+        void reverse(std::span<int> route, int first, int last);
+        void moveSegment(std::span<int> route, int start, int length, int after, bool reversed);
+
+        template <typename Distances>
+        bool improveTwoOpt(const Distances &distances, const NeighbourLists &neighbours,
+                           std::span<int> route, int a, double &length);
+        template <typename Distances>
+        bool improveOrOpt(const Distances &distances, const NeighbourLists &neighbours,
+                          std::span<int> route, int a, double &length);
+
+    public:
+        LocalSearch() {};
+        ~LocalSearch() {};
+
+        template <typename Distances>
+        double optimize(const Distances &distances, const NeighbourLists &neighbours,
+                        std::span<int> route, double length);
+
+        long long getMovesApplied() const {return movesApplied;}
+};
+
+/**
+ * @brief Improve a tour with 2-opt and Or-opt moves until neither finds a gain.
+ *
+ * @param distances A distance view callable as distances(a, b); assumed symmetric.
+ * @param neighbours Candidate lists built for the same instance.
+ * @param route The tour, improved in place.
+ * @param length The current length of the tour.
+ * @return double The length after the search, kept up to date from the move deltas.
+ */
+template <typename Distances>
+double LocalSearch::optimize(const Distances &distances, const NeighbourLists &neighbours,
+                             std::span<int> route, double length) {
+    if (route.size() < 5 || neighbours.getCount() == 0) {
+        return length;
+    }
+    prepare(route);
+    int a;
+    while (pop(a)) {
+        if (improveTwoOpt(distances, neighbours, route, a, length) ||
+            improveOrOpt(distances, neighbours, route, a, length)) {
+            movesApplied++;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Apply the first improving 2-opt move that adds an edge from city a to a candidate.
+ *
+ * Both tour neighbours of a are tried as the edge to remove. The candidate scan stops
+ * as soon as the new edge is no shorter than the removed one, since no later candidate
+ * can then give a gain.
+ */
+template <typename Distances>
+bool LocalSearch::improveTwoOpt(const Distances &distances, const NeighbourLists &neighbours,
+                                std::span<int> route, int a, double &length) {
+    for (int forward = 1; forward >= 0; forward--) {
+        int posA = position[a];
+        int aNext = route[forward ? next(posA) : prev(posA)];
+        double removedA = distances(a, aNext);
+        for (int c : neighbours[a]) {
+            double addedA = distances(a, c);
+            if (addedA >= removedA - EPSILON) {
+                break;
+            }
+            int posC = position[c];
+            int cNext = route[forward ? next(posC) : prev(posC)];
+            if (c == aNext || cNext == a) {
+                continue;
+            }
+            double delta = addedA + distances(aNext, cNext) - removedA - distances(c, cNext);
+            if (delta < -EPSILON) {
+                if (forward) {
+                    reverse(route, next(posA), posC);
+                } else {
+                    reverse(route, posA, prev(posC));
+                }
+                length += delta;
+                push(a);
+                push(aNext);
+                push(c);
+                push(cNext);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Apply the first improving Or-opt move of a segment of up to three cities starting at a.
+ *
+ * The segment is reinserted, in either orientation, next to a candidate of one of its
+ * endpoints. Candidates are scanned only while the new edge is shorter than the gain
+ * from cutting the segment out.
+ */
+template <typename Distances>
+bool LocalSearch::improveOrOpt(const Distances &distances, const NeighbourLists &neighbours,
+                               std::span<int> route, int a, double &length) {
+    for (int segmentLength = 1; segmentLength <= MAX_SEGMENT && segmentLength + 3 <= numCities; segmentLength++) {
+        int start = position[a];
+        int last = route[(start + segmentLength - 1) % numCities];
+        int before = route[prev(start)];
+        int after = route[(start + segmentLength) % numCities];
+        double removeGain = distances(before, a) + distances(last, after) - distances(before, after);
+        if (removeGain <= EPSILON) {
+            continue;
+        }
+        for (int end = 0; end < (segmentLength == 1 ? 1 : 2); end++) {
+            int near = end == 0 ? a : last;
+            int far = end == 0 ? last : a;
+            for (int c : neighbours[near]) {
+                double addedNear = distances(near, c);
+                if (addedNear >= removeGain - EPSILON) {
+                    break;
+                }
+                int posC = position[c];
+                if ((posC - start + numCities) % numCities < segmentLength) {
+                    continue;
+                }
+                // Between c and its successor, near end first
+                if (c != before) {
+                    int cNext = route[next(posC)];
+                    double delta = addedNear + distances(far, cNext) - distances(c, cNext) - removeGain;
+                    if (delta < -EPSILON) {
+                        moveSegment(route, start, segmentLength, posC, near != a);
+                        length += delta;
+                        push(a); push(last); push(before); push(after); push(c); push(cNext);
+                        return true;
+                    }
+                }
+                // Between c's predecessor and c, near end last
+                if (c != after) {
+                    int cPrev = route[prev(posC)];
+                    double delta = distances(cPrev, far) + addedNear - distances(cPrev, c) - removeGain;
+                    if (delta < -EPSILON) {
+                        moveSegment(route, start, segmentLength, prev(posC), far != a);
+                        length += delta;
+                        push(a); push(last); push(before); push(after); push(c); push(cPrev);
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef MIGRATION_TRANSPORT_DEFINITION_HPP
+#define MIGRATION_TRANSPORT_DEFINITION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The elite routes one island worker publishes for the others.
+ *
+ * Routes are ordered best first, so routes[0] is the worker's best route and has
+ * length bestFitness. A finished packet is the worker's final result.
+ */
+struct MigrantPacket {
+    int worker = 0;
+    int epoch = -1;
+    bool finished = false;
+    double bestFitness = 0.0;
+    std::vector<std::vector<int>> routes;
+};
+
+/**
+ * @brief Channel through which island workers exchange migrants.
+ *
+ * Every worker publishes into its own slot, which keeps only the latest packet;
+ * anyone can fetch the latest packet of any slot. Nothing blocks on other workers,
+ * so a crashed worker only stops sending.
+ */
+class MigrationTransport {
+    public:
+        virtual ~MigrationTransport() {};
+        virtual void publish(const MigrantPacket &packet) = 0;
+        virtual bool fetch(int worker, MigrantPacket &packet) = 0;
+};
+
+/**
+ * @brief Migration mailbox in a POSIX shared-memory object.
+ *
+ * The object holds one fixed-size slot per worker. Each slot is written by its
+ * worker only and read by the others through a sequence lock, so neither side
+ * takes a lock and a reader retries only while the slot is being rewritten.
+ *
+ *   header: "PSOM" | u32 numWorkers | u32 numCities | u32 numMigrants   (64 bytes)
+ *   slot:   u64 sequence | i32 epoch | i32 finished | i32 numRoutes | f64 bestFitness
+ *           | numMigrants x numCities i32 routes                         (64-byte aligned)
+ */
+class SharedMemoryMailbox : public MigrationTransport {
+    private:
+        std::string name;
+        bool owner = false;
+        unsigned char *base = nullptr;
+        std::size_t mappedBytes = 0;
+        std::size_t slotBytes = 0;
+        int numWorkers = 0;
+        int numCities = 0;
+        int numMigrants = 0;
+
+        void map(int fd, std::size_t bytes);
+        unsigned char *slot(int worker) const;
+
+    public:
+        SharedMemoryMailbox(const std::string &name, int numWorkers, int numCities, int numMigrants);
+        explicit SharedMemoryMailbox(const std::string &name);
+        ~SharedMemoryMailbox();
+        SharedMemoryMailbox(const SharedMemoryMailbox &) = delete;
+        SharedMemoryMailbox &operator=(const SharedMemoryMailbox &) = delete;
+
+        int getNumWorkers() const {return numWorkers;}
+        int getNumCities() const {return numCities;}
+        int getNumMigrants() const {return numMigrants;}
+
+        void publish(const MigrantPacket &packet) override;
+        bool fetch(int worker, MigrantPacket &packet) override;
+        void recover(int worker);
+};
+
+/**
+ * @brief Keeps the latest packet of every worker and serves them over a Unix socket.
+ *
+ * Stands in for a network relay: workers connect with SocketTransport and the
+ * process owning the relay can read the slots directly. Published packets must have
+ * at most numMigrants routes of numCities cities; others are dropped.
+ */
+class SocketRelay : public MigrationTransport {
+    private:
+        struct Connection {
+            int fd;
+            std::vector<unsigned char> in;
+            std::vector<unsigned char> out;
+        };
+
+        std::string path;
+        int listenFd = -1;
+        int numCities = 0;
+        int numMigrants = 0;
+        std::vector<std::optional<MigrantPacket>> latest;
+        std::mutex latestMutex;
+        std::atomic<bool> stopping{false};
+        std::thread server;
+
+        void serve();
+        bool receive(Connection &connection);
+        bool flush(Connection &connection);
+        std::size_t handleRequest(Connection &connection);
+
+    public:
+        SocketRelay(const std::string &path, int numWorkers, int numCities, int numMigrants);
+        ~SocketRelay();
+        SocketRelay(const SocketRelay &) = delete;
+        SocketRelay &operator=(const SocketRelay &) = delete;
+
+        void publish(const MigrantPacket &packet) override;
+        bool fetch(int worker, MigrantPacket &packet) override;
+};
+
+/**
+ * @brief Worker side of a SocketRelay connection.
+ */
+class SocketTransport : public MigrationTransport {
+    private:
+        int fd = -1;
+
+    public:
+        explicit SocketTransport(const std::string &path, int connectTimeoutMs = 5000);
+        ~SocketTransport();
+        SocketTransport(const SocketTransport &) = delete;
+        SocketTransport &operator=(const SocketTransport &) = delete;
+
+        void publish(const MigrantPacket &packet) override;
+        bool fetch(int worker, MigrantPacket &packet) override;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef PROFILER_DEFINITION_HPP
+#define PROFILER_DEFINITION_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief The timed phases of a PSO run.
+ *
+ * The first group is measured per particle update, the second once per iteration
+ * on the thread driving the swarm. LocalSearch is recorded in both places when the
+ * memetic mode polishes personal and global bests.
+ */
+enum class ProfilePhase : std::uint8_t {
+    RandomDraws,
+    Velocity,
+    Swaps,
+    Validation,
+    Fitness,
+    LocalSearch,
+    GlobalBest,
+    LockWait,
+    Trace,
+    Snapshot,
+    Resync,
+    TraceDrain,
+    Count
+};
+
+/**
+ * @brief Event counters kept alongside the phase timers.
+ */
+enum class ProfileCounter : std::uint8_t {
+    InvalidRoutes,
+    PersonalBestImprovements,
+    GlobalBestImprovements,
+    Count
+};
+
+const char *profilePhaseName(ProfilePhase phase);
+const char *profileCounterName(ProfileCounter counter);
+
+/**
+ * @brief Per-thread phase timers, counters and timeline events for one run.
+ *
+ * Every thread writes only to its own slot, so recording takes no locks. Slots are
+ * cache-line aligned to keep neighbouring threads off each other's lines. Timeline
+ * events are kept up to a per-slot cap and can be written as Chrome trace JSON
+ * (chrome://tracing or Perfetto); the totals survive the cap.
+ */
+class Profiler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t PHASE_COUNT = static_cast<std::size_t>(ProfilePhase::Count);
+        static constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(ProfileCounter::Count);
+
+    private:
+        struct Event {
+            std::int64_t startNanos;
+            std::int64_t durationNanos;
+            ProfilePhase phase;
+        };
+
+        struct alignas(64) Slot {
+            std::array<std::int64_t, PHASE_COUNT> nanos{};
+            std::array<std::int64_t, PHASE_COUNT> calls{};
+            std::array<std::int64_t, COUNTER_COUNT> counters{};
+            std::vector<Event> events;
+            std::int64_t droppedEvents = 0;
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        int numSlots = 0;
+        std::size_t maxEventsPerSlot = 0;
+        Clock::time_point origin;
+
+    public:
+        Profiler() {};
+        ~Profiler() {};
+
+        void reset(int numSlots, std::size_t maxEventsPerSlot = 1 << 16);
+
+        int size() const {return numSlots;}
+        std::int64_t now() const {return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();}
+
+        void record(int slot, ProfilePhase phase, std::int64_t startNanos, std::int64_t endNanos);
+        void count(int slot, ProfileCounter counter, std::int64_t amount = 1) {slots[slot].counters[static_cast<std::size_t>(counter)] += amount;}
+
+        bool empty() const;
+        std::int64_t getNanos(ProfilePhase phase) const;
+        std::int64_t getNanos(int slot, ProfilePhase phase) const {return slots[slot].nanos[static_cast<std::size_t>(phase)];}
+        std::int64_t getCalls(ProfilePhase phase) const;
+        std::int64_t getCount(ProfileCounter counter) const;
+        std::size_t getEventCount() const;
+
+        void writeChromeTrace(std::ostream &out) const;
+        void writeSummary(std::ostream &out) const;
+};
+
+/**
+ * @brief Times a sequence of consecutive phases on one thread.
+ *
+ * enter() closes the running phase and opens the next, so back-to-back phases cost
+ * one clock read each. The last phase is closed when the timer goes out of scope.
+ * A null profiler or a negative slot disables the timer.
+ */
+class ProfileTimer {
+    private:
+        Profiler *profiler;
+        int slot;
+        ProfilePhase phase;
+        std::int64_t start;
+
+    public:
+        ProfileTimer(Profiler *profiler, int slot, ProfilePhase phase)
+            : profiler(slot >= 0 && slot < (profiler ? profiler->size() : 0) ? profiler : nullptr),
+              slot(slot), phase(phase), start(this->profiler ? this->profiler->now() : 0) {}
+        ~ProfileTimer() {
+            if (profiler) {
+                profiler->record(slot, phase, start, profiler->now());
+            }
+        }
+        ProfileTimer(const ProfileTimer &) = delete;
+        ProfileTimer &operator=(const ProfileTimer &) = delete;
+
+        void enter(ProfilePhase next) {
+            if (profiler) {
+                std::int64_t t = profiler->now();
+                profiler->record(slot, phase, start, t);
+                start = t;
+            }
+            phase = next;
+        }
+        void count(ProfileCounter counter) {
+            if (profiler) {
+                profiler->count(slot, counter);
+            }
+        }
+};
+
+// Instrumentation points in the solver. With PSO_PROFILING undefined they compile to nothing.
+#ifdef PSO_PROFILING
+#define PSO_PROFILE_TIMER(name, profiler, slot, phase) ProfileTimer name(profiler, slot, phase)
+#define PSO_PROFILE_ENTER(name, phase) (name).enter(phase)
+#define PSO_PROFILE_COUNT(name, counter) (name).count(counter)
+#else
+#define PSO_PROFILE_TIMER(name, profiler, slot, phase)
+#define PSO_PROFILE_ENTER(name, phase) ((void)0)
+#define PSO_PROFILE_COUNT(name, counter) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PSO_CONFIG_DEFINITION_HPP
+#define PSO_CONFIG_DEFINITION_HPP
+
+#include <string>
+#include "ObjectiveFunction.hpp"
+
+/**
+ * @brief Which routes the memetic local search polishes.
+ *
+ * PersonalBest polishes a particle's route whenever it improves the particle's personal
+ * best, inside the particle update. GlobalBest polishes the swarm's best route once per
+ * iteration on the driving thread. Both does both.
+ */
+enum class MemeticMode {
+    Off,
+    PersonalBest,
+    GlobalBest,
+    Both
+};
+
+/**
+ * @brief Runtime parameters of a PSO solve.
+ *
+ * The defaults are the compile-time values from ObjectiveFunction.hpp, so a
+ * default-constructed config reproduces the original behaviour. The stopping rules
+ * besides maxIterations are off when zero. When set, runPSO also stops once the time
+ * budget is used up, once the global best has not improved for stallIterations
+ * iterations, or once it is within targetGap (a fraction) of targetDistance.
+ * memeticMode turns on 2-opt and Or-opt local search over each city's neighbourCount
+ * nearest cities. When fitnessResync is set, every particle's incrementally updated
+ * fitness is recomputed from scratch every fitnessResync iterations, so rounding
+ * drift cannot build up over long runs.
+ */
+struct PSOConfig {
+    int numParticles = NUM_PARTICLES;
+    int maxIterations = MAX_ITERATIONS;
+    int numCities = NUM_CITIES;
+    double inertiaWeight = INERTIA_WEIGHT;
+    double cognitiveWeight = COGNITIVE_WEIGHT;
+    double socialWeight = SOCIAL_WEIGHT;
+
+    double timeBudgetMs = 0.0;
+    int stallIterations = 0;
+    double targetDistance = 0.0;
+    double targetGap = 0.0;
+
+    MemeticMode memeticMode = MemeticMode::Off;
+    int neighbourCount = 8;
+
+    int fitnessResync = 0;
+
+    void validate() const;
+};
+
+bool parseConfigArgument(PSOConfig &config, const std::string &argument);
+
+#endif
@@ -7,34 +7,150 @@
 #include <limits>
 #include <mutex>
 #include <thread>
+#include <span>
+#include <random>
+#include <cstdint>
+#include <functional>
 #include "cityDefinition.hpp"
 #include "particleDefinition.hpp"
+#include "swarmDefinition.hpp"
 #include "ObjectiveFunction.hpp"
+#include "psoConfigDefinition.hpp"
+#include "threadPoolDefinition.hpp"
+#include "distanceMatrixDefinition.hpp"
+#include "traceLoggerDefinition.hpp"
+#include "globalBestDefinition.hpp"
+#include "profilerDefinition.hpp"
+#include "localSearchDefinition.hpp"
+#include "batchFitnessDefinition.hpp"
+#include "fixedSizeKernelDefinition.hpp"
+#include "instanceDefinition.hpp"
+#include "solutionCacheDefinition.hpp"
+
+enum class ExecutionMode {
+    ThreadPerParticle,
+    WorkStealingPool,
+    Serial
+};
+
+/**
+ * @brief Why runPSO returned.
+ */
+enum class StopReason {
+    MaxIterations,
+    TimeBudget,
+    Stalled,
+    TargetReached,
+    CacheHit
+};
+
+const char *stopReasonName(StopReason reason);
+
+/**
+ * @brief A new global best, as handed to the improvement callback.
+ */
+struct BestImprovement {
+    int iteration;
+    double elapsedMs;
+    double fitness;
+    std::span<const int> route;
+};
+
+using ImprovementCallback = std::function<void(const BestImprovement &)>;
 
 class PSO {
     private:
-        double globalBestFitness = std::numeric_limits<double>::max();
-        std::vector<int> globalBestRoute;
-        std::vector<std::vector<double>> distanceMatrix;
-        std::vector<std::shared_ptr<Particle>> particleList;
+        PSOConfig config;
+        GlobalBest globalBest;
+        std::vector<int> iterationBestRoute;
+        std::uint64_t seed = (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+        std::shared_ptr<const DistanceMatrix> distanceMatrix = std::make_shared<DistanceMatrix>();
+        DistanceMatrix::Storage distanceStorage = DistanceMatrix::Storage::Dense;
+        std::shared_ptr<const NeighbourLists> neighbourLists;
+        std::shared_ptr<const SmallTourKernel> smallKernel;
+        std::shared_ptr<const std::vector<double>> instanceDistances;
+        double knownOptimum = 0.0;
+        bool fixedSizeKernels = true;
+        std::vector<LocalSearch> localSearchers;
+        double polishedFitness = std::numeric_limits<double>::max();
+        Swarm swarm;
         std::vector<std::shared_ptr<City>> cityList;
-        std::mutex globalMutex;
-        
+        std::mutex traceMutex;
+        ExecutionMode executionMode = USE_THREAD_POOL ? ExecutionMode::WorkStealingPool : ExecutionMode::ThreadPerParticle;
+        int numThreads = static_cast<int>(std::thread::hardware_concurrency());
+        std::unique_ptr<ThreadPool> swarmExecutor;
+        bool fitnessCrossCheck = false;
+        TraceSampling traceSampling = TraceSampling::EveryKth;
+        int traceInterval = 1;
+        std::unique_ptr<TraceLogger> traceLogger;
+        TraceSink traceSink;
+        Profiler profiler;
+        ImprovementCallback improvementCallback;
+        StopReason stopReason = StopReason::MaxIterations;
+        int iterationsRun = 0;
+        std::shared_ptr<SolutionCache> solutionCache;
+        double cacheMinOverlap = 0.8;
+        std::uint64_t cacheMetric = SolutionCache::EUCLIDEAN_METRIC;
+
+        void updateParticle(int pIdx, int iteration, std::ofstream &outFile, int numCities);
+        void checkFitness(std::span<const int> route, double fitness, int numCities);
+        int threadSlot(int pIdx) const;
+        void prepareLocalSearch(int numSlots);
+        void polishGlobalBest(int slot);
+        DistanceMatrix &ownMatrix();
+        void afterCitiesChanged(std::vector<int> &bestRoute, double bestFitness);
+        bool seedFromCache(int numCities);
+
     public:
         PSO(){};
+        explicit PSO(const PSOConfig &config) : config(config) {this->config.validate();}
         ~PSO(){};
         void generateCityCoordinates(int numCities);
+        void loadInstance(const TSPInstance &instance);
         void initializeDistanceMatrix();
-        double calculateDistance(const std::vector<int> &route, int numCities);
-        void updateBestFitness(std::shared_ptr<Particle> p, int numCities);
+        double calculateDistance(std::span<const int> route, int numCities);
+        void evaluateSwarm(int numCities);
+        void updateBestFitness(int pIdx, int numCities);
         void initializeParticles(int numParticles, int numCities);
         void updateParticles(int iteration, std::ofstream &outFile, int numCities);
-        void runPSO(std::ofstream &outFile, int numCities);
+        void beginRun(std::ofstream &outFile, int numCities);
+        void endRun();
+        StopReason runPSO(std::ofstream &outFile, int numCities);
+        void shareInstance(const PSO &source);
+        std::vector<std::vector<int>> getEliteRoutes(int count) const;
+        void injectRoutes(const std::vector<std::vector<int>> &routes, int numCities);
+        int insertCity(double x, double y, double z);
+        int removeCity(int city);
         void printResults(double executionTime);
+        void writeProfileTrace(std::ostream &out) const {profiler.writeChromeTrace(out);}
+
+        void setConfig(const PSOConfig &newConfig) {newConfig.validate(); config = newConfig;}
+        const PSOConfig &getConfig() const {return config;}
+        void setExecutionMode(ExecutionMode mode) {executionMode = mode;}
+        void setNumThreads(int threads) {numThreads = threads;}
+        void setDistanceStorage(DistanceMatrix::Storage storage) {distanceStorage = storage;}
+        void setFitnessCrossCheck(bool enabled) {fitnessCrossCheck = enabled;}
+        void setFixedSizeKernels(bool enabled) {fixedSizeKernels = enabled;}
+        void setKnownOptimum(double optimum) {knownOptimum = optimum;}
+        void setTraceSampling(TraceSampling sampling, int interval = 1) {traceSampling = sampling; traceInterval = interval;}
+        void setTraceSink(TraceSink sink) {traceSink = std::move(sink);}
+        void setImprovementCallback(ImprovementCallback callback) {improvementCallback = std::move(callback);}
+        void setSolutionCache(std::shared_ptr<SolutionCache> cache, double minOverlap = 0.8) {solutionCache = std::move(cache); cacheMinOverlap = minOverlap;}
+        void setSeed(std::uint64_t newSeed) {seed = newSeed;}
+        std::uint64_t getSeed() const {return seed;}
+        ExecutionMode getExecutionMode() const {return executionMode;}
+        StopReason getStopReason() const {return stopReason;}
+        int getIterationsRun() const {return iterationsRun;}
+        double getKnownOptimum() const {return knownOptimum;}
 
         std::vector<std::shared_ptr<City>> getCityList() const {return cityList;}
-        std::vector<int> getGlobalBestRoute () const {return globalBestRoute; }
-        std::vector<std::shared_ptr<Particle>> getParticleList() const {return particleList;}
+        std::vector<int> getGlobalBestRoute () const {return globalBest.getRoute(); }
+        double getGlobalBestFitness() const {return globalBest.getFitness();}
+        double getExactBestFitness() const;
+        std::vector<std::shared_ptr<Particle>> getParticleList() const;
+        const Swarm &getSwarm() const {return swarm;}
+        const DistanceMatrix &getDistanceMatrix() const {return *distanceMatrix;}
+        const Profiler &getProfiler() const {return profiler;}
 };
 
 #endif
\ No newline at end of file
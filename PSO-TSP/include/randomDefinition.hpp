@@ -0,0 +1,53 @@
+#ifndef RANDOM_DEFINITION_HPP
+#define RANDOM_DEFINITION_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+/**
+ * @brief Independent random streams derived from one master seed.
+ *
+ * Each stream is identified by a domain, an index within the domain (usually a
+ * particle id) and an iteration. Streams are counter based, so a particle's draws in
+ * an iteration depend only on these values and never on thread scheduling.
+ */
+enum class RandomDomain : std::uint32_t {
+    Cities = 1,
+    ParticleInit = 2,
+    ParticleUpdate = 3,
+    Islands = 4,
+    Fleet = 5
+};
+
+/**
+ * @brief Philox4x32-10 counter-based generator.
+ *
+ * The master seed is the key; the counter holds (block, iteration, index, domain).
+ * Satisfies UniformRandomBitGenerator, so it also works with the standard distributions.
+ */
+class PhiloxStream {
+    private:
+        std::array<std::uint32_t, 2> key;
+        std::array<std::uint32_t, 4> counter;
+        std::array<std::uint32_t, 4> block;
+        int available = 0;
+
+        void generateBlock();
+
+    public:
+        using result_type = std::uint32_t;
+
+        PhiloxStream(std::uint64_t seed, RandomDomain domain, std::uint32_t index, std::uint32_t iteration = 0);
+
+        static constexpr result_type min() {return 0;}
+        static constexpr result_type max() {return std::numeric_limits<result_type>::max();}
+        result_type operator()();
+
+        double uniform();
+        std::uint32_t below(std::uint32_t bound);
+        void fillUniform(std::span<double> out);
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef SOLUTION_CACHE_DEFINITION_HPP
+#define SOLUTION_CACHE_DEFINITION_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "cityDefinition.hpp"
+#include "instanceDefinition.hpp"
+
+/**
+ * Solution cache file, version 2. All integers are little-endian.
+ *
+ *   header:  "PSOC" | u32 version | f64 quantum
+ *   record:  u32 payloadBytes | u64 fingerprint | u64 metric | u32 numCities | f64 fitness
+ *            | payload
+ *   payload: numCities x (zigzag varint dx, dy, dz) | numCities x varint city
+ *
+ * The coordinates are quantized to multiples of the quantum and sorted, and each is
+ * stored as its difference from the previous one. The tour lists positions in that
+ * sorted order, so it does not depend on the order the waypoints were given in.
+ * Records are only appended; a better tour for the same instance is a new record.
+ */
+constexpr char SOLUTION_CACHE_MAGIC[4] = {'P', 'S', 'O', 'C'};
+constexpr std::uint32_t SOLUTION_CACHE_VERSION = 2;
+
+/**
+ * @brief A cached tour for a query, in the query's city indices.
+ *
+ * An exact hit has the same waypoints and its route visits them all. A near hit shares
+ * the fraction overlap of the waypoints; its route visits only the shared ones, in the
+ * cached order, and the caller inserts the rest.
+ */
+struct CacheHit {
+    std::vector<int> route;
+    double fitness = 0.0;
+    double overlap = 0.0;
+    bool exact = false;
+};
+
+/**
+ * @brief Best known tours of past instances, kept on disk and keyed by waypoint fingerprint.
+ *
+ * The fingerprint hashes the distance metric and the quantized, sorted coordinates, so
+ * the same waypoints in another order, or moved by less than the quantum, find the
+ * same entry, while the same points under another metric do not. Opening the cache
+ * reads every record header into an in-memory index. A payload is decoded the first
+ * time a lookup needs it and kept in memory, so later lookups do not touch the file. A
+ * file ending in a partly written or implausible record, for example after a crash,
+ * is cut back to its last whole record. All members are thread-safe.
+ */
+class SolutionCache {
+    private:
+        using Point = std::array<std::int64_t, 3>;
+
+        struct Decoded {
+            std::vector<Point> points;
+            std::vector<int> tour;
+        };
+
+        struct Entry {
+            std::uint64_t offset;
+            std::uint64_t fingerprint;
+            std::uint64_t metric;
+            int numCities;
+            double fitness;
+            std::uint32_t payloadBytes;
+            std::shared_ptr<const Decoded> decoded;
+            bool corrupt = false;
+        };
+
+        std::string path;
+        double quantum;
+        std::vector<Entry> entries;
+        std::unordered_map<std::uint64_t, std::size_t> best;
+        mutable std::mutex mutex;
+
+        void canonicalize(const std::vector<std::shared_ptr<City>> &cityList, std::vector<Point> &points,
+                          std::vector<int> &order) const;
+        std::uint64_t fingerprint(const std::vector<Point> &points, std::uint64_t metric) const;
+        std::shared_ptr<const Decoded> decode(Entry &entry);
+
+    public:
+        static constexpr double DEFAULT_QUANTUM = 1e-6;
+        static constexpr std::uint64_t EUCLIDEAN_METRIC = 0;
+
+        explicit SolutionCache(const std::string &path, double quantum = DEFAULT_QUANTUM);
+
+        static std::uint64_t metricOf(const TSPInstance &instance);
+        std::uint64_t fingerprint(const std::vector<std::shared_ptr<City>> &cityList, std::uint64_t metric) const;
+        std::optional<CacheHit> lookup(const std::vector<std::shared_ptr<City>> &cityList, std::uint64_t metric,
+                                       double minOverlap = 0.8);
+        bool store(const std::vector<std::shared_ptr<City>> &cityList, std::uint64_t metric,
+                   const std::vector<int> &route, double fitness);
+
+        int size() const;
+        double getQuantum() const {return quantum;}
+};
+
+#endif
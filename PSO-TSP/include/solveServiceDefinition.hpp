@@ -0,0 +1,117 @@
+#ifndef SOLVE_SERVICE_DEFINITION_HPP
+#define SOLVE_SERVICE_DEFINITION_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "psoDefinition.hpp"
+
+/**
+ * @brief One independent solve submitted to a SolveService.
+ *
+ * The config's maxIterations, timeBudgetMs, stallIterations and target are the job's
+ * budget. Without an instance the job solves config.numCities random cities from its
+ * seed. Jobs with a higher priority start first; equal priorities start in the order
+ * they were submitted. With a cache, a job whose waypoints it already holds returns the
+ * cached tour without solving, and every job stores its tour there.
+ */
+struct SolveRequest {
+    std::string name;
+    PSOConfig config;
+    std::uint64_t seed = 1;
+    int priority = 0;
+    std::shared_ptr<const TSPInstance> instance;
+    DistanceMatrix::Storage distanceStorage = DistanceMatrix::Storage::Dense;
+    std::shared_ptr<SolutionCache> cache;
+};
+
+/**
+ * @brief The outcome of one job, with how long it queued and how long it ran.
+ *
+ * fitness is the exact length of the best route, and gap its distance from the
+ * instance's known optimum as a fraction, or zero if none is known.
+ */
+struct SolveResult {
+    std::string name;
+    std::uint64_t seed = 0;
+    std::vector<int> route;
+    double fitness = 0.0;
+    double gap = 0.0;
+    StopReason stopReason = StopReason::MaxIterations;
+    int iterations = 0;
+    double queuedMs = 0.0;
+    double solveMs = 0.0;
+};
+
+/**
+ * @brief Totals over every job a SolveService has finished.
+ */
+struct SolveServiceStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t completed = 0;
+    std::uint64_t failed = 0;
+    double busyMs = 0.0;
+};
+
+/**
+ * @brief Solves many independent instances concurrently from one priority queue.
+ *
+ * A fixed set of worker threads takes the highest-priority job from the queue and
+ * solves it serially, so throughput scales with the number of workers while each
+ * job keeps its own cache-resident solver. `submit` returns at once with a future
+ * for the job's result; a job that throws delivers the exception through its future.
+ * The destructor finishes every job already submitted before it returns.
+ */
+class SolveService {
+    private:
+        struct Job {
+            SolveRequest request;
+            std::uint64_t sequence;
+            std::chrono::steady_clock::time_point submittedAt;
+            std::promise<SolveResult> result;
+        };
+
+        struct JobOrder {
+            bool operator()(const std::unique_ptr<Job> &a, const std::unique_ptr<Job> &b) const {
+                return a->request.priority != b->request.priority ? a->request.priority < b->request.priority
+                                                                  : a->sequence > b->sequence;
+            }
+        };
+
+        std::priority_queue<std::unique_ptr<Job>, std::vector<std::unique_ptr<Job>>, JobOrder> queue;
+        mutable std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::condition_variable idleCondition;
+        bool stopping = false;
+        int running = 0;
+        std::uint64_t nextSequence = 0;
+        SolveServiceStats stats;
+        std::vector<std::thread> workers;
+
+        void workerLoop();
+
+    public:
+        explicit SolveService(int numWorkers);
+        ~SolveService();
+        SolveService(const SolveService &) = delete;
+        SolveService &operator=(const SolveService &) = delete;
+
+        std::future<SolveResult> submit(SolveRequest request);
+        void waitIdle();
+        int size() const {return static_cast<int>(workers.size());}
+        int queued() const;
+        SolveServiceStats getStats() const;
+};
+
+SolveResult solveRequest(const SolveRequest &request);
+bool parseSolveArgument(SolveRequest &request, const std::string &argument);
+std::string formatSolveResult(const SolveResult &result);
+
+#endif
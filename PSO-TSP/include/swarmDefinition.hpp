@@ -0,0 +1,91 @@
+#ifndef SWARM_DEFINITION_HPP
+#define SWARM_DEFINITION_HPP
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Allocator whose storage starts on a cache-line boundary.
+ */
+template <typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+    static constexpr std::size_t CACHE_LINE_BYTES = 64;
+
+    CacheAlignedAllocator() = default;
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U> &) {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{CACHE_LINE_BYTES}));
+    }
+    void deallocate(T *p, std::size_t) {
+        ::operator delete(p, std::align_val_t{CACHE_LINE_BYTES});
+    }
+
+    template <typename U>
+    bool operator==(const CacheAlignedAllocator<U> &) const {return true;}
+};
+
+template <typename T>
+using CacheAlignedVector = std::vector<T, CacheAlignedAllocator<T>>;
+
+/**
+ * @brief Structure-of-arrays storage for every particle of the swarm.
+ *
+ * Routes, velocities and personal bests of all particles live in one contiguous
+ * arena per field. Each arena starts on a cache line and each particle's slice is
+ * padded to a whole number of lines, so threads updating neighbouring particles do
+ * not share lines. The per-particle fitness values are packed and are shared.
+ */
+class Swarm {
+    private:
+        int numParticles = 0;
+        int numCities = 0;
+        std::size_t routeStride = 0;
+        std::size_t velocityStride = 0;
+        std::size_t visitedStride = 0;
+        std::size_t randomStride = 0;
+
+        CacheAlignedVector<int> routes;
+        CacheAlignedVector<int> bestRoutes;
+        CacheAlignedVector<int> candidateRoutes;
+        CacheAlignedVector<double> velocities;
+        CacheAlignedVector<unsigned char> visitedFlags;
+        CacheAlignedVector<double> randomDraws;
+        std::vector<double> fitness;
+        std::vector<double> bestFitness;
+
+    public:
+        Swarm() {};
+        ~Swarm() {};
+
+        void resize(int numParticles, int numCities);
+        void setNumCities(int numCities);
+
+        int size() const {return numParticles;}
+        int getNumCities() const {return numCities;}
+        std::size_t getRouteStride() const {return routeStride;}
+        const int *getRouteArena() const {return routes.data();}
+
+        std::span<int> getRoute(int p) {return {routes.data() + p * routeStride, static_cast<std::size_t>(numCities)};}
+        std::span<const int> getRoute(int p) const {return {routes.data() + p * routeStride, static_cast<std::size_t>(numCities)};}
+        std::span<int> getBestRoute(int p) {return {bestRoutes.data() + p * routeStride, static_cast<std::size_t>(numCities)};}
+        std::span<const int> getBestRoute(int p) const {return {bestRoutes.data() + p * routeStride, static_cast<std::size_t>(numCities)};}
+        std::span<double> getVelocity(int p) {return {velocities.data() + p * velocityStride, static_cast<std::size_t>(numCities)};}
+        std::span<const double> getVelocity(int p) const {return {velocities.data() + p * velocityStride, static_cast<std::size_t>(numCities)};}
+
+        // Per-particle scratch used by the position update.
+        std::span<int> getCandidateRoute(int p) {return {candidateRoutes.data() + p * routeStride, static_cast<std::size_t>(numCities)};}
+        std::span<unsigned char> getVisited(int p) {return {visitedFlags.data() + p * visitedStride, static_cast<std::size_t>(numCities)};}
+        std::span<double> getRandomDraws(int p) {return {randomDraws.data() + p * randomStride, 2 * static_cast<std::size_t>(numCities)};}
+
+        double &getFitness(int p) {return fitness[p];}
+        double getFitness(int p) const {return fitness[p];}
+        double &getBestFitness(int p) {return bestFitness[p];}
+        double getBestFitness(int p) const {return bestFitness[p];}
+};
+
+#endif
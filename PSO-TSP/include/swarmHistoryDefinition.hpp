@@ -0,0 +1,82 @@
+#ifndef SWARM_HISTORY_DEFINITION_HPP
+#define SWARM_HISTORY_DEFINITION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "cityDefinition.hpp"
+#include "traceLoggerDefinition.hpp"
+
+/**
+ * Binary swarm history, version 2. All integers are little-endian.
+ *
+ *   header:  "PSOH" | u32 version | u32 numCities | u32 numParticles
+ *            | numCities x (f64 x, f64 y, f64 z)
+ *   record:  varint iteration | varint particleId | varint fitness | varint tag | payload
+ *
+ * The fitness is the XOR of the f64 bits with those of the particle's previous record,
+ * or with zero for its first. tag = 2 * count + full. A full record (full = 1) stores count = numCities city ids.
+ * A delta record stores count (position gap, city) varint pairs against the previous
+ * route of the same particle, where the gap is the distance from the last changed position.
+ */
+constexpr char SWARM_HISTORY_MAGIC[4] = {'P', 'S', 'O', 'H'};
+constexpr std::uint32_t SWARM_HISTORY_VERSION = 2;
+
+class SwarmHistoryWriter {
+    private:
+        std::ofstream out;
+        int numCities;
+        std::vector<std::vector<int>> previousRoutes;
+        std::vector<std::uint64_t> previousFitness;
+        std::vector<unsigned char> buffer;
+
+        void putVarint(std::uint64_t value);
+
+    public:
+        SwarmHistoryWriter(const std::string &path, const std::vector<std::shared_ptr<City>> &cityList,
+                           int numParticles);
+        ~SwarmHistoryWriter();
+
+        void write(const TraceRecord &record);
+        void flush();
+        TraceSink sink() {return [this](const TraceRecord &record) { write(record); };}
+};
+
+class SwarmHistoryReader {
+    private:
+        struct MappingDeleter {
+            std::size_t bytes;
+            void operator()(const unsigned char *address) const;
+        };
+
+        std::unique_ptr<const unsigned char, MappingDeleter> mapped{nullptr, MappingDeleter{0}};
+        std::size_t mappedBytes = 0;
+        std::size_t offset = 0;
+        std::size_t recordsBegin = 0;
+        int numCities = 0;
+        int numParticles = 0;
+        std::vector<std::tuple<double, double, double>> coordinates;
+        std::vector<std::vector<int>> currentRoutes;
+        std::vector<std::uint64_t> currentFitness;
+
+        std::uint64_t getVarint();
+        double getDouble();
+
+    public:
+        explicit SwarmHistoryReader(const std::string &path);
+
+        int getNumCities() const {return numCities;}
+        int getNumParticles() const {return numParticles;}
+        const std::vector<std::tuple<double, double, double>> &getCoordinates() const {return coordinates;}
+
+        bool next(TraceRecord &record);
+        void rewind();
+};
+
+void convertHistoryToCsv(SwarmHistoryReader &reader, std::ostream &particleCsv);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef THREAD_POOL_DEFINITION_HPP
+#define THREAD_POOL_DEFINITION_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+    private:
+        // Completion state of one parallelFor call; lives on the caller's stack.
+        struct Batch {
+            std::mutex mutex;
+            std::condition_variable done;
+            int pendingTasks = 0;
+            std::exception_ptr firstError;
+        };
+
+        struct Task {
+            const std::function<void(int)> *body;
+            Batch *batch;
+            int begin;
+            int end;
+        };
+
+        struct WorkQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+        std::vector<std::thread> workers;
+
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        std::atomic<int> queuedTasks{0};
+        bool stopping = false;
+
+        void workerLoop(int workerIndex);
+        bool popTask(int workerIndex, Task &task);
+        void runTask(const Task &task);
+
+    public:
+        explicit ThreadPool(int numThreads);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        int size() const {return static_cast<int>(workers.size());}
+        static int currentWorker();
+        void parallelFor(int count, const std::function<void(int)> &body);
+};
+
+#endif
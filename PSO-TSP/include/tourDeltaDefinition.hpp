@@ -0,0 +1,148 @@
+#ifndef TOUR_DELTA_DEFINITION_HPP
+#define TOUR_DELTA_DEFINITION_HPP
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+/**
+ * @brief Change in tour length when the cities at positions i and j are swapped.
+ *
+ * Only the (up to four) edges touching positions i and j change, so the delta is
+ * computed in constant time. Adjacent positions and the wrap-around edge are handled
+ * by de-duplicating the affected edges.
+ *
+ * @param distances A distance view callable as distances(a, b).
+ * @param route The tour before the swap.
+ * @param i The first position.
+ * @param j The second position.
+ * @return double The new length minus the old length.
+ */
+template <typename Distances>
+double swapDelta(const Distances &distances, std::span<const int> route, int i, int j) {
+    int n = static_cast<int>(route.size());
+    if (i == j || n < 2) {
+        return 0.0;
+    }
+    // Edge k joins positions k and k + 1 (mod n).
+    int edges[4] = {(i + n - 1) % n, i, (j + n - 1) % n, j};
+    int numEdges = 0;
+    for (int e : edges) {
+        if (std::find(edges, edges + numEdges, e) == edges + numEdges) {
+            edges[numEdges++] = e;
+        }
+    }
+    auto cityAfterSwap = [&](int pos) {
+        return pos == i ? route[j] : (pos == j ? route[i] : route[pos]);
+    };
+    double delta = 0.0;
+    for (int k = 0; k < numEdges; k++) {
+        int from = edges[k];
+        int to = (from + 1) % n;
+        delta += distances(cityAfterSwap(from), cityAfterSwap(to)) - distances(route[from], route[to]);
+    }
+    return delta;
+}
+
+/**
+ * @brief Change in tour length when the segment route[i..j] is reversed (2-opt move).
+ *
+ * Assumes a symmetric distance table, so only the two boundary edges change.
+ *
+ * @param distances A distance view callable as distances(a, b).
+ * @param route The tour before the move.
+ * @param i The first position of the segment.
+ * @param j The last position of the segment (i <= j).
+ * @return double The new length minus the old length.
+ */
+template <typename Distances>
+double twoOptDelta(const Distances &distances, std::span<const int> route, int i, int j) {
+    int n = static_cast<int>(route.size());
+    if (i >= j || (i == 0 && j == n - 1)) {
+        return 0.0;
+    }
+    int before = route[(i + n - 1) % n];
+    int after = route[(j + 1) % n];
+    return distances(before, route[j]) + distances(route[i], after)
+         - distances(before, route[i]) - distances(route[j], after);
+}
+
+/**
+ * @brief Cheapest place to insert a city that is not yet on the tour.
+ *
+ * Every edge of the tour is tried; the city goes between the ends of the edge whose
+ * detour is shortest. Ties keep the earliest edge.
+ *
+ * @param distances A distance view callable as distances(a, b).
+ * @param route The tour without the city.
+ * @param city The city to insert.
+ * @return std::pair<int, double> The position the city should take (the cities from
+ *         there on move one place back) and the change in tour length.
+ */
+template <typename Distances>
+std::pair<int, double> cheapestInsertion(const Distances &distances, std::span<const int> route, int city) {
+    int n = static_cast<int>(route.size());
+    if (n == 0) {
+        return {0, 0.0};
+    }
+    int bestPosition = n;
+    double bestDelta = distances(route[n - 1], city) + distances(city, route[0]) - distances(route[n - 1], route[0]);
+    for (int k = 1; k < n; k++) {
+        double delta = distances(route[k - 1], city) + distances(city, route[k]) - distances(route[k - 1], route[k]);
+        if (delta < bestDelta) {
+            bestDelta = delta;
+            bestPosition = k;
+        }
+    }
+    return {bestPosition, bestDelta};
+}
+
+/**
+ * @brief Change in tour length when the city at position i is removed.
+ *
+ * @param distances A distance view callable as distances(a, b).
+ * @param route The tour before the removal.
+ * @param i The position of the city.
+ * @return double The new length minus the old length.
+ */
+template <typename Distances>
+double removalDelta(const Distances &distances, std::span<const int> route, int i) {
+    int n = static_cast<int>(route.size());
+    if (n < 2) {
+        return 0.0;
+    }
+    int before = route[(i + n - 1) % n];
+    int after = route[(i + 1) % n];
+    return distances(before, after) - distances(before, route[i]) - distances(route[i], after);
+}
+
+/**
+ * @brief Tour whose length is kept up to date as moves are applied.
+ *
+ * Every move adjusts the stored length by its delta instead of re-walking the tour.
+ */
+template <typename Distances>
+class IncrementalTour {
+    private:
+        const Distances &distances;
+        std::span<int> route;
+        double length;
+
+    public:
+        IncrementalTour(const Distances &distances, std::span<int> route, double length)
+            : distances(distances), route(route), length(length) {}
+
+        void swap(int i, int j) {
+            length += swapDelta(distances, route, i, j);
+            std::swap(route[i], route[j]);
+        }
+
+        void twoOpt(int i, int j) {
+            length += twoOptDelta(distances, route, i, j);
+            std::reverse(route.begin() + i, route.begin() + j + 1);
+        }
+
+        double getLength() const {return length;}
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef TRACE_LOGGER_DEFINITION_HPP
+#define TRACE_LOGGER_DEFINITION_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+enum class TraceSampling {
+    Off,
+    EveryKth,
+    BestOnly
+};
+
+/**
+ * @brief One logged particle state, as handed to a trace sink.
+ */
+struct TraceRecord {
+    int iteration;
+    int particleId;
+    double fitness;
+    std::span<const int> route;
+};
+
+using TraceSink = std::function<void(const TraceRecord &)>;
+
+TraceSink makeCsvTraceSink(std::ostream &out);
+void writeCsvTraceRow(std::ostream &out, const TraceRecord &record);
+
+/**
+ * @brief Single-producer single-consumer ring of fixed-size binary trace records.
+ */
+class TraceRing {
+    private:
+        struct RecordHeader {
+            std::int32_t iteration;
+            std::int32_t particleId;
+            double fitness;
+        };
+
+        std::size_t numCities;
+        std::size_t slotBytes;
+        std::size_t capacity;
+        std::vector<unsigned char> slots;
+        alignas(64) std::atomic<std::size_t> head{0};
+        alignas(64) std::atomic<std::size_t> tail{0};
+
+    public:
+        TraceRing(std::size_t capacity, int numCities);
+
+        bool tryPush(int iteration, int particleId, double fitness, std::span<const int> route);
+        bool peekIteration(int &iteration) const;
+        std::size_t drain(int maxIteration, const TraceSink &sink);
+};
+
+/**
+ * @brief Asynchronous particle-trace logger.
+ *
+ * Worker threads push records into their own TraceRing without locking. A background
+ * writer thread drains the rings into the sink, one completed iteration at a time, so
+ * the output stays ordered by iteration.
+ */
+class TraceLogger {
+    private:
+        TraceSink sink;
+        TraceSampling sampling;
+        int interval;
+        std::vector<std::unique_ptr<TraceRing>> rings;
+
+        std::atomic<int> completedIteration{-1};
+        std::atomic<std::uint64_t> stalledPushes{0};
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        bool stopping = false;
+        std::thread writer;
+
+        void writerLoop();
+        void drainAll();
+
+    public:
+        TraceLogger(TraceSink sink, int numProducers, int numCities, TraceSampling sampling = TraceSampling::EveryKth,
+                    int interval = 1, std::size_t ringCapacity = 1024);
+        ~TraceLogger();
+        TraceLogger(const TraceLogger &) = delete;
+        TraceLogger &operator=(const TraceLogger &) = delete;
+
+        bool wants(int iteration, bool improvedGlobalBest) const;
+        void log(int producer, int iteration, int particleId, double fitness, std::span<const int> route);
+        void endIteration(int iteration);
+
+        std::uint64_t getStalledPushes() const {return stalledPushes.load();}
+};
+
+#endif
@@ -9,5 +9,6 @@
 double euclideanDistance(std::shared_ptr<City> city1, std::shared_ptr<City> city2);
 void saveBestRouteCoordinates(const std::vector<int>& route, const std::vector<std::shared_ptr<City>>& cityList);
 void saveRouteCoordinatesXYZ(const std::vector<int>& route, const std::vector<std::shared_ptr<City>>& cityList);
+void saveDroneRoutes(const std::vector<std::vector<int>>& routes, const std::vector<std::shared_ptr<City>>& cityList);
 
 #endif // UTILS_H
\ No newline at end of file
@@ -0,0 +1,36 @@
+/**
+ * @file batchFitnessImplementation.cpp
+ * @brief Scoring many tours in one pass over the distance matrix.
+ */
+
+#include "batchFitnessDefinition.hpp"
+
+/**
+ * @brief Score many closed tours in one pass.
+ *
+ * The storage layout is resolved once for the whole batch, and each route's edges are
+ * summed in tour order, so every length matches PSO::calculateDistance exactly.
+ *
+ * @param distances The distance matrix of the instance.
+ * @param routes The first city of the first route; route r starts at routes + r * routeStride.
+ * @param routeStride The distance between consecutive routes, in ints.
+ * @param numRoutes The number of routes to score.
+ * @param numCities The number of cities in each route.
+ * @param out Receives the numRoutes tour lengths.
+ */
+void evaluateTours(const DistanceMatrix &distances, const int *routes, std::size_t routeStride, int numRoutes,
+                   int numCities, double *out) {
+    if (numRoutes <= 0 || numCities <= 0) {
+        return;
+    }
+    distances.visit([&](const auto &view) {
+        for (int r = 0; r < numRoutes; r++) {
+            const int *route = routes + r * routeStride;
+            double length = 0.0;
+            for (int k = 0; k < numCities - 1; k++) {
+                length += view(route[k], route[k + 1]);
+            }
+            out[r] = length + view(route[numCities - 1], route[0]);
+        }
+    });
+}
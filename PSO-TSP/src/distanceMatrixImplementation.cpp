@@ -0,0 +1,452 @@
+/**
+ * @file distanceMatrixImplementation.cpp
+ * @brief Implementation of the flat, cache-aligned DistanceMatrix.
+ */
+
+#include "distanceMatrixDefinition.hpp"
+#include "threadPoolDefinition.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Compute the distances from one point to a contiguous run of points.
+ *
+ * The coordinates are read from structure-of-arrays buffers so the loop can be
+ * vectorised: four lanes at a time with AVX, two with SSE2, and a scalar tail.
+ *
+ * @param x The x-coordinate of the source point.
+ * @param y The y-coordinate of the source point.
+ * @param z The z-coordinate of the source point.
+ * @param xs The x-coordinates of the target points.
+ * @param ys The y-coordinates of the target points.
+ * @param zs The z-coordinates of the target points.
+ * @param count The number of target points.
+ * @param out Receives the count distances.
+ */
+void computeRowDistances(double x, double y, double z, const double *xs, const double *ys, const double *zs,
+                         int count, double *out) {
+    int k = 0;
+#if defined(__AVX__)
+    __m256d x4 = _mm256_set1_pd(x);
+    __m256d y4 = _mm256_set1_pd(y);
+    __m256d z4 = _mm256_set1_pd(z);
+    for (; k + 4 <= count; k += 4) {
+        __m256d dx = _mm256_sub_pd(x4, _mm256_loadu_pd(xs + k));
+        __m256d dy = _mm256_sub_pd(y4, _mm256_loadu_pd(ys + k));
+        __m256d dz = _mm256_sub_pd(z4, _mm256_loadu_pd(zs + k));
+        __m256d sum = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+                                    _mm256_mul_pd(dz, dz));
+        _mm256_storeu_pd(out + k, _mm256_sqrt_pd(sum));
+    }
+#endif
+#if defined(__SSE2__)
+    __m128d x2 = _mm_set1_pd(x);
+    __m128d y2 = _mm_set1_pd(y);
+    __m128d z2 = _mm_set1_pd(z);
+    for (; k + 2 <= count; k += 2) {
+        __m128d dx = _mm_sub_pd(x2, _mm_loadu_pd(xs + k));
+        __m128d dy = _mm_sub_pd(y2, _mm_loadu_pd(ys + k));
+        __m128d dz = _mm_sub_pd(z2, _mm_loadu_pd(zs + k));
+        __m128d sum = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+        _mm_storeu_pd(out + k, _mm_sqrt_pd(sum));
+    }
+#endif
+    for (; k < count; k++) {
+        double dx = x - xs[k];
+        double dy = y - ys[k];
+        double dz = z - zs[k];
+        out[k] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+namespace {
+
+/**
+ * @brief Allocate zeroed, cache-line aligned storage of at least the given size.
+ *
+ * @param bytes The number of bytes wanted.
+ * @return void* The storage, to be released with std::free.
+ */
+void *allocateAligned(std::size_t bytes) {
+    bytes = (bytes + DistanceMatrix::CACHE_LINE_BYTES - 1) / DistanceMatrix::CACHE_LINE_BYTES *
+            DistanceMatrix::CACHE_LINE_BYTES;
+    if (bytes == 0) {
+        bytes = DistanceMatrix::CACHE_LINE_BYTES;
+    }
+    void *ptr = std::aligned_alloc(DistanceMatrix::CACHE_LINE_BYTES, bytes);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    std::memset(ptr, 0, bytes);
+    return ptr;
+}
+
+/**
+ * @brief Store a distance in a reduced-precision table entry.
+ */
+template <typename T>
+T encodeDistance(double distance, double inverseScale) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(distance);
+    } else {
+        constexpr double MAX_VALUE = static_cast<double>(std::numeric_limits<T>::max());
+        return static_cast<T>(std::min(distance * inverseScale + 0.5, MAX_VALUE));
+    }
+}
+
+}
+
+/**
+ * @brief Allocate zeroed, cache-line aligned storage for count doubles.
+ *
+ * @param count The number of doubles to allocate.
+ */
+void DistanceMatrix::allocate(std::size_t count) {
+    data.reset(static_cast<double *>(allocateAligned(count * sizeof(double))));
+    capacity = count;
+}
+
+/**
+ * @brief Fill the reduced-precision table from the coordinate rows.
+ *
+ * Fixed-point tables are scaled so the diagonal of the cities' bounding box, the
+ * longest possible distance, maps to the largest value of T. Rows are computed in
+ * blocks of TILE_SIZE, on the pool when one is supplied; each block fills the upper
+ * triangle of its rows and mirrors it, so the table is exactly symmetric.
+ *
+ * @tparam T float, std::uint32_t or std::uint16_t.
+ * @param pool An optional thread pool to compute the row blocks on.
+ */
+template <typename T>
+void DistanceMatrix::buildReduced(ThreadPool *pool) {
+    std::size_t n = static_cast<std::size_t>(numCities);
+    const double *xs = data.get();
+    const double *ys = xs + stride;
+    const double *zs = ys + stride;
+    scale = 1.0;
+    if constexpr (!std::is_floating_point_v<T>) {
+        double diagonal = 0.0;
+        if (n > 0) {
+            auto [xMin, xMax] = std::minmax_element(xs, xs + n);
+            auto [yMin, yMax] = std::minmax_element(ys, ys + n);
+            auto [zMin, zMax] = std::minmax_element(zs, zs + n);
+            diagonal = std::sqrt((*xMax - *xMin) * (*xMax - *xMin) + (*yMax - *yMin) * (*yMax - *yMin) +
+                                 (*zMax - *zMin) * (*zMax - *zMin));
+        }
+        if (diagonal > 0.0) {
+            scale = diagonal / static_cast<double>(std::numeric_limits<T>::max());
+        }
+    }
+    double inverseScale = 1.0 / scale;
+
+    std::size_t lineValues = CACHE_LINE_BYTES / sizeof(T);
+    reducedStride = (n + lineValues - 1) / lineValues * lineValues;
+    reducedBytes = n * reducedStride * sizeof(T);
+    reduced.reset(static_cast<std::byte *>(allocateAligned(reducedBytes)));
+    T *table = reinterpret_cast<T *>(reduced.get());
+
+    int numBlocks = (numCities + TILE_SIZE - 1) / TILE_SIZE;
+    auto buildBlock = [&](int block) {
+        std::vector<double> row(n);
+        int rowEnd = std::min(numCities, (block + 1) * TILE_SIZE);
+        for (int i = block * TILE_SIZE; i < rowEnd; i++) {
+            int count = numCities - i - 1;
+            computeRowDistances(xs[i], ys[i], zs[i], xs + i + 1, ys + i + 1, zs + i + 1, count, row.data());
+            for (int k = 0; k < count; k++) {
+                T value = encodeDistance<T>(row[k], inverseScale);
+                table[i * reducedStride + i + 1 + k] = value;
+                table[(i + 1 + k) * reducedStride + i] = value;
+            }
+        }
+    };
+    if (pool != nullptr && numBlocks > 1) {
+        pool->parallelFor(numBlocks, buildBlock);
+    } else {
+        for (int block = 0; block < numBlocks; block++) {
+            buildBlock(block);
+        }
+    }
+}
+
+/**
+ * @brief Fill one tile of the upper triangle (and its mirror for dense storage).
+ *
+ * @param rowTile The tile index along the rows.
+ * @param colTile The tile index along the columns (colTile >= rowTile).
+ * @param xs The x-coordinates of all cities.
+ * @param ys The y-coordinates of all cities.
+ * @param zs The z-coordinates of all cities.
+ */
+void DistanceMatrix::buildTile(int rowTile, int colTile, const std::vector<double> &xs,
+                               const std::vector<double> &ys, const std::vector<double> &zs) {
+    int rowBegin = rowTile * TILE_SIZE;
+    int rowEnd = std::min(numCities, rowBegin + TILE_SIZE);
+    int colBegin = colTile * TILE_SIZE;
+    int colEnd = std::min(numCities, colBegin + TILE_SIZE);
+    std::size_t n = static_cast<std::size_t>(numCities);
+
+    for (int i = rowBegin; i < rowEnd; i++) {
+        int jBegin = std::max(colBegin, i + 1);
+        if (jBegin >= colEnd) {
+            continue;
+        }
+        double *out;
+        if (storage == Storage::Dense) {
+            out = data.get() + i * stride + jBegin;
+        } else {
+            std::size_t a = static_cast<std::size_t>(i);
+            out = data.get() + a * n - a * (a + 1) / 2 + (jBegin - i - 1);
+        }
+        computeRowDistances(xs[i], ys[i], zs[i], xs.data() + jBegin, ys.data() + jBegin, zs.data() + jBegin,
+                            colEnd - jBegin, out);
+        if (storage == Storage::Dense) {
+            for (int j = jBegin; j < colEnd; j++) {
+                data[j * stride + i] = out[j - jBegin];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Build the distance table for a list of cities.
+ *
+ * The upper triangle is split into TILE_SIZE x TILE_SIZE tiles which are computed
+ * independently, on the given pool when one is supplied. Dense storage mirrors each
+ * tile into the lower triangle; packed storage keeps only the strict upper triangle.
+ * On-demand storage keeps only the coordinates, three padded rows of them, and skips
+ * the tiles. The reduced-precision layouts keep the coordinate rows as well, for exact
+ * rescoring, and add a dense table of float, 32-bit or 16-bit fixed-point distances.
+ *
+ * @param cityList The cities to compute distances between.
+ * @param storage The storage layout to use.
+ * @param pool An optional thread pool to build the tiles on.
+ */
+void DistanceMatrix::build(const std::vector<std::shared_ptr<City>> &cityList, Storage storage,
+                           ThreadPool *pool) {
+    this->storage = storage;
+    reduced.reset();
+    reducedStride = 0;
+    reducedBytes = 0;
+    scale = 1.0;
+    numCities = static_cast<int>(cityList.size());
+    std::size_t n = static_cast<std::size_t>(numCities);
+    std::size_t lineDoubles = CACHE_LINE_BYTES / sizeof(double);
+    stride = (n + lineDoubles - 1) / lineDoubles * lineDoubles;
+    if (storage != Storage::Dense && storage != Storage::PackedUpper) {
+        allocate(3 * stride);
+        for (std::size_t i = 0; i < n; i++) {
+            std::tie(data[i], data[stride + i], data[2 * stride + i]) = cityList[i]->getCoordinates();
+        }
+        if (storage == Storage::Float32) {
+            buildReduced<float>(pool);
+        } else if (storage == Storage::Fixed32) {
+            buildReduced<std::uint32_t>(pool);
+        } else if (storage == Storage::Fixed16) {
+            buildReduced<std::uint16_t>(pool);
+        }
+        return;
+    }
+    allocate(storage == Storage::Dense ? n * stride : n * (n - (n > 0 ? 1 : 0)) / 2);
+
+    std::vector<double> xs(n), ys(n), zs(n);
+    for (std::size_t i = 0; i < n; i++) {
+        std::tie(xs[i], ys[i], zs[i]) = cityList[i]->getCoordinates();
+    }
+
+    int numTiles = (numCities + TILE_SIZE - 1) / TILE_SIZE;
+    std::vector<std::pair<int, int>> tiles;
+    for (int rowTile = 0; rowTile < numTiles; rowTile++) {
+        for (int colTile = rowTile; colTile < numTiles; colTile++) {
+            tiles.emplace_back(rowTile, colTile);
+        }
+    }
+
+    auto buildOne = [&](int t) { buildTile(tiles[t].first, tiles[t].second, xs, ys, zs); };
+    if (pool != nullptr && tiles.size() > 1) {
+        pool->parallelFor(static_cast<int>(tiles.size()), buildOne);
+    } else {
+        for (int t = 0; t < static_cast<int>(tiles.size()); t++) {
+            buildOne(t);
+        }
+    }
+}
+
+/**
+ * @brief Build the matrix from a given table instead of from coordinates.
+ *
+ * Used for instances that define their own distances, such as TSPLIB files. Only the
+ * layouts that store the table itself are possible; packed storage keeps the upper
+ * triangle, so the table must be symmetric for it.
+ *
+ * @param table The numCities x numCities distances, row-major.
+ * @param numCities The number of cities.
+ * @param storage Storage::Dense or Storage::PackedUpper.
+ * @throws std::invalid_argument for other layouts or a table of the wrong size.
+ */
+void DistanceMatrix::build(std::span<const double> table, int numCities, Storage storage) {
+    std::size_t n = static_cast<std::size_t>(numCities);
+    if (storage != Storage::Dense && storage != Storage::PackedUpper) {
+        throw std::invalid_argument("DistanceMatrix: a given table can only be stored dense or packed");
+    }
+    if (numCities < 0 || table.size() != n * n) {
+        throw std::invalid_argument("DistanceMatrix: table size does not match numCities");
+    }
+    this->storage = storage;
+    this->numCities = numCities;
+    reduced.reset();
+    reducedStride = 0;
+    reducedBytes = 0;
+    scale = 1.0;
+    std::size_t lineDoubles = CACHE_LINE_BYTES / sizeof(double);
+    stride = (n + lineDoubles - 1) / lineDoubles * lineDoubles;
+    if (storage == Storage::Dense) {
+        allocate(n * stride);
+        for (std::size_t i = 0; i < n; i++) {
+            std::copy_n(table.data() + i * n, n, data.get() + i * stride);
+        }
+        return;
+    }
+    allocate(n * (n - (n > 0 ? 1 : 0)) / 2);
+    double *out = data.get();
+    for (std::size_t i = 0; i < n; i++) {
+        out = std::copy(table.data() + i * n + i + 1, table.data() + (i + 1) * n, out);
+    }
+}
+
+/**
+ * @brief Move the first rows of the table, or the coordinate rows, to a wider stride.
+ *
+ * @param newStride The new row length in doubles, a multiple of a cache line.
+ * @param rows The number of rows to allocate; numCities rows are copied.
+ */
+void DistanceMatrix::growStride(std::size_t newStride, std::size_t rows) {
+    std::unique_ptr<double[], AlignedDeleter> grown(static_cast<double *>(allocateAligned(rows * newStride * sizeof(double))));
+    std::size_t copiedRows = storage == Storage::Dense ? static_cast<std::size_t>(numCities) : 3;
+    for (std::size_t r = 0; r < copiedRows; r++) {
+        std::copy_n(data.get() + r * stride, numCities, grown.get() + r * newStride);
+    }
+    data = std::move(grown);
+    capacity = rows * newStride;
+    stride = newStride;
+}
+
+/**
+ * @brief Add the last city of cityList, patching the storage in place where it can.
+ *
+ * Dense storage computes the new row, mirrors it into the new column and, when the
+ * padded rows are full, regrows with an eighth of headroom so that a run of inserts
+ * copies the table only now and then. On-demand storage appends the coordinates. The
+ * packed and reduced-precision layouts are rebuilt.
+ *
+ * @param cityList The cities, with the new one at the end.
+ * @throws std::invalid_argument if cityList is not exactly one city longer than the matrix.
+ */
+void DistanceMatrix::insertCity(const std::vector<std::shared_ptr<City>> &cityList) {
+    if (cityList.size() != static_cast<std::size_t>(numCities) + 1) {
+        throw std::invalid_argument("DistanceMatrix: insertCity expects exactly one new city");
+    }
+    std::size_t n = static_cast<std::size_t>(numCities);
+    std::size_t lineDoubles = CACHE_LINE_BYTES / sizeof(double);
+    std::size_t grownStride = (n + 1 + (n + 1) / 8 + lineDoubles - 1) / lineDoubles * lineDoubles;
+    auto [x, y, z] = cityList[n]->getCoordinates();
+    if (storage == Storage::Dense) {
+        if (n + 1 > stride || (n + 1) * stride > capacity) {
+            growStride(grownStride, grownStride);
+        }
+        std::vector<double> xs(n), ys(n), zs(n);
+        for (std::size_t i = 0; i < n; i++) {
+            std::tie(xs[i], ys[i], zs[i]) = cityList[i]->getCoordinates();
+        }
+        double *row = data.get() + n * stride;
+        computeRowDistances(x, y, z, xs.data(), ys.data(), zs.data(), numCities, row);
+        row[n] = 0.0;
+        for (std::size_t i = 0; i < n; i++) {
+            data[i * stride + n] = row[i];
+        }
+        numCities++;
+        return;
+    }
+    if (storage == Storage::OnDemand) {
+        if (n + 1 > stride) {
+            growStride(grownStride, 3);
+        }
+        data[n] = x;
+        data[stride + n] = y;
+        data[2 * stride + n] = z;
+        numCities++;
+        return;
+    }
+    build(cityList, storage);
+}
+
+/**
+ * @brief Remove a city; the last city takes its index.
+ *
+ * Dense storage copies the last row and column over the removed city's, and on-demand
+ * storage moves the last coordinates, so removal costs O(n). The packed and
+ * reduced-precision layouts are rebuilt.
+ *
+ * @param city The index of the city to remove.
+ * @param cityList The cities after the removal, with the last city moved into its slot.
+ * @throws std::invalid_argument if city is out of range or cityList is not one city shorter.
+ */
+void DistanceMatrix::removeCity(int city, const std::vector<std::shared_ptr<City>> &cityList) {
+    if (city < 0 || city >= numCities || cityList.size() + 1 != static_cast<std::size_t>(numCities)) {
+        throw std::invalid_argument("DistanceMatrix: removeCity expects a valid city and the shortened city list");
+    }
+    std::size_t c = static_cast<std::size_t>(city);
+    std::size_t last = static_cast<std::size_t>(numCities - 1);
+    if (storage == Storage::Dense) {
+        if (c != last) {
+            std::copy_n(data.get() + last * stride, last, data.get() + c * stride);
+            data[c * stride + c] = 0.0;
+            for (std::size_t i = 0; i < last; i++) {
+                if (i != c) {
+                    data[i * stride + c] = data[i * stride + last];
+                }
+            }
+        }
+        numCities--;
+        return;
+    }
+    if (storage == Storage::OnDemand) {
+        for (std::size_t r = 0; r < 3; r++) {
+            data[r * stride + c] = data[r * stride + last];
+        }
+        numCities--;
+        return;
+    }
+    build(cityList, storage);
+}
+
+/**
+ * @brief Length of a closed tour with full double-precision distances.
+ *
+ * Used to rescore tours found on a reduced-precision table. The edges are summed in
+ * tour order like PSO::calculateDistance, so on exact layouts the two agree.
+ *
+ * @param route The tour.
+ * @return double The tour length.
+ */
+double DistanceMatrix::exactTourLength(std::span<const int> route) const {
+    if (route.empty()) {
+        return 0.0;
+    }
+    return visitExact([&](const auto &distances) {
+        double length = 0.0;
+        for (std::size_t i = 0; i + 1 < route.size(); i++) {
+            length += distances(route[i], route[i + 1]);
+        }
+        return length + distances(route.back(), route.front());
+    });
+}
@@ -0,0 +1,108 @@
+/**
+ * @file fixedSizeKernelImplementation.cpp
+ * @brief The SmallTourKernel instantiations for every supported city count.
+ */
+
+#include "fixedSizeKernelDefinition.hpp"
+#include "tourDeltaDefinition.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+
+template <int N>
+class FixedTourKernel : public SmallTourKernel {
+    private:
+        alignas(64) std::array<double, N * N> table;
+
+    public:
+        explicit FixedTourKernel(const DistanceMatrix &distances) {
+            distances.visit([&](const auto &view) {
+                for (int i = 0; i < N; i++) {
+                    for (int j = 0; j < N; j++) {
+                        table[i * N + j] = view(i, j);
+                    }
+                }
+            });
+        }
+
+        double operator()(int a, int b) const {return table[a * N + b];}
+
+        int numCities() const override {return N;}
+
+        /**
+         * @brief Closed tour length, summed in tour order like PSO::calculateDistance.
+         */
+        double tourLength(std::span<const int> route) const override {
+            std::span<const int, N> tour(route.data(), N);
+            double length = 0.0;
+            for (int i = 0; i < N - 1; i++) {
+                length += (*this)(tour[i], tour[i + 1]);
+            }
+            return length + (*this)(tour[N - 1], tour[0]);
+        }
+
+        /**
+         * @brief The velocity update of PSO::updateParticle for N cities.
+         */
+        void steer(std::span<double> velocity, std::span<const double> draws, std::span<const int> bestRoute,
+                   std::span<const int> route, std::span<const int> globalBestRoute,
+                   const PSOConfig &config) const override {
+            std::span<double, N> v(velocity.data(), N);
+            std::span<const double, 2 * N> r(draws.data(), 2 * N);
+            std::span<const int, N> best(bestRoute.data(), N);
+            std::span<const int, N> current(route.data(), N);
+            std::span<const int, N> global(globalBestRoute.data(), N);
+            for (int i = 0; i < N; i++) {
+                v[i] = config.inertiaWeight * v[i] +
+                       config.cognitiveWeight * r[2 * i] * (best[i] - current[i]) +
+                       config.socialWeight * r[2 * i + 1] * (global[i] - current[i]);
+            }
+        }
+
+        /**
+         * @brief The velocity-driven swaps of PSO::updateParticle, on a stack copy of the tour.
+         *
+         * @return double The candidate's length, updated from the swap deltas.
+         */
+        double applySwaps(std::span<const double> velocity, std::span<const int> route, std::span<int> candidate,
+                          double length) const override {
+            std::array<int, N> tour;
+            std::copy_n(route.data(), N, tour.begin());
+            for (int i = 0; i < N; i++) {
+                int swapIndex = static_cast<int>(std::abs(velocity[i])) % N;
+                length += swapDelta(*this, std::span<const int>(tour), i, swapIndex);
+                std::swap(tour[i], tour[swapIndex]);
+            }
+            std::copy(tour.begin(), tour.end(), candidate.begin());
+            return length;
+        }
+};
+
+template <int... Offsets>
+std::unique_ptr<SmallTourKernel> makeKernel(const DistanceMatrix &distances,
+                                            std::integer_sequence<int, Offsets...>) {
+    std::unique_ptr<SmallTourKernel> kernel;
+    int numCities = distances.size();
+    ((numCities == SmallTourKernel::MIN_CITIES + Offsets
+          ? (kernel = std::make_unique<FixedTourKernel<SmallTourKernel::MIN_CITIES + Offsets>>(distances), true)
+          : false) || ...);
+    return kernel;
+}
+
+}
+
+/**
+ * @brief The kernel for the matrix's city count, holding a copy of its distances.
+ *
+ * @param distances The instance's distance matrix.
+ * @return std::unique_ptr<SmallTourKernel> The kernel, or nullptr if the city count is
+ *         outside [MIN_CITIES, MAX_CITIES].
+ */
+std::unique_ptr<SmallTourKernel> makeSmallTourKernel(const DistanceMatrix &distances) {
+    return makeKernel(distances, std::make_integer_sequence<int, SmallTourKernel::MAX_CITIES -
+                                                                 SmallTourKernel::MIN_CITIES + 1>{});
+}
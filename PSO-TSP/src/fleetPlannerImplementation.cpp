@@ -0,0 +1,466 @@
+/**
+ * @file fleetPlannerImplementation.cpp
+ * @brief Multi-drone planning: waypoint partitioning, parallel per-drone solves and rebalancing.
+ */
+
+#include "fleetPlannerDefinition.hpp"
+#include "randomDefinition.hpp"
+#include "tourDeltaDefinition.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+using Point = std::array<double, 3>;
+
+double squaredDistance(const Point &a, const Point &b) {
+    double dx = a[0] - b[0];
+    double dy = a[1] - b[1];
+    double dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief The seed of one drone's solve in a given round; round 0 is the first solve.
+ */
+std::uint64_t droneSeed(std::uint64_t seed, int drone, int round) {
+    PhiloxStream stream(seed, RandomDomain::Fleet, static_cast<std::uint32_t>(drone + 1),
+                        static_cast<std::uint32_t>(round));
+    return (static_cast<std::uint64_t>(stream()) << 32) | stream();
+}
+
+}
+
+/**
+ * @brief Check that the fleet shape is usable.
+ *
+ * @throws std::invalid_argument if a count is out of range.
+ */
+void FleetConfig::validate() const {
+    if (numDrones < 1) {
+        throw std::invalid_argument("FleetConfig: numDrones must be at least 1");
+    }
+    if (rebalanceRounds < 0 || rebalanceIterations < 0) {
+        throw std::invalid_argument("FleetConfig: rebalancing counts must not be negative");
+    }
+}
+
+/**
+ * @brief Apply one `--name=value` command-line argument to a fleet config.
+ *
+ * Recognised names are drones, partition (clusters or balanced), rebalance-rounds and
+ * rebalance-iterations.
+ *
+ * @param config The config to update.
+ * @param argument The argument as given on the command line.
+ * @return true if the argument named a fleet parameter.
+ * @throws std::invalid_argument if the value cannot be parsed.
+ */
+bool parseFleetArgument(FleetConfig &config, const std::string &argument) {
+    if (argument.rfind("--drones=", 0) == 0) {
+        config.numDrones = std::stoi(argument.substr(9));
+    } else if (argument == "--partition=clusters") {
+        config.partition = PartitionMethod::Clusters;
+    } else if (argument == "--partition=balanced") {
+        config.partition = PartitionMethod::Balanced;
+    } else if (argument.rfind("--rebalance-rounds=", 0) == 0) {
+        config.rebalanceRounds = std::stoi(argument.substr(19));
+    } else if (argument.rfind("--rebalance-iterations=", 0) == 0) {
+        config.rebalanceIterations = std::stoi(argument.substr(23));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Create the planner; nothing is solved until initialize().
+ *
+ * @param config The solver parameters every drone's PSO uses; numCities is the
+ *        mission's waypoint count when no cities are set.
+ * @param fleetConfig The number of drones and the balancing scheme.
+ * @param seed The master seed; the waypoints, the partition and every drone's seed derive from it.
+ */
+FleetPlanner::FleetPlanner(const PSOConfig &config, const FleetConfig &fleetConfig, std::uint64_t seed)
+    : config(config), fleetConfig(fleetConfig), seed(seed) {
+    config.validate();
+    fleetConfig.validate();
+}
+
+/**
+ * @brief Plan over the given waypoints instead of random ones generated from the seed.
+ */
+void FleetPlanner::setCities(const std::vector<std::shared_ptr<City>> &cities) {
+    cityList = cities;
+    config.numCities = static_cast<int>(cities.size());
+}
+
+/**
+ * @brief Split the waypoints among the drones.
+ *
+ * The centroids come from k-means++ seeding on the fleet stream of the master seed
+ * and at most 100 Lloyd iterations. Drones left with fewer than MIN_WAYPOINTS
+ * waypoints then take the nearest ones from drones that can spare them.
+ */
+void FleetPlanner::partition() {
+    int n = static_cast<int>(cityList.size());
+    int k = fleetConfig.numDrones;
+    std::vector<Point> points(n);
+    for (int i = 0; i < n; i++) {
+        auto [x, y, z] = cityList[i]->getCoordinates();
+        points[i] = {x, y, z};
+    }
+
+    PhiloxStream stream(seed, RandomDomain::Fleet, 0);
+    std::vector<Point> centroids = {points[stream.below(static_cast<std::uint32_t>(n))]};
+    std::vector<double> nearest(n, std::numeric_limits<double>::max());
+    while (static_cast<int>(centroids.size()) < k) {
+        double total = 0.0;
+        for (int i = 0; i < n; i++) {
+            nearest[i] = std::min(nearest[i], squaredDistance(points[i], centroids.back()));
+            total += nearest[i];
+        }
+        double target = stream.uniform() * total;
+        int chosen = n - 1;
+        for (int i = 0; i < n; i++) {
+            target -= nearest[i];
+            if (target < 0.0) {
+                chosen = i;
+                break;
+            }
+        }
+        centroids.push_back(points[chosen]);
+    }
+
+    auto closest = [&](int i) {
+        int best = 0;
+        for (int c = 1; c < k; c++) {
+            if (squaredDistance(points[i], centroids[c]) < squaredDistance(points[i], centroids[best])) {
+                best = c;
+            }
+        }
+        return best;
+    };
+    assignment.assign(n, -1);
+    for (int iter = 0; iter < 100; iter++) {
+        bool changed = false;
+        for (int i = 0; i < n; i++) {
+            int c = closest(i);
+            changed |= c != assignment[i];
+            assignment[i] = c;
+        }
+        if (!changed) {
+            break;
+        }
+        std::vector<Point> sums(k, Point{0.0, 0.0, 0.0});
+        std::vector<int> counts(k, 0);
+        for (int i = 0; i < n; i++) {
+            for (int axis = 0; axis < 3; axis++) {
+                sums[assignment[i]][axis] += points[i][axis];
+            }
+            counts[assignment[i]]++;
+        }
+        for (int c = 0; c < k; c++) {
+            if (counts[c] > 0) {
+                centroids[c] = {sums[c][0] / counts[c], sums[c][1] / counts[c], sums[c][2] / counts[c]};
+            }
+        }
+    }
+
+    std::vector<int> counts(k, 0);
+    if (fleetConfig.partition == PartitionMethod::Balanced) {
+        // Place the waypoints that lose most by missing their nearest drone first.
+        std::vector<std::vector<int>> preference(n, std::vector<int>(k));
+        std::vector<double> regret(n);
+        for (int i = 0; i < n; i++) {
+            std::iota(preference[i].begin(), preference[i].end(), 0);
+            std::sort(preference[i].begin(), preference[i].end(), [&](int a, int b) {
+                return squaredDistance(points[i], centroids[a]) < squaredDistance(points[i], centroids[b]);
+            });
+            regret[i] = k == 1 ? 0.0 : std::sqrt(squaredDistance(points[i], centroids[preference[i][1]])) -
+                                       std::sqrt(squaredDistance(points[i], centroids[preference[i][0]]));
+        }
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return regret[a] > regret[b]; });
+        int capacity = (n + k - 1) / k;
+        for (int i : order) {
+            for (int c : preference[i]) {
+                if (counts[c] < capacity) {
+                    assignment[i] = c;
+                    counts[c]++;
+                    break;
+                }
+            }
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            counts[assignment[i]]++;
+        }
+    }
+
+    for (int c = 0; c < k; c++) {
+        while (counts[c] < MIN_WAYPOINTS) {
+            int donor = -1;
+            for (int i = 0; i < n; i++) {
+                if (assignment[i] != c && counts[assignment[i]] > MIN_WAYPOINTS &&
+                    (donor < 0 || squaredDistance(points[i], centroids[c]) < squaredDistance(points[donor], centroids[c]))) {
+                    donor = i;
+                }
+            }
+            counts[assignment[donor]]--;
+            assignment[donor] = c;
+            counts[c]++;
+        }
+    }
+}
+
+/**
+ * @brief Partition the waypoints, give every drone its own PSO and solve all drones in parallel.
+ *
+ * Without cities from setCities, the waypoints are generated from the master seed, as
+ * in a single PSO run with that seed. Drone d draws its particles from its own seed
+ * taken from the fleet stream, and every rebalancing round gives it a new one.
+ *
+ * @throws std::invalid_argument if there are fewer than MIN_WAYPOINTS waypoints per drone.
+ */
+void FleetPlanner::initialize() {
+    if (cityList.empty()) {
+        PSO generator;
+        generator.setSeed(seed);
+        generator.generateCityCoordinates(config.numCities);
+        cityList = generator.getCityList();
+    }
+    int k = fleetConfig.numDrones;
+    if (static_cast<int>(cityList.size()) < k * MIN_WAYPOINTS) {
+        throw std::invalid_argument("FleetPlanner: every drone needs at least " + std::to_string(MIN_WAYPOINTS) +
+                                    " waypoints");
+    }
+    partition();
+
+    members.assign(k, {});
+    for (int i = 0; i < static_cast<int>(cityList.size()); i++) {
+        members[assignment[i]].push_back(i);
+    }
+    drones.clear();
+    for (int d = 0; d < k; d++) {
+        TSPInstance waypoints;
+        for (int local = 0; local < static_cast<int>(members[d].size()); local++) {
+            auto [x, y, z] = cityList[members[d][local]]->getCoordinates();
+            waypoints.cityList.push_back(std::make_shared<City>(local));
+            waypoints.cityList.back()->setCoordinates(x, y, z);
+        }
+        PSOConfig droneConfig = config;
+        droneConfig.numCities = waypoints.size();
+        auto drone = std::make_unique<PSO>(droneConfig);
+        drone->setSeed(droneSeed(seed, d, 0));
+        drone->setExecutionMode(ExecutionMode::Serial);
+        drone->setTraceSampling(TraceSampling::Off);
+        drone->loadInstance(waypoints);
+        drone->initializeDistanceMatrix();
+        drone->initializeParticles(droneConfig.numParticles, droneConfig.numCities);
+        drones.push_back(std::move(drone));
+    }
+    std::vector<int> all(k);
+    std::iota(all.begin(), all.end(), 0);
+    solve(all, config.maxIterations);
+    roundsRun = 0;
+}
+
+/**
+ * @brief Continue the search of the given drones for a number of iterations, one drone per thread.
+ */
+void FleetPlanner::solve(const std::vector<int> &changed, int iterations) {
+    std::ofstream discard;
+    // The thread calling parallelFor solves drones too, so the pool gets one worker fewer.
+    ThreadPool pool(static_cast<int>(changed.size()) - 1);
+    pool.parallelFor(static_cast<int>(changed.size()), [&](int i) {
+        PSO &drone = *drones[changed[i]];
+        PSOConfig droneConfig = drone.getConfig();
+        droneConfig.maxIterations = iterations;
+        drone.setConfig(droneConfig);
+        drone.runPSO(discard, droneConfig.numCities);
+    });
+}
+
+/**
+ * @brief Move the one waypoint off the longest tour that lowers the pair's longer tour the most.
+ *
+ * Every waypoint of the longest tour is tried against the cheapest insertion point of
+ * every other tour. The move is applied to the routes and to both drones' solvers.
+ *
+ * @param routes The current tours; updated by the move.
+ * @param changed Collects the drones whose waypoints changed.
+ * @return true if a move shortened the longest tour.
+ */
+bool FleetPlanner::moveWaypoint(std::vector<DroneRoute> &routes, std::vector<int> &changed) {
+    int longest = 0;
+    for (int d = 1; d < size(); d++) {
+        if (routes[d].length > routes[longest].length) {
+            longest = d;
+        }
+    }
+    std::vector<int> &from = routes[longest].route;
+    if (static_cast<int>(from.size()) <= MIN_WAYPOINTS) {
+        return false;
+    }
+    auto distances = [&](int a, int b) {
+        auto [ax, ay, az] = cityList[a]->getCoordinates();
+        auto [bx, by, bz] = cityList[b]->getCoordinates();
+        return std::sqrt((ax - bx) * (ax - bx) + (ay - by) * (ay - by) + (az - bz) * (az - bz));
+    };
+
+    double bestWorst = routes[longest].length * (1.0 - 1e-9);
+    int bestPosition = -1, bestDrone = -1, bestInsert = 0;
+    double bestRemoval = 0.0, bestInsertion = 0.0;
+    for (int i = 0; i < static_cast<int>(from.size()); i++) {
+        double removal = removalDelta(distances, std::span<const int>(from), i);
+        for (int d = 0; d < size(); d++) {
+            if (d == longest) {
+                continue;
+            }
+            auto [position, insertion] = cheapestInsertion(distances, std::span<const int>(routes[d].route), from[i]);
+            double worst = std::max(routes[longest].length + removal, routes[d].length + insertion);
+            if (worst < bestWorst) {
+                bestWorst = worst;
+                bestPosition = i;
+                bestDrone = d;
+                bestInsert = position;
+                bestRemoval = removal;
+                bestInsertion = insertion;
+            }
+        }
+    }
+    if (bestPosition < 0) {
+        return false;
+    }
+
+    int city = from[bestPosition];
+    from.erase(from.begin() + bestPosition);
+    routes[longest].length += bestRemoval;
+    routes[bestDrone].route.insert(routes[bestDrone].route.begin() + bestInsert, city);
+    routes[bestDrone].length += bestInsertion;
+    assignment[city] = bestDrone;
+
+    // Patch both solvers; removeCity gives the freed local index to the drone's last waypoint.
+    std::vector<int> &fromMembers = members[longest];
+    int local = static_cast<int>(std::find(fromMembers.begin(), fromMembers.end(), city) - fromMembers.begin());
+    drones[longest]->removeCity(local);
+    fromMembers[local] = fromMembers.back();
+    fromMembers.pop_back();
+    auto [x, y, z] = cityList[city]->getCoordinates();
+    drones[bestDrone]->insertCity(x, y, z);
+    members[bestDrone].push_back(city);
+    changed.push_back(longest);
+    changed.push_back(bestDrone);
+    return true;
+}
+
+/**
+ * @brief One rebalancing round: move waypoints off the longest tour while that helps, then re-solve.
+ *
+ * Each move is priced with the tours as they stand and strictly shortens the longer of
+ * the two tours it touches, so the round ends. The drones that changed then continue
+ * their search for rebalanceIterations iterations from their repaired swarms, on a
+ * seed of their own for the round so they do not replay the random draws of the
+ * first solve.
+ *
+ * @return int The number of waypoints moved.
+ */
+int FleetPlanner::rebalance() {
+    std::vector<DroneRoute> routes = getRoutes();
+    std::vector<int> changed;
+    int moves = 0;
+    while (moves < static_cast<int>(cityList.size()) && moveWaypoint(routes, changed)) {
+        moves++;
+    }
+    if (moves > 0) {
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        for (int d : changed) {
+            drones[d]->setSeed(droneSeed(seed, d, roundsRun + 1));
+        }
+        solve(changed, fleetConfig.rebalanceIterations);
+    }
+    roundsRun++;
+    return moves;
+}
+
+/**
+ * @brief Initialize, then rebalance until a round moves nothing or the rounds run out.
+ */
+void FleetPlanner::run() {
+    initialize();
+    for (int round = 0; round < fleetConfig.rebalanceRounds; round++) {
+        if (rebalance() == 0) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Every drone's best tour, mapped back to the mission's waypoint indices.
+ */
+std::vector<DroneRoute> FleetPlanner::getRoutes() const {
+    std::vector<DroneRoute> routes(size());
+    for (int d = 0; d < size(); d++) {
+        for (int local : drones[d]->getGlobalBestRoute()) {
+            routes[d].route.push_back(members[d][local]);
+        }
+        routes[d].length = drones[d]->getExactBestFitness();
+    }
+    return routes;
+}
+
+/**
+ * @brief Length of the longest tour, the time the mission takes at equal speeds.
+ */
+double FleetPlanner::getMakespan() const {
+    double makespan = 0.0;
+    for (const auto &drone : drones) {
+        makespan = std::max(makespan, drone->getExactBestFitness());
+    }
+    return makespan;
+}
+
+/**
+ * @brief Sum of all tour lengths, the fleet's total flight distance.
+ */
+double FleetPlanner::getTotalLength() const {
+    double total = 0.0;
+    for (const auto &drone : drones) {
+        total += drone->getExactBestFitness();
+    }
+    return total;
+}
+
+/**
+ * @brief Print every drone's tour, the makespan and the total length.
+ *
+ * @param executionTime The total execution time in milliseconds.
+ */
+void FleetPlanner::printResults(double executionTime) const {
+    std::vector<DroneRoute> routes = getRoutes();
+    for (int d = 0; d < size(); d++) {
+        std::cout << "Drone " << d << " Path: ";
+        for (int city : routes[d].route) {
+            std::cout << city << " ";
+        }
+        std::cout << std::endl;
+        std::cout << "Drone " << d << " Distance: " << routes[d].length << " (" << routes[d].route.size()
+                  << " waypoints)" << std::endl;
+    }
+    std::cout << "Makespan: " << getMakespan() << std::endl;
+    std::cout << "Total Distance: " << getTotalLength() << std::endl;
+    std::cout << "Seed: " << seed << std::endl;
+    std::cout << "Rebalancing Rounds: " << roundsRun << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Execution Time: " << executionTime << " milliseconds" << std::endl;
+}
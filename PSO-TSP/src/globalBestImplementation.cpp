@@ -0,0 +1,89 @@
+/**
+ * @file globalBestImplementation.cpp
+ * @brief Implementation of the lock-free GlobalBest publication channel.
+ */
+
+#include "globalBestDefinition.hpp"
+#include <thread>
+
+/**
+ * @brief Clear the global best and size both route buffers. Not thread-safe.
+ *
+ * @param numCities The number of cities in every route.
+ */
+void GlobalBest::reset(int numCities) {
+    for (int b = 0; b < 2; b++) {
+        routeBuffers[b].assign(numCities, 0);
+        fitnessBuffers[b].store(std::numeric_limits<double>::max(), std::memory_order_relaxed);
+    }
+    published.store(0, std::memory_order_relaxed);
+    bestFitness.store(std::numeric_limits<double>::max(), std::memory_order_release);
+}
+
+/**
+ * @brief Publish a route if it improves on the current global best.
+ *
+ * @param fitness The fitness of the candidate route.
+ * @param route The candidate route.
+ * @return true if the candidate became the new global best.
+ */
+bool GlobalBest::offer(double fitness, std::span<const int> route) {
+    if (fitness >= bestFitness.load(std::memory_order_acquire)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (fitness >= bestFitness.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    std::uint64_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    int target = 1 - published.load(std::memory_order_relaxed);
+    std::vector<int> &buffer = routeBuffers[target];
+    for (std::size_t i = 0; i < route.size(); i++) {
+        std::atomic_ref<int>(buffer[i]).store(route[i], std::memory_order_relaxed);
+    }
+    fitnessBuffers[target].store(fitness, std::memory_order_relaxed);
+    published.store(target, std::memory_order_release);
+    bestFitness.store(fitness, std::memory_order_release);
+
+    sequence.store(seq + 2, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Copy a consistent snapshot of the global best route without locking.
+ *
+ * The copy is retried only if a writer reused the buffer being copied.
+ *
+ * @param route Receives the route; must hold numCities entries.
+ * @return double The fitness of the copied route.
+ */
+double GlobalBest::snapshot(std::span<int> route) const {
+    while (true) {
+        std::uint64_t before = sequence.load(std::memory_order_acquire);
+        int source = published.load(std::memory_order_acquire);
+        std::vector<int> &buffer = routeBuffers[source];
+        for (std::size_t i = 0; i < route.size(); i++) {
+            route[i] = std::atomic_ref<int>(buffer[i]).load(std::memory_order_relaxed);
+        }
+        double fitness = fitnessBuffers[source].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            return fitness;
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Copy the global best route into a new vector.
+ *
+ * @return std::vector<int> The global best route.
+ */
+std::vector<int> GlobalBest::getRoute() const {
+    std::vector<int> route(routeBuffers[0].size());
+    snapshot(route);
+    return route;
+}
@@ -0,0 +1,38 @@
+#include "swarmHistoryDefinition.hpp"
+#include <fstream>
+#include <iostream>
+
+/**
+ * @brief Convert a binary swarm history into the CSV files read by the visualizer.
+ * 
+ * Usage: pso_history2csv <history.bin> <particle_data.csv> [city_coordinates.csv]
+ * 
+ * @return int Returns 0 on success and 1 on a usage or I/O error.
+ */
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <history.bin> <particle_data.csv> [city_coordinates.csv]" << std::endl;
+        return 1;
+    }
+    try {
+        SwarmHistoryReader reader(argv[1]);
+
+        std::ofstream particleFile(argv[2]);
+        convertHistoryToCsv(reader, particleFile);
+
+        if (argc > 3) {
+            std::ofstream coordFile(argv[3]);
+            coordFile << "City,X,Y,Z\n";
+            const auto &coordinates = reader.getCoordinates();
+            for (int i = 0; i < reader.getNumCities(); i++) {
+                coordFile << i << "," << std::get<0>(coordinates[i]) << ","
+                          << std::get<1>(coordinates[i]) << ","
+                          << std::get<2>(coordinates[i]) << "\n";
+            }
+        }
+    } catch (const std::exception &error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,452 @@
+/**
+ * @file instanceImplementation.cpp
+ * @brief Memory-mapped TSPLIB and CSV instance loaders.
+ */
+
+#include "instanceDefinition.hpp"
+#include "distanceMatrixDefinition.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief A whole file mapped read-only for the lifetime of the object.
+ */
+class MappedFile {
+    private:
+        void *address = nullptr;
+        std::size_t bytes = 0;
+
+    public:
+        explicit MappedFile(const std::string &path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Cannot open instance file " + path);
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot stat instance file " + path);
+            }
+            bytes = static_cast<std::size_t>(info.st_size);
+            if (bytes > 0) {
+                address = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            ::close(fd);
+            if (address == MAP_FAILED) {
+                address = nullptr;
+                throw std::runtime_error("Cannot map instance file " + path);
+            }
+            if (address != nullptr) {
+                ::madvise(address, bytes, MADV_SEQUENTIAL);
+            }
+        }
+        ~MappedFile() {
+            if (address != nullptr) {
+                ::munmap(address, bytes);
+            }
+        }
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        std::string_view text() const {return {static_cast<const char *>(address), bytes};}
+};
+
+/**
+ * @brief Reads lines and numbers straight out of the mapped text.
+ */
+class Scanner {
+    private:
+        const char *pos;
+        const char *end;
+        std::string path;
+
+        static bool isSpace(char c) {return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';}
+
+    public:
+        Scanner(std::string_view text, std::string path)
+            : pos(text.data()), end(text.data() + text.size()), path(std::move(path)) {}
+
+        bool atEnd() {
+            while (pos < end && isSpace(*pos)) {
+                pos++;
+            }
+            return pos == end;
+        }
+
+        [[noreturn]] void fail(const std::string &message) const {
+            throw std::runtime_error(path + ": " + message);
+        }
+
+        std::string_view line() {
+            const char *begin = pos;
+            while (pos < end && *pos != '\n') {
+                pos++;
+            }
+            std::string_view result(begin, pos - begin);
+            if (pos < end) {
+                pos++;
+            }
+            return result;
+        }
+
+        // Skips blanks on the current line and then one separator, if it is there.
+        void skip(char separator) {
+            while (pos < end && (*pos == ' ' || *pos == '\t')) {
+                pos++;
+            }
+            if (pos < end && *pos == separator) {
+                pos++;
+            }
+        }
+
+        template <typename T>
+        T number() {
+            while (pos < end && isSpace(*pos)) {
+                pos++;
+            }
+            if (pos < end && *pos == '+') {
+                pos++;
+            }
+            T value{};
+            auto [next, error] = std::from_chars(pos, end, value);
+            if (error != std::errc()) {
+                fail("expected a number near \"" + std::string(pos, std::min<std::size_t>(16, end - pos)) + "\"");
+            }
+            pos = next;
+            return value;
+        }
+};
+
+std::string_view trim(std::string_view text) {
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+/**
+ * @brief Read a section of "id x y [z]" lines, storing each point at index id - 1.
+ */
+void readCoordinates(Scanner &scanner, std::vector<std::shared_ptr<City>> &cityList, bool threeD) {
+    int numCities = static_cast<int>(cityList.size());
+    for (int k = 0; k < numCities; k++) {
+        int id = scanner.number<int>();
+        if (id < 1 || id > numCities) {
+            scanner.fail("node id " + std::to_string(id) + " is out of range");
+        }
+        double x = scanner.number<double>();
+        double y = scanner.number<double>();
+        double z = threeD ? scanner.number<double>() : 0.0;
+        cityList[id - 1]->setCoordinates(x, y, z);
+    }
+}
+
+/**
+ * @brief Read an EDGE_WEIGHT_SECTION in any symmetric TSPLIB layout into a full table.
+ */
+void readEdgeWeights(Scanner &scanner, const std::string &format, int numCities, std::vector<double> &table) {
+    std::size_t n = static_cast<std::size_t>(numCities);
+    auto store = [&](std::size_t i, std::size_t j) {
+        double weight = scanner.number<double>();
+        table[i * n + j] = weight;
+        table[j * n + i] = weight;
+    };
+    // A column-wise layout of a symmetric table is the row-wise layout of the other triangle.
+    if (format == "FULL_MATRIX") {
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = 0; j < n; j++) {
+                table[i * n + j] = scanner.number<double>();
+            }
+        }
+    } else if (format == "UPPER_ROW" || format == "LOWER_COL") {
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = i + 1; j < n; j++) {
+                store(i, j);
+            }
+        }
+    } else if (format == "LOWER_ROW" || format == "UPPER_COL") {
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = 0; j < i; j++) {
+                store(i, j);
+            }
+        }
+    } else if (format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_COL") {
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = i; j < n; j++) {
+                store(i, j);
+            }
+        }
+    } else if (format == "LOWER_DIAG_ROW" || format == "UPPER_DIAG_COL") {
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = 0; j <= i; j++) {
+                store(i, j);
+            }
+        }
+    } else {
+        scanner.fail("unsupported EDGE_WEIGHT_FORMAT " + format);
+    }
+}
+
+/**
+ * @brief The TSPLIB EUC_2D/EUC_3D table: Euclidean distances rounded to the nearest integer.
+ */
+std::vector<double> roundedEuclideanTable(const std::vector<std::shared_ptr<City>> &cityList) {
+    std::size_t n = cityList.size();
+    std::vector<double> xs(n), ys(n), zs(n);
+    for (std::size_t i = 0; i < n; i++) {
+        std::tie(xs[i], ys[i], zs[i]) = cityList[i]->getCoordinates();
+    }
+    std::vector<double> table(n * n);
+    for (std::size_t i = 0; i < n; i++) {
+        double *row = table.data() + i * n;
+        computeRowDistances(xs[i], ys[i], zs[i], xs.data(), ys.data(), zs.data(), static_cast<int>(n), row);
+        for (std::size_t j = 0; j < n; j++) {
+            row[j] = std::floor(row[j] + 0.5);
+        }
+    }
+    return table;
+}
+
+}
+
+/**
+ * @brief Length of a closed tour on this instance's own distances.
+ *
+ * @param route The tour, as 0-based city indices.
+ * @return double The tour length.
+ */
+double TSPInstance::tourLength(const std::vector<int> &route) const {
+    double length = 0.0;
+    std::size_t n = cityList.size();
+    for (std::size_t k = 0; k < route.size(); k++) {
+        int from = route[k];
+        int to = route[(k + 1) % route.size()];
+        length += distances ? (*distances)[from * n + to] : euclideanDistance(cityList[from], cityList[to]);
+    }
+    return length;
+}
+
+/**
+ * @brief Load a symmetric TSPLIB instance.
+ *
+ * EUC_2D, EUC_3D and EXPLICIT edge weights are supported, the last in every symmetric
+ * EDGE_WEIGHT_FORMAT. EXPLICIT instances take their city coordinates from the
+ * DISPLAY_DATA_SECTION when there is one, and are placed at the origin otherwise.
+ * If a tour file with the same stem and the extension .opt.tour exists and visits every
+ * city once, its length becomes the instance's known optimum. A tour file that does not
+ * fit the instance is ignored with a warning.
+ *
+ * @param path The .tsp file.
+ * @return TSPInstance The cities and their distance table.
+ * @throws std::runtime_error if the file cannot be read or is not a supported instance.
+ */
+TSPInstance loadTsplibInstance(const std::string &path) {
+    MappedFile file(path);
+    Scanner scanner(file.text(), path);
+    TSPInstance instance;
+    int numCities = -1;
+    std::string weightType;
+    std::string weightFormat = "FULL_MATRIX";
+    std::vector<double> table;
+    bool haveCoordinates = false;
+
+    while (!scanner.atEnd()) {
+        std::string_view line = trim(scanner.line());
+        std::size_t colon = line.find(':');
+        std::string key(trim(line.substr(0, colon)));
+        std::string value(colon == std::string_view::npos ? std::string_view{} : trim(line.substr(colon + 1)));
+        if (key == "EOF") {
+            break;
+        }
+        if (key == "NAME") {
+            instance.name = value;
+        } else if (key == "TYPE") {
+            if (value != "TSP") {
+                scanner.fail("only symmetric TSP instances are supported, not " + value);
+            }
+        } else if (key == "DIMENSION") {
+            numCities = std::stoi(value);
+            if (numCities < 1) {
+                scanner.fail("DIMENSION must be positive");
+            }
+            instance.cityList.resize(numCities);
+            for (int i = 0; i < numCities; i++) {
+                instance.cityList[i] = std::make_shared<City>(i);
+                instance.cityList[i]->setCoordinates(0.0, 0.0, 0.0);
+            }
+        } else if (key == "EDGE_WEIGHT_TYPE") {
+            weightType = value;
+            if (weightType != "EUC_2D" && weightType != "EUC_3D" && weightType != "EXPLICIT") {
+                scanner.fail("unsupported EDGE_WEIGHT_TYPE " + weightType);
+            }
+        } else if (key == "EDGE_WEIGHT_FORMAT") {
+            weightFormat = value;
+        } else if (key == "NODE_COORD_SECTION" || key == "DISPLAY_DATA_SECTION") {
+            if (numCities < 0) {
+                scanner.fail(key + " before DIMENSION");
+            }
+            readCoordinates(scanner, instance.cityList, key == "NODE_COORD_SECTION" && weightType == "EUC_3D");
+            haveCoordinates = true;
+        } else if (key == "EDGE_WEIGHT_SECTION") {
+            if (numCities < 0) {
+                scanner.fail("EDGE_WEIGHT_SECTION before DIMENSION");
+            }
+            table.assign(static_cast<std::size_t>(numCities) * numCities, 0.0);
+            readEdgeWeights(scanner, weightFormat, numCities, table);
+        }
+    }
+
+    if (numCities < 0 || weightType.empty()) {
+        scanner.fail("missing DIMENSION or EDGE_WEIGHT_TYPE");
+    }
+    if (weightType == "EXPLICIT") {
+        if (table.empty()) {
+            scanner.fail("EXPLICIT instance without an EDGE_WEIGHT_SECTION");
+        }
+    } else {
+        if (!haveCoordinates) {
+            scanner.fail("missing NODE_COORD_SECTION");
+        }
+        table = roundedEuclideanTable(instance.cityList);
+    }
+    instance.distances = std::make_shared<const std::vector<double>>(std::move(table));
+
+    std::string tourPath = path.substr(0, path.rfind('.')) + ".opt.tour";
+    if (::access(tourPath.c_str(), R_OK) == 0) {
+        try {
+            std::vector<int> tour = loadTsplibTour(tourPath);
+            if (static_cast<int>(tour.size()) != numCities ||
+                *std::max_element(tour.begin(), tour.end()) >= numCities) {
+                throw std::runtime_error(tourPath + ": tour does not visit the " + std::to_string(numCities) +
+                                         " cities of " + path);
+            }
+            instance.optimum = instance.tourLength(tour);
+        } catch (const std::exception &error) {
+            std::cerr << "Ignoring the known optimum: " << error.what() << std::endl;
+        }
+    }
+    return instance;
+}
+
+/**
+ * @brief Load a waypoint list in the City,X,Y,Z layout written to city_coordinates.csv.
+ *
+ * A header line is skipped if present. Cities are numbered in file order; distances are
+ * left to the distance matrix.
+ *
+ * @param path The CSV file.
+ * @return TSPInstance The cities, without a distance table.
+ * @throws std::runtime_error if the file cannot be read or a row is malformed.
+ */
+TSPInstance loadCsvInstance(const std::string &path) {
+    MappedFile file(path);
+    std::string_view text = file.text();
+    Scanner scanner(text, path);
+    TSPInstance instance;
+    std::size_t slash = path.find_last_of('/');
+    instance.name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    instance.cityList.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+
+    if (!scanner.atEnd()) {
+        std::string_view first = trim(text.substr(0, text.find('\n')));
+        if (!first.empty() && !std::isdigit(static_cast<unsigned char>(first.front())) && first.front() != '-') {
+            scanner.line();
+        }
+    }
+    while (!scanner.atEnd()) {
+        scanner.number<long long>();
+        scanner.skip(',');
+        double x = scanner.number<double>();
+        scanner.skip(',');
+        double y = scanner.number<double>();
+        scanner.skip(',');
+        double z = scanner.number<double>();
+        int id = static_cast<int>(instance.cityList.size());
+        instance.cityList.push_back(std::make_shared<City>(id));
+        instance.cityList.back()->setCoordinates(x, y, z);
+    }
+    if (instance.cityList.empty()) {
+        scanner.fail("no waypoints");
+    }
+    return instance;
+}
+
+/**
+ * @brief Load an instance, choosing the format from the extension: .tsp is TSPLIB, anything else CSV.
+ */
+TSPInstance loadInstance(const std::string &path) {
+    if (path.size() >= 4 && path.compare(path.size() - 4, 4, ".tsp") == 0) {
+        return loadTsplibInstance(path);
+    }
+    return loadCsvInstance(path);
+}
+
+/**
+ * @brief Read the TOUR_SECTION of a TSPLIB tour file.
+ *
+ * Every id must be at least 1 and appear once. If the file gives a DIMENSION, the tour
+ * must list exactly that many cities, none above it.
+ *
+ * @param path The .tour file.
+ * @return std::vector<int> The tour, converted to 0-based city indices.
+ * @throws std::runtime_error if the file cannot be read, has no TOUR_SECTION or is not a tour.
+ */
+std::vector<int> loadTsplibTour(const std::string &path) {
+    MappedFile file(path);
+    Scanner scanner(file.text(), path);
+    int dimension = -1;
+    while (!scanner.atEnd()) {
+        std::string_view line = trim(scanner.line());
+        std::size_t colon = line.find(':');
+        std::string_view key = trim(line.substr(0, colon));
+        if (key == "DIMENSION" && colon != std::string_view::npos) {
+            dimension = std::stoi(std::string(trim(line.substr(colon + 1))));
+        } else if (key == "TOUR_SECTION") {
+            std::vector<int> tour;
+            while (!scanner.atEnd()) {
+                int id = scanner.number<int>();
+                if (id == -1) {
+                    break;
+                }
+                if (id < 1 || (dimension > 0 && id > dimension)) {
+                    scanner.fail("city " + std::to_string(id) + " is out of range");
+                }
+                tour.push_back(id - 1);
+            }
+            if (tour.empty() || (dimension > 0 && static_cast<int>(tour.size()) != dimension)) {
+                scanner.fail("TOUR_SECTION does not list DIMENSION cities");
+            }
+            std::vector<int> sorted = tour;
+            std::sort(sorted.begin(), sorted.end());
+            if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+                scanner.fail("TOUR_SECTION lists a city twice");
+            }
+            return tour;
+        }
+    }
+    scanner.fail("no TOUR_SECTION");
+}
+
+/**
+ * @brief How far a tour length is above the optimum, as a fraction of the optimum.
+ *
+ * @return double (length - optimum) / optimum, or 0 if the optimum is not known (<= 0).
+ */
+double optimalityGap(double length, double optimum) {
+    return optimum > 0.0 ? (length - optimum) / optimum : 0.0;
+}
@@ -0,0 +1,218 @@
+#include "islandWorkerDefinition.hpp"
+#include "utils.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace {
+
+/**
+ * @brief Start pso_worker with the given arguments.
+ *
+ * @return pid_t The child's process id.
+ * @throws std::runtime_error if the process cannot be started.
+ */
+pid_t spawnWorker(const std::string &executable, const std::vector<std::string> &arguments) {
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(executable.c_str()));
+    for (const std::string &argument : arguments) {
+        argv.push_back(const_cast<char *>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+    pid_t pid;
+    if (posix_spawnp(&pid, executable.c_str(), nullptr, nullptr, argv.data(), environ) != 0) {
+        throw std::runtime_error("Cannot start " + executable);
+    }
+    return pid;
+}
+
+}
+
+/**
+ * @brief Run an island-model solve over several worker processes and collect the best tour.
+ *
+ * Usage: pso_coordinator [--workers=N] [--transport=shm|socket] [--max-restarts=R] [--pin]
+ *                        [--seed=S] [--crash-worker=I:E] [solver and island arguments as for pso]
+ *
+ * The coordinator creates the migration channel, a shared-memory mailbox by default or
+ * a Unix-socket relay with `--transport=socket`, and launches N pso_worker processes.
+ * A worker that crashes is relaunched up to R times (default 1) and resumes from the
+ * elites it last published; if it cannot be restarted the others carry on without it.
+ * `--pin` spreads the workers evenly over the CPUs, and therefore over the sockets of
+ * a NUMA machine. `--crash-worker=I:E` makes worker I abort after epoch E, to exercise
+ * recovery. The best route over all workers is printed and saved like pso does.
+ *
+ * @return int Returns 0 if a route was collected and 1 otherwise.
+ */
+int main(int argc, char *argv[]) {
+    int numWorkers = static_cast<int>(std::thread::hardware_concurrency());
+    bool useSocket = false;
+    int maxRestarts = 1;
+    bool pin = false;
+    std::uint64_t seed = (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+    int crashWorker = -1;
+    int crashEpoch = -1;
+    WorkerOptions options;
+    std::vector<std::string> passThrough;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            if (argument.rfind("--workers=", 0) == 0) {
+                numWorkers = std::stoi(argument.substr(10));
+            } else if (argument == "--transport=shm") {
+                useSocket = false;
+            } else if (argument == "--transport=socket") {
+                useSocket = true;
+            } else if (argument.rfind("--max-restarts=", 0) == 0) {
+                maxRestarts = std::stoi(argument.substr(15));
+            } else if (argument == "--pin") {
+                pin = true;
+            } else if (argument.rfind("--seed=", 0) == 0) {
+                seed = std::stoull(argument.substr(7));
+            } else if (argument.rfind("--crash-worker=", 0) == 0) {
+                std::string spec = argument.substr(15);
+                crashWorker = std::stoi(spec.substr(0, spec.find(':')));
+                crashEpoch = std::stoi(spec.substr(spec.find(':') + 1));
+            } else if (parseConfigArgument(options.config, argument) || parseIslandArgument(options.islandConfig, argument)) {
+                passThrough.push_back(argument);
+            } else {
+                throw std::invalid_argument("unknown argument " + argument);
+            }
+        }
+        if (numWorkers < 1) {
+            throw std::invalid_argument("--workers must be at least 1");
+        }
+        options.config.validate();
+        options.islandConfig.validate();
+    } catch (const std::exception &error) {
+        std::cerr << "pso_coordinator: " << error.what() << std::endl;
+        return 1;
+    }
+
+    // Create the migration channel the workers attach to
+    std::string channelName = useSocket ? "/tmp/pso-relay-" + std::to_string(getpid()) + ".sock"
+                                        : "/pso-mailbox-" + std::to_string(getpid());
+    std::unique_ptr<MigrationTransport> channel;
+    SharedMemoryMailbox *mailbox = nullptr;
+    if (useSocket) {
+        channel = std::make_unique<SocketRelay>(channelName, numWorkers, options.config.numCities,
+                                                std::max(1, options.islandConfig.numMigrants));
+    } else {
+        auto shared = std::make_unique<SharedMemoryMailbox>(channelName, numWorkers, options.config.numCities,
+                                                            std::max(1, options.islandConfig.numMigrants));
+        mailbox = shared.get();
+        channel = std::move(shared);
+    }
+
+    // pso_worker is expected next to this executable
+    std::string self = argv[0];
+    std::string executable = self.find('/') == std::string::npos ? "pso_worker"
+                                                                 : self.substr(0, self.rfind('/') + 1) + "pso_worker";
+    int numCpus = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    auto launch = [&](int worker, bool resume) {
+        std::vector<std::string> arguments = passThrough;
+        arguments.push_back("--worker=" + std::to_string(worker));
+        arguments.push_back("--workers=" + std::to_string(numWorkers));
+        arguments.push_back("--seed=" + std::to_string(seed));
+        arguments.push_back((useSocket ? "--socket=" : "--mailbox=") + channelName);
+        if (pin) {
+            arguments.push_back("--cpu=" + std::to_string(worker * numCpus / numWorkers));
+        }
+        if (resume) {
+            arguments.push_back("--resume");
+        } else if (worker == crashWorker) {
+            arguments.push_back("--crash-after=" + std::to_string(crashEpoch));
+        }
+        return spawnWorker(executable, arguments);
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::map<pid_t, int> running;
+    std::vector<int> restarts(numWorkers, 0);
+    int crashed = 0;
+    for (int w = 0; w < numWorkers; w++) {
+        running[launch(w, false)] = w;
+    }
+
+    // Reap workers, restarting the ones that crash
+    while (!running.empty()) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            break;
+        }
+        auto it = running.find(pid);
+        if (it == running.end()) {
+            continue;
+        }
+        int worker = it->second;
+        running.erase(it);
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            continue;
+        }
+        crashed++;
+        if (mailbox) {
+            mailbox->recover(worker);
+        }
+        std::cerr << "Worker " << worker << " failed ("
+                  << (WIFSIGNALED(status) ? "signal " + std::to_string(WTERMSIG(status))
+                                          : "exit " + std::to_string(WEXITSTATUS(status)))
+                  << ")";
+        if (restarts[worker] < maxRestarts) {
+            restarts[worker]++;
+            running[launch(worker, true)] = worker;
+            std::cerr << ", restarted from its last elites" << std::endl;
+        } else {
+            std::cerr << ", continuing without it" << std::endl;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Collect the best route any worker published
+    MigrantPacket best;
+    int finished = 0;
+    for (int w = 0; w < numWorkers; w++) {
+        MigrantPacket packet;
+        if (!channel->fetch(w, packet) || packet.routes.empty()) {
+            continue;
+        }
+        finished += packet.finished ? 1 : 0;
+        if (best.routes.empty() || packet.bestFitness < best.bestFitness) {
+            best = packet;
+        }
+    }
+    if (best.routes.empty()) {
+        std::cerr << "pso_coordinator: no worker published a route" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Best Path: ";
+    for (int city : best.routes.front()) {
+        std::cout << city << " ";
+    }
+    std::cout << std::endl;
+    std::cout << "Best Distance: " << best.bestFitness << " (worker " << best.worker << " of " << numWorkers << ")" << std::endl;
+    std::cout << "Seed: " << seed << std::endl;
+    std::cout << "Workers: " << finished << " finished, " << crashed << " crashed" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Execution Time: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+              << " milliseconds" << std::endl;
+
+    // The workers all built their cities from the master seed, so rebuild them here to save the route
+    PSO cities;
+    cities.setSeed(seed);
+    cities.generateCityCoordinates(options.config.numCities);
+    saveBestRouteCoordinates(best.routes.front(), cities.getCityList());
+    saveRouteCoordinatesXYZ(best.routes.front(), cities.getCityList());
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file islandModelImplementation.cpp
+ * @brief Implementation of the island-model multi-swarm solver.
+ */
+
+#include "islandModelDefinition.hpp"
+#include "randomDefinition.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @brief Check that the island shape is usable.
+ *
+ * @throws std::invalid_argument if a count or the interval is out of range.
+ */
+void IslandConfig::validate() const {
+    if (numIslands < 1) {
+        throw std::invalid_argument("IslandConfig: numIslands must be at least 1");
+    }
+    if (migrationInterval < 1) {
+        throw std::invalid_argument("IslandConfig: migrationInterval must be at least 1");
+    }
+    if (numMigrants < 0) {
+        throw std::invalid_argument("IslandConfig: numMigrants must not be negative");
+    }
+}
+
+/**
+ * @brief Apply one `--name=value` command-line argument to an island config.
+ *
+ * Recognised names are islands, migration-interval, migrants and migration (ring or full).
+ *
+ * @param config The config to update.
+ * @param argument The argument as given on the command line.
+ * @return true if the argument named an island parameter.
+ * @throws std::invalid_argument if the value cannot be parsed.
+ */
+bool parseIslandArgument(IslandConfig &config, const std::string &argument) {
+    if (argument.rfind("--islands=", 0) == 0) {
+        config.numIslands = std::stoi(argument.substr(10));
+    } else if (argument.rfind("--migration-interval=", 0) == 0) {
+        config.migrationInterval = std::stoi(argument.substr(21));
+    } else if (argument.rfind("--migrants=", 0) == 0) {
+        config.numMigrants = std::stoi(argument.substr(11));
+    } else if (argument == "--migration=ring") {
+        config.topology = MigrationTopology::Ring;
+    } else if (argument == "--migration=full") {
+        config.topology = MigrationTopology::FullyConnected;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Create the model; nothing is allocated until initialize().
+ *
+ * @param config The solver parameters every island uses.
+ * @param islandConfig The number of islands and the migration scheme.
+ * @param seed The master seed; the instance and every island's seed derive from it.
+ */
+IslandModel::IslandModel(const PSOConfig &config, const IslandConfig &islandConfig, std::uint64_t seed)
+    : config(config), islandConfig(islandConfig), seed(seed) {
+    config.validate();
+    islandConfig.validate();
+}
+
+/**
+ * @brief Generate the instance once and seed every island's swarm on it.
+ *
+ * The cities come from the instance given to setInstance, or otherwise from the
+ * master seed, as in a single PSO run with that seed.
+ * Island i draws its particles from its own seed taken from the master seed's
+ * island stream, and all islands share the first island's distance matrix.
+ */
+void IslandModel::initialize() {
+    islands.clear();
+    for (int i = 0; i < islandConfig.numIslands; i++) {
+        auto island = std::make_unique<PSO>(config);
+        island->setExecutionMode(ExecutionMode::Serial);
+        island->setTraceSampling(TraceSampling::Off);
+        if (i == 0) {
+            island->setSeed(seed);
+            if (instance) {
+                island->loadInstance(*instance);
+            } else {
+                island->generateCityCoordinates(config.numCities);
+            }
+            island->initializeDistanceMatrix();
+        } else {
+            island->shareInstance(*islands.front());
+        }
+        PhiloxStream stream(seed, RandomDomain::Islands, static_cast<std::uint32_t>(i));
+        island->setSeed((static_cast<std::uint64_t>(stream()) << 32) | stream());
+        island->initializeParticles(config.numParticles, config.numCities);
+        islands.push_back(std::move(island));
+    }
+    iterationsRun = 0;
+}
+
+/**
+ * @brief Send every island's elites to its neighbours.
+ *
+ * All elites are collected before any are injected, so the result does not depend
+ * on the order islands are visited in.
+ */
+void IslandModel::migrate() {
+    int k = size();
+    if (k < 2 || islandConfig.numMigrants == 0) {
+        return;
+    }
+    std::vector<std::vector<std::vector<int>>> elites(k);
+    for (int i = 0; i < k; i++) {
+        elites[i] = islands[i]->getEliteRoutes(islandConfig.numMigrants);
+    }
+
+    for (int i = 0; i < k; i++) {
+        std::vector<std::vector<int>> incoming;
+        if (islandConfig.topology == MigrationTopology::Ring) {
+            incoming = elites[(i + k - 1) % k];
+        } else {
+            // Take the best migrants offered by all other islands.
+            std::vector<std::pair<double, const std::vector<int> *>> offers;
+            for (int j = 0; j < k; j++) {
+                if (j == i) {
+                    continue;
+                }
+                for (const auto &route : elites[j]) {
+                    offers.emplace_back(islands[i]->calculateDistance(route, config.numCities), &route);
+                }
+            }
+            int count = std::min(islandConfig.numMigrants, static_cast<int>(offers.size()));
+            std::partial_sort(offers.begin(), offers.begin() + count, offers.end(),
+                              [](const auto &a, const auto &b) { return a.first < b.first; });
+            for (int m = 0; m < count; m++) {
+                incoming.push_back(*offers[m].second);
+            }
+        }
+        islands[i]->injectRoutes(incoming, config.numCities);
+    }
+}
+
+/**
+ * @brief Run all islands for the configured number of iterations.
+ *
+ * Each island runs on its own thread between migrations. The time budget of the
+ * config is checked at every migration; the other anytime rules are not used here.
+ *
+ * @return StopReason MaxIterations, or TimeBudget if the budget ran out first.
+ */
+StopReason IslandModel::run() {
+    auto start = std::chrono::steady_clock::now();
+    std::ofstream discard;
+    for (auto &island : islands) {
+        island->beginRun(discard, config.numCities);
+    }
+
+    // The thread calling parallelFor runs islands too, so the pool gets one worker fewer.
+    ThreadPool pool(size() - 1);
+    stopReason = StopReason::MaxIterations;
+    while (iterationsRun < config.maxIterations) {
+        int epoch = std::min(islandConfig.migrationInterval, config.maxIterations - iterationsRun);
+        int first = iterationsRun;
+        pool.parallelFor(size(), [&](int i) {
+            for (int iter = first; iter < first + epoch; iter++) {
+                islands[i]->updateParticles(iter, discard, config.numCities);
+            }
+        });
+        iterationsRun += epoch;
+        if (iterationsRun < config.maxIterations) {
+            migrate();
+        }
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (config.timeBudgetMs > 0.0 && elapsedMs >= config.timeBudgetMs && iterationsRun < config.maxIterations) {
+            stopReason = StopReason::TimeBudget;
+            break;
+        }
+    }
+
+    for (auto &island : islands) {
+        island->endRun();
+    }
+    return stopReason;
+}
+
+/**
+ * @brief Index of the island holding the best route found so far.
+ */
+int IslandModel::getBestIsland() const {
+    int best = 0;
+    for (int i = 1; i < size(); i++) {
+        if (islands[i]->getGlobalBestFitness() < islands[best]->getGlobalBestFitness()) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Print the best route over all islands, in the same layout as PSO::printResults.
+ *
+ * @param executionTime The total execution time in milliseconds.
+ */
+void IslandModel::printResults(double executionTime) const {
+    int best = getBestIsland();
+    std::cout << "Best Path: ";
+    for (int city : islands[best]->getGlobalBestRoute()) {
+        std::cout << city << " ";
+    }
+    std::cout << std::endl;
+    std::cout << "Best Distance: " << islands[best]->getExactBestFitness() << " (island " << best << " of " << size() << ")" << std::endl;
+    if (islands[best]->getKnownOptimum() > 0.0) {
+        std::cout << "Optimality Gap: "
+                  << 100.0 * optimalityGap(islands[best]->getExactBestFitness(), islands[best]->getKnownOptimum())
+                  << "% (optimum " << islands[best]->getKnownOptimum() << ")" << std::endl;
+    }
+    std::cout << "Seed: " << seed << std::endl;
+    std::cout << "Stopped: " << stopReasonName(stopReason) << " after " << iterationsRun << " iterations" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Execution Time: " << executionTime << " milliseconds" << std::endl;
+}
@@ -0,0 +1,64 @@
+#include "islandWorkerDefinition.hpp"
+#include <iostream>
+#include <memory>
+#include <string>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @brief One island worker process, normally started by pso_coordinator.
+ *
+ * Usage: pso_worker --worker=I --workers=N (--mailbox=/NAME | --socket=PATH) [--cpu=K]
+ *                   [--seed=S] [--resume] [solver and island arguments as for pso]
+ *
+ * `--mailbox` exchanges migrants through the coordinator's shared-memory mailbox and
+ * `--socket` through its Unix-socket relay. `--cpu` pins the process to one CPU.
+ *
+ * @return int Returns 0 on success and 1 on a usage or transport error.
+ */
+int main(int argc, char *argv[]) {
+    WorkerOptions options;
+    std::string mailboxName;
+    std::string socketPath;
+    int cpu = -1;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            if (argument.rfind("--mailbox=", 0) == 0) {
+                mailboxName = argument.substr(10);
+            } else if (argument.rfind("--socket=", 0) == 0) {
+                socketPath = argument.substr(9);
+            } else if (argument.rfind("--cpu=", 0) == 0) {
+                cpu = std::stoi(argument.substr(6));
+            } else if (!parseWorkerArgument(options, argument)) {
+                throw std::invalid_argument("unknown argument " + argument);
+            }
+        }
+        options.config.validate();
+        options.islandConfig.validate();
+
+#ifdef __linux__
+        if (cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            sched_setaffinity(0, sizeof(cpus), &cpus);
+        }
+#endif
+
+        std::unique_ptr<MigrationTransport> transport;
+        if (!mailboxName.empty()) {
+            transport = std::make_unique<SharedMemoryMailbox>(mailboxName);
+        } else if (!socketPath.empty()) {
+            transport = std::make_unique<SocketTransport>(socketPath);
+        } else {
+            throw std::invalid_argument("one of --mailbox or --socket is required");
+        }
+        runIslandWorker(options, *transport);
+    } catch (const std::exception &error) {
+        std::cerr << "pso_worker " << options.worker << ": " << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file islandWorkerImplementation.cpp
+ * @brief One island of a multi-process run, exchanging migrants through a transport.
+ */
+
+#include "islandWorkerDefinition.hpp"
+#include "randomDefinition.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+/**
+ * @brief Apply one `--name=value` worker argument, including config and island arguments.
+ *
+ * Worker-specific names are worker, workers, seed, resume and crash-after (a test hook
+ * that aborts the process after that many epochs).
+ *
+ * @return true if the argument was recognised.
+ * @throws std::invalid_argument if the value cannot be parsed.
+ */
+bool parseWorkerArgument(WorkerOptions &options, const std::string &argument) {
+    if (argument.rfind("--worker=", 0) == 0) {
+        options.worker = std::stoi(argument.substr(9));
+    } else if (argument.rfind("--workers=", 0) == 0) {
+        options.numWorkers = std::stoi(argument.substr(10));
+    } else if (argument.rfind("--seed=", 0) == 0) {
+        options.seed = std::stoull(argument.substr(7));
+    } else if (argument == "--resume") {
+        options.resume = true;
+    } else if (argument.rfind("--crash-after=", 0) == 0) {
+        options.crashAfterEpochs = std::stoi(argument.substr(14));
+    } else {
+        return parseConfigArgument(options.config, argument) || parseIslandArgument(options.islandConfig, argument);
+    }
+    return true;
+}
+
+/**
+ * @brief Run one island to completion, publishing elites and taking in migrants.
+ *
+ * The worker builds the instance from the master seed and draws its particles from
+ * the same per-island seed IslandModel would give island `worker`. After every
+ * migrationInterval iterations it publishes its elites and injects the newest
+ * packets of its neighbours (ring or all others). It never waits for a neighbour,
+ * so a crashed or slow worker only means fewer migrants. With `resume` the worker
+ * first reinjects the routes of its own last packet, continuing a crashed
+ * predecessor's search. The final packet carries the best route and is marked finished.
+ *
+ * @param options Which island this is and how the run is set up.
+ * @param transport The channel shared with the other workers.
+ * @return MigrantPacket The final packet, as published.
+ */
+MigrantPacket runIslandWorker(const WorkerOptions &options, MigrationTransport &transport) {
+    const PSOConfig &config = options.config;
+    const IslandConfig &islandConfig = options.islandConfig;
+    int numCities = config.numCities;
+
+    PSO pso(config);
+    pso.setExecutionMode(ExecutionMode::Serial);
+    pso.setTraceSampling(TraceSampling::Off);
+    pso.setSeed(options.seed);
+    pso.generateCityCoordinates(numCities);
+    pso.initializeDistanceMatrix();
+    PhiloxStream stream(options.seed, RandomDomain::Islands, static_cast<std::uint32_t>(options.worker));
+    pso.setSeed((static_cast<std::uint64_t>(stream()) << 32) | stream());
+    pso.initializeParticles(config.numParticles, numCities);
+
+    MigrantPacket packet;
+    int epoch = 0;
+    if (options.resume && transport.fetch(options.worker, packet)) {
+        pso.injectRoutes(packet.routes, numCities);
+        epoch = packet.epoch + 1;
+    }
+
+    std::vector<int> lastSeen(options.numWorkers, -1);
+    std::ofstream discard;
+    pso.beginRun(discard, numCities);
+    int iteration = epoch * islandConfig.migrationInterval;
+    while (iteration < config.maxIterations) {
+        int end = std::min(iteration + islandConfig.migrationInterval, config.maxIterations);
+        for (; iteration < end; iteration++) {
+            pso.updateParticles(iteration, discard, numCities);
+        }
+
+        // The global best leads the elites, so routes[0] is the route of length bestFitness
+        MigrantPacket elites{options.worker, epoch, false, pso.getGlobalBestFitness(),
+                             pso.getEliteRoutes(std::max(1, islandConfig.numMigrants))};
+        transport.publish(elites);
+        if (epoch == options.crashAfterEpochs) {
+            std::abort();
+        }
+
+        std::vector<std::vector<int>> incoming;
+        for (int n = 0; n < options.numWorkers; n++) {
+            bool neighbour = islandConfig.topology == MigrationTopology::FullyConnected
+                                 ? n != options.worker
+                                 : n == (options.worker + options.numWorkers - 1) % options.numWorkers;
+            if (neighbour && n != options.worker && transport.fetch(n, packet) && packet.epoch > lastSeen[n]) {
+                lastSeen[n] = packet.epoch;
+                incoming.insert(incoming.end(), packet.routes.begin(), packet.routes.end());
+            }
+        }
+        std::sort(incoming.begin(), incoming.end(), [&](const auto &a, const auto &b) {
+            return pso.calculateDistance(a, numCities) < pso.calculateDistance(b, numCities);
+        });
+        incoming.resize(std::min<std::size_t>(incoming.size(), islandConfig.numMigrants));
+        pso.injectRoutes(incoming, numCities);
+        epoch++;
+    }
+    pso.endRun();
+
+    MigrantPacket result{options.worker, epoch, true, pso.getGlobalBestFitness(), {pso.getGlobalBestRoute()}};
+    transport.publish(result);
+    return result;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file kdTreeImplementation.cpp
+ * @brief Construction and k-nearest queries of the implicit k-d tree.
+ */
+
+#include "kdTreeDefinition.hpp"
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @brief Build the tree over a list of cities.
+ *
+ * @param cityList The cities to index; a city's index in the list is its id in queries.
+ */
+void KdTree::build(const std::vector<std::shared_ptr<City>> &cityList) {
+    int n = static_cast<int>(cityList.size());
+    cities.resize(n);
+    std::iota(cities.begin(), cities.end(), 0);
+    axes.assign(n, 0);
+    std::vector<double> coordinates(3 * static_cast<std::size_t>(n));
+    for (int i = 0; i < n; i++) {
+        std::tie(coordinates[3 * i], coordinates[3 * i + 1], coordinates[3 * i + 2]) = cityList[i]->getCoordinates();
+    }
+    // Partition the ids first, then lay the coordinates out in tree order
+    points.swap(coordinates);
+    buildRange(0, n);
+    coordinates.resize(points.size());
+    for (int i = 0; i < n; i++) {
+        std::copy(points.begin() + 3 * cities[i], points.begin() + 3 * cities[i] + 3, coordinates.begin() + 3 * i);
+    }
+    points.swap(coordinates);
+}
+
+/**
+ * @brief Make the median of cities[begin, end) along the widest axis the range's node.
+ *
+ * While building, points is still indexed by city id.
+ */
+void KdTree::buildRange(int begin, int end) {
+    if (end - begin <= 1) {
+        return;
+    }
+    double low[3], high[3];
+    for (int a = 0; a < 3; a++) {
+        low[a] = high[a] = points[3 * cities[begin] + a];
+    }
+    for (int i = begin + 1; i < end; i++) {
+        for (int a = 0; a < 3; a++) {
+            low[a] = std::min(low[a], points[3 * cities[i] + a]);
+            high[a] = std::max(high[a], points[3 * cities[i] + a]);
+        }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (high[a] - low[a] > high[axis] - low[axis]) {
+            axis = a;
+        }
+    }
+
+    int mid = begin + (end - begin) / 2;
+    std::nth_element(cities.begin() + begin, cities.begin() + mid, cities.begin() + end, [&](int a, int b) {
+        return points[3 * a + axis] < points[3 * b + axis];
+    });
+    axes[mid] = static_cast<unsigned char>(axis);
+    buildRange(begin, mid);
+    buildRange(mid + 1, end);
+}
+
+/**
+ * @brief Collect the k nearest cities of the query point in the range into a max-heap.
+ *
+ * The heap is ordered by squared distance and then city id, so ties resolve to the
+ * lower id whatever order the nodes are visited in.
+ */
+void KdTree::searchRange(int begin, int end, const double *query, int exclude, int k,
+                         std::vector<std::pair<double, int>> &heap) const {
+    if (begin >= end) {
+        return;
+    }
+    int mid = begin + (end - begin) / 2;
+    const double *point = points.data() + 3 * mid;
+    if (cities[mid] != exclude) {
+        double dx = query[0] - point[0];
+        double dy = query[1] - point[1];
+        double dz = query[2] - point[2];
+        std::pair<double, int> candidate{dx * dx + dy * dy + dz * dz, cities[mid]};
+        if (static_cast<int>(heap.size()) < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (candidate < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+    if (end - begin == 1) {
+        return;
+    }
+
+    double diff = query[axes[mid]] - point[axes[mid]];
+    bool leftFirst = diff < 0.0;
+    if (leftFirst) {
+        searchRange(begin, mid, query, exclude, k, heap);
+    } else {
+        searchRange(mid + 1, end, query, exclude, k, heap);
+    }
+    if (static_cast<int>(heap.size()) < k || diff * diff <= heap.front().first) {
+        if (leftFirst) {
+            searchRange(mid + 1, end, query, exclude, k, heap);
+        } else {
+            searchRange(begin, mid, query, exclude, k, heap);
+        }
+    }
+}
+
+/**
+ * @brief Find the k cities nearest to a point, nearest first.
+ *
+ * @param x The x-coordinate of the point.
+ * @param y The y-coordinate of the point.
+ * @param z The z-coordinate of the point.
+ * @param k The number of cities wanted; fewer are returned if the tree is smaller.
+ * @param out Receives the city ids.
+ * @param exclude A city id to leave out, typically the city at the point; -1 for none.
+ */
+void KdTree::nearest(double x, double y, double z, int k, std::vector<int> &out, int exclude) const {
+    std::vector<std::pair<double, int>> heap;
+    heap.reserve(k + 1);
+    double query[3] = {x, y, z};
+    if (k > 0) {
+        searchRange(0, size(), query, exclude, k, heap);
+    }
+    std::sort_heap(heap.begin(), heap.end());
+    out.resize(heap.size());
+    for (std::size_t i = 0; i < heap.size(); i++) {
+        out[i] = heap[i].second;
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file localSearchImplementation.cpp
+ * @brief Candidate neighbour lists and the array bookkeeping of the local search moves.
+ */
+
+#include "localSearchDefinition.hpp"
+#include "kdTreeDefinition.hpp"
+#include "threadPoolDefinition.hpp"
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @brief Find the k nearest other cities of every city.
+ *
+ * Ties are broken by city index so the lists do not depend on the sort implementation.
+ *
+ * @param distances The instance's distance matrix.
+ * @param k The number of candidates per city; capped at numCities - 1.
+ */
+void NeighbourLists::build(const DistanceMatrix &distances, int k) {
+    numCities = distances.size();
+    count = std::max(0, std::min(k, numCities - 1));
+    neighbours.assign(static_cast<std::size_t>(numCities) * count, 0);
+
+    std::vector<int> others(numCities > 0 ? numCities - 1 : 0);
+    distances.visit([&](const auto &view) {
+        for (int city = 0; city < numCities; city++) {
+            std::iota(others.begin(), others.begin() + city, 0);
+            std::iota(others.begin() + city, others.end(), city + 1);
+            std::partial_sort(others.begin(), others.begin() + count, others.end(), [&](int a, int b) {
+                double da = view(city, a);
+                double db = view(city, b);
+                return da < db || (da == db && a < b);
+            });
+            std::copy(others.begin(), others.begin() + count, neighbours.begin() + static_cast<std::size_t>(city) * count);
+        }
+    });
+}
+
+/**
+ * @brief Find the k nearest other cities of every city from their coordinates.
+ *
+ * Queries a k-d tree instead of scanning rows, so the cost is O(N k log N) and no
+ * distance table is needed. Ties are broken by city index as in the matrix version.
+ *
+ * @param cityList The cities of the instance.
+ * @param k The number of candidates per city; capped at numCities - 1.
+ * @param pool An optional thread pool to run the queries on.
+ */
+void NeighbourLists::build(const std::vector<std::shared_ptr<City>> &cityList, int k, ThreadPool *pool) {
+    numCities = static_cast<int>(cityList.size());
+    count = std::max(0, std::min(k, numCities - 1));
+    neighbours.assign(static_cast<std::size_t>(numCities) * count, 0);
+
+    KdTree tree;
+    tree.build(cityList);
+    auto query = [&](int city) {
+        std::vector<int> nearest;
+        auto [x, y, z] = cityList[city]->getCoordinates();
+        tree.nearest(x, y, z, count, nearest, city);
+        std::copy(nearest.begin(), nearest.end(), neighbours.begin() + static_cast<std::size_t>(city) * count);
+    };
+    if (pool != nullptr) {
+        pool->parallelFor(numCities, query);
+    } else {
+        for (int city = 0; city < numCities; city++) {
+            query(city);
+        }
+    }
+}
+
+/**
+ * @brief Index the tour's positions and queue every city, in tour order.
+ */
+void LocalSearch::prepare(std::span<const int> route) {
+    numCities = static_cast<int>(route.size());
+    position.resize(numCities);
+    queued.assign(numCities, 1);
+    queue.resize(numCities);
+    for (int pos = 0; pos < numCities; pos++) {
+        position[route[pos]] = pos;
+        queue[pos] = route[pos];
+    }
+    queueHead = 0;
+    queueSize = numCities;
+}
+
+/**
+ * @brief Clear a city's don't-look bit by queueing it, unless it is already queued.
+ */
+void LocalSearch::push(int city) {
+    if (queued[city]) {
+        return;
+    }
+    queued[city] = 1;
+    queue[(queueHead + queueSize) % numCities] = city;
+    queueSize++;
+}
+
+/**
+ * @brief Take the next city to examine, setting its don't-look bit.
+ *
+ * @return false once no city is left to examine.
+ */
+bool LocalSearch::pop(int &city) {
+    if (queueSize == 0) {
+        return false;
+    }
+    city = queue[queueHead];
+    queueHead = next(queueHead);
+    queueSize--;
+    queued[city] = 0;
+    return true;
+}
+
+/**
+ * @brief Reverse the tour from position first forward to position last, wrapping around.
+ *
+ * Reversing the complementary path gives the same cycle, so the shorter of the two is
+ * reversed.
+ */
+void LocalSearch::reverse(std::span<int> route, int first, int last) {
+    int length = (last - first + numCities) % numCities + 1;
+    if (2 * length > numCities) {
+        int newFirst = next(last);
+        last = prev(first);
+        first = newFirst;
+        length = numCities - length;
+    }
+    for (int k = 0; k < length / 2; k++) {
+        std::swap(route[first], route[last]);
+        position[route[first]] = first;
+        position[route[last]] = last;
+        first = next(first);
+        last = prev(last);
+    }
+}
+
+/**
+ * @brief Move the segment of length cities at position start to just after position after.
+ *
+ * The cities between the segment and its destination are shifted along whichever way
+ * round the tour is shorter.
+ *
+ * @param reversed Whether the segment is inserted in the opposite orientation.
+ */
+void LocalSearch::moveSegment(std::span<int> route, int start, int length, int after, bool reversed) {
+    for (int k = 0; k < length; k++) {
+        segment[k] = route[(start + (reversed ? length - 1 - k : k)) % numCities];
+    }
+    int forwardGap = (after - (start + length - 1) + 2 * numCities) % numCities;
+    int backwardGap = numCities - length - forwardGap;
+    int target;
+    if (forwardGap <= backwardGap) {
+        for (int k = 0; k < forwardGap; k++) {
+            int to = (start + k) % numCities;
+            route[to] = route[(start + length + k) % numCities];
+            position[route[to]] = to;
+        }
+        target = (start + forwardGap) % numCities;
+    } else {
+        for (int k = 0; k < backwardGap; k++) {
+            int to = (start + length - 1 - k + numCities) % numCities;
+            route[to] = route[(start - 1 - k + 2 * numCities) % numCities];
+            position[route[to]] = to;
+        }
+        target = next(after);
+    }
+    for (int k = 0; k < length; k++) {
+        int to = (target + k) % numCities;
+        route[to] = segment[k];
+        position[segment[k]] = to;
+    }
+}
@@ -1,7 +1,12 @@
 #include "psoDefinition.hpp"
 #include "utils.hpp"
+#include "swarmHistoryDefinition.hpp"
+#include "islandModelDefinition.hpp"
+#include "fleetPlannerDefinition.hpp"
+#include "randomDefinition.hpp"
 #include <chrono>
 #include <fstream>
+#include <string>
 
 /**
  * @brief Main function to execute the Particle Swarm Optimization (PSO) algorithm.
@@ -9,41 +14,200 @@
  * This function initializes the PSO algorithm, generates city coordinates, computes the distance matrix,
  * and runs the PSO algorithm to find the optimal route. It also logs the results and execution time.
  * 
+ * Passing `--thread-per-particle` runs the original per-iteration threads instead of the
+ * persistent work-stealing pool, so the two execution modes can be compared.
+ * Passing `--check-fitness` cross-checks every incremental fitness update against a
+ * full recompute of the tour length. `--no-fixed-kernels` runs small missions through the
+ * generic particle update instead of the kernels specialised for their city count. `--trace=off`, `--trace=best` and `--trace=every:K`
+ * choose which particle states are written to particle_data.csv. `--history=FILE` writes
+ * them to a binary swarm history instead (see pso_history2csv). `--seed=N` fixes the master
+ * seed so the run can be reproduced exactly; the seed used is printed with the results.
+ * `--profile-trace=FILE` writes the profiled phases as Chrome trace JSON when the
+ * build has PSO_ENABLE_PROFILING on. `--particles=N`, `--iterations=N`, `--cities=N`,
+ * `--inertia=W`, `--cognitive=W` and `--social=W` override the defaults from
+ * ObjectiveFunction.hpp without a rebuild. `--time-budget-ms=T`, `--stall=N`, `--target=D`
+ * and `--target-gap=G` stop the run early, and `--stream-best` prints every new global
+ * best as it is found. `--memetic=personal|global|both` polishes personal or global bests
+ * with 2-opt and Or-opt local search over each city's `--neighbours=K` nearest cities.
+ * `--resync=N` rescores the whole swarm from scratch every N iterations.
+ * `--distances=packed` halves the distance table and `--distances=on-demand` replaces it
+ * with distances computed from the coordinates, for very large city sets.
+ * `--distances=float32`, `--distances=fixed32` and `--distances=fixed16` search on a
+ * smaller table of rounded distances and print the best route's exact length.
+ * `--islands=K` solves with K independent swarms instead, exchanging `--migrants=E`
+ * elite routes every `--migration-interval=M` iterations over a `--migration=ring` or
+ * `--migration=full` topology; particle states are not traced then.
+ * `--instance=FILE` solves a TSPLIB .tsp file or a City,X,Y,Z waypoint CSV instead of
+ * random cities, and `--optimum=D` (or a matching .opt.tour file) reports the gap to the
+ * known optimum. `--replan-add=K` then adds K random waypoints to the finished swarm,
+ * repairs its routes in place and carries on for another run on a seed drawn after the
+ * new waypoints, as a mid-mission re-plan.
+ * `--drones=K` splits the waypoints among K drones instead (`--partition=clusters` or
+ * `--partition=balanced`), solves every drone's tour in parallel and rebalances the tours
+ * for up to `--rebalance-rounds=R` rounds of `--rebalance-iterations=N` iterations; the
+ * tours are saved to drone_routes.csv. `--solution-cache=FILE` looks the waypoints up in a
+ * solution cache file first: a repeat of an earlier mission returns its tour without
+ * searching, a mission sharing most of its waypoints starts from the cached tour, and
+ * a better tour is stored for next time.
+ * 
  * @return int Returns 0 on successful execution.
  */
-int main() {
-    // Initialize the PSO algorithm
-    PSO algoSim;
+int main(int argc, char *argv[]) {
+    // Read the solver parameters, then initialize the PSO algorithm with them
+    PSOConfig config;
+    std::unique_ptr<TSPInstance> instance;
+    for (int i = 1; i < argc; i++) {
+        parseConfigArgument(config, argv[i]);
+        if (std::string(argv[i]).rfind("--instance=", 0) == 0) {
+            auto startLoad = std::chrono::high_resolution_clock::now();
+            instance = std::make_unique<TSPInstance>(loadInstance(std::string(argv[i]).substr(11)));
+            auto endLoad = std::chrono::high_resolution_clock::now();
+            std::cout << "Loaded " << instance->name << ": " << instance->size() << " cities in "
+                      << std::chrono::duration<double, std::milli>(endLoad - startLoad).count() << " ms" << std::endl;
+        }
+    }
+    if (instance) {
+        config.numCities = instance->size();
+    }
+    PSO algoSim(config);
+    int numCities = config.numCities;
+    std::string historyPath;
+    std::string profileTracePath;
+    IslandConfig islandConfig;
+    bool useIslands = false;
+    FleetConfig fleetConfig;
+    bool useFleet = false;
+    double optimum = 0.0;
+    int replanCities = 0;
+    for (int i = 1; i < argc; i++) {
+        if (parseIslandArgument(islandConfig, argv[i])) {
+            useIslands = true;
+        } else if (parseFleetArgument(fleetConfig, argv[i])) {
+            useFleet = true;
+        } else if (std::string(argv[i]) == "--thread-per-particle") {
+            algoSim.setExecutionMode(ExecutionMode::ThreadPerParticle);
+        } else if (std::string(argv[i]) == "--distances=dense") {
+            algoSim.setDistanceStorage(DistanceMatrix::Storage::Dense);
+        } else if (std::string(argv[i]) == "--distances=packed") {
+            algoSim.setDistanceStorage(DistanceMatrix::Storage::PackedUpper);
+        } else if (std::string(argv[i]) == "--distances=on-demand") {
+            algoSim.setDistanceStorage(DistanceMatrix::Storage::OnDemand);
+        } else if (std::string(argv[i]) == "--distances=float32") {
+            algoSim.setDistanceStorage(DistanceMatrix::Storage::Float32);
+        } else if (std::string(argv[i]) == "--distances=fixed32") {
+            algoSim.setDistanceStorage(DistanceMatrix::Storage::Fixed32);
+        } else if (std::string(argv[i]) == "--distances=fixed16") {
+            algoSim.setDistanceStorage(DistanceMatrix::Storage::Fixed16);
+        } else if (std::string(argv[i]).rfind("--solution-cache=", 0) == 0) {
+            algoSim.setSolutionCache(std::make_shared<SolutionCache>(std::string(argv[i]).substr(17)));
+        } else if (std::string(argv[i]).rfind("--optimum=", 0) == 0) {
+            optimum = std::stod(std::string(argv[i]).substr(10));
+        } else if (std::string(argv[i]).rfind("--replan-add=", 0) == 0) {
+            replanCities = std::stoi(std::string(argv[i]).substr(13));
+        } else if (std::string(argv[i]) == "--no-fixed-kernels") {
+            algoSim.setFixedSizeKernels(false);
+        } else if (std::string(argv[i]) == "--check-fitness") {
+            algoSim.setFitnessCrossCheck(true);
+        } else if (std::string(argv[i]) == "--trace=off") {
+            algoSim.setTraceSampling(TraceSampling::Off);
+        } else if (std::string(argv[i]) == "--trace=best") {
+            algoSim.setTraceSampling(TraceSampling::BestOnly);
+        } else if (std::string(argv[i]).rfind("--trace=every:", 0) == 0) {
+            algoSim.setTraceSampling(TraceSampling::EveryKth, std::stoi(std::string(argv[i]).substr(14)));
+        } else if (std::string(argv[i]).rfind("--seed=", 0) == 0) {
+            algoSim.setSeed(std::stoull(std::string(argv[i]).substr(7)));
+        } else if (std::string(argv[i]).rfind("--history=", 0) == 0) {
+            historyPath = std::string(argv[i]).substr(10);
+        } else if (std::string(argv[i]) == "--stream-best") {
+            algoSim.setImprovementCallback([](const BestImprovement &improvement) {
+                std::cout << "Improved: iteration " << improvement.iteration << ", "
+                          << improvement.elapsedMs << " ms, distance " << improvement.fitness << std::endl;
+            });
+        } else if (std::string(argv[i]).rfind("--profile-trace=", 0) == 0) {
+            profileTracePath = std::string(argv[i]).substr(16);
+        }
+    }
 
-    // Generate random coordinates for cities and initialize the distance matrix
-    algoSim.generateCityCoordinates(NUM_CITIES);
-    algoSim.initializeDistanceMatrix();
+    // Use the loaded instance's cities, or generate random coordinates for them
+    if (instance) {
+        algoSim.loadInstance(*instance);
+    } else {
+        algoSim.generateCityCoordinates(numCities);
+    }
+    if (optimum > 0.0) {
+        algoSim.setKnownOptimum(optimum);
+    }
 
     // Retrieve the list of cities and save their coordinates to a CSV file
     std::vector<std::shared_ptr<City>> cityList = algoSim.getCityList();
     std::ofstream coordFile("../csv/city_coordinates.csv");
     coordFile << "City,X,Y,Z\n";
-    for (int i = 0; i < NUM_CITIES; i++) {
+    for (int i = 0; i < numCities; i++) {
         coordFile << i << "," << std::get<0>(cityList[i]->getCoordinates()) << ","
                   << std::get<1>(cityList[i]->getCoordinates()) << ","
                   << std::get<2>(cityList[i]->getCoordinates()) << "\n";
     }
     coordFile.close();
 
+    // With --islands, run the island model on the same cities and report its best route
+    if (useIslands) {
+        auto start = std::chrono::high_resolution_clock::now();
+        IslandModel islandModel(config, islandConfig, algoSim.getSeed());
+        if (instance) {
+            if (optimum > 0.0) {
+                instance->optimum = optimum;
+            }
+            islandModel.setInstance(*instance);
+        }
+        islandModel.initialize();
+        islandModel.run();
+        auto end = std::chrono::high_resolution_clock::now();
+        islandModel.printResults(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+        saveBestRouteCoordinates(islandModel.getBestRoute(), cityList);
+        saveRouteCoordinatesXYZ(islandModel.getBestRoute(), cityList);
+        return 0;
+    }
+
+    // With --drones, plan one tour per drone over the same cities and report the makespan
+    if (useFleet) {
+        auto start = std::chrono::high_resolution_clock::now();
+        FleetPlanner planner(config, fleetConfig, algoSim.getSeed());
+        planner.setCities(cityList);
+        planner.run();
+        auto end = std::chrono::high_resolution_clock::now();
+        planner.printResults(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count());
+        std::vector<std::vector<int>> routes;
+        for (const DroneRoute &drone : planner.getRoutes()) {
+            routes.push_back(drone.route);
+        }
+        saveDroneRoutes(routes, cityList);
+        return 0;
+    }
+
+    // Initialize the distance matrix for the single-swarm run
+    algoSim.initializeDistanceMatrix();
+
     // Open a file to log particle data during the PSO execution
     std::ofstream outFile("../csv/particle_data.csv");
     outFile << "Iteration,ParticleID";
-    for (int i = 0; i < NUM_CITIES; i++) {
+    for (int i = 0; i < numCities; i++) {
         outFile << ",City" << i;
     }
     outFile << ",Fitness\n";
 
+    // Optionally record the swarm as a compact binary history instead of CSV rows
+    std::unique_ptr<SwarmHistoryWriter> history;
+    if (!historyPath.empty()) {
+        history = std::make_unique<SwarmHistoryWriter>(historyPath, cityList, config.numParticles);
+        algoSim.setTraceSink(history->sink());
+    }
+
     // Start the timer for execution time measurement
     auto start = std::chrono::high_resolution_clock::now();
 
     // Initialize particles and run the PSO algorithm
-    algoSim.initializeParticles(NUM_PARTICLES, NUM_CITIES);
-    algoSim.runPSO(outFile, NUM_CITIES);
+    algoSim.initializeParticles(config.numParticles, numCities);
+    algoSim.runPSO(outFile, numCities);
 
     // Stop the timer and calculate the execution time
     auto end = std::chrono::high_resolution_clock::now();
@@ -52,6 +216,36 @@ int main() {
     // Print the results of the PSO algorithm
     algoSim.printResults(executionTime);
 
+    // Optionally export the profiled phases for chrome://tracing
+    if (!profileTracePath.empty()) {
+        std::ofstream profileFile(profileTracePath);
+        algoSim.writeProfileTrace(profileFile);
+    }
+
+    // Optionally add waypoints to the converged swarm and keep searching instead of starting over
+    if (replanCities > 0) {
+        PhiloxStream stream(algoSim.getSeed(), RandomDomain::Cities, 1);
+        auto startReplan = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < replanCities; i++) {
+            double x = -1.0 + 2.0 * stream.uniform();
+            double y = -1.5 + 3.5 * stream.uniform();
+            double z = 1.8 * stream.uniform();
+            algoSim.insertCity(x, y, z);
+        }
+        auto endReplan = std::chrono::high_resolution_clock::now();
+        numCities = algoSim.getConfig().numCities;
+        cityList = algoSim.getCityList();
+        std::cout << "Added " << replanCities << " cities in "
+                  << std::chrono::duration<double, std::milli>(endReplan - startReplan).count()
+                  << " ms, repaired distance " << algoSim.getGlobalBestFitness() << std::endl;
+        // The run restarts at iteration 0, so a new seed keeps it from replaying the first run's draws
+        algoSim.setSeed((static_cast<std::uint64_t>(stream()) << 32) | stream());
+        algoSim.setTraceSampling(TraceSampling::Off);
+        algoSim.runPSO(outFile, numCities);
+        auto endRun = std::chrono::high_resolution_clock::now();
+        algoSim.printResults(std::chrono::duration_cast<std::chrono::milliseconds>(endRun - startReplan).count());
+    }
+
     // Save the best route coordinates to files
     saveBestRouteCoordinates(algoSim.getGlobalBestRoute(), cityList);
     saveRouteCoordinatesXYZ(algoSim.getGlobalBestRoute(), cityList);
@@ -0,0 +1,616 @@
+/**
+ * @file migrationTransportImplementation.cpp
+ * @brief Shared-memory and Unix-socket transports for multi-process island runs.
+ */
+
+#include "migrationTransportDefinition.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAILBOX_MAGIC[4] = {'P', 'S', 'O', 'M'};
+constexpr std::size_t MAILBOX_HEADER_BYTES = 64;
+constexpr std::size_t SLOT_ROUTES_OFFSET = 32;
+// How often fetch retries a slot that is being rewritten before giving up on it
+constexpr int MAX_FETCH_RETRIES = 10000;
+
+constexpr unsigned char REQUEST_PUBLISH = 1;
+constexpr unsigned char REQUEST_FETCH = 2;
+
+// i32 worker, epoch, finished, numRoutes, numCities | f64 bestFitness
+constexpr std::size_t PACKET_HEADER_BYTES = 5 * sizeof(std::int32_t) + sizeof(double);
+constexpr std::size_t MAX_PACKET_BYTES = std::size_t{64} << 20;
+// handleRequest's answer for a request that cannot be framed
+constexpr std::size_t MALFORMED_REQUEST = static_cast<std::size_t>(-1);
+
+std::size_t roundToCacheLine(std::size_t bytes) {
+    return (bytes + 63) / 64 * 64;
+}
+
+template <typename T>
+std::atomic_ref<T> field(unsigned char *slot, std::size_t offset) {
+    return std::atomic_ref<T>(*reinterpret_cast<T *>(slot + offset));
+}
+
+sockaddr_un socketAddress(const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+bool writeAll(int fd, const void *data, std::size_t bytes) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    while (bytes > 0) {
+        ssize_t n = ::send(fd, p, bytes, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        bytes -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool readAll(int fd, void *data, std::size_t bytes) {
+    unsigned char *p = static_cast<unsigned char *>(data);
+    while (bytes > 0) {
+        ssize_t n = ::recv(fd, p, bytes, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        bytes -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+template <typename T>
+void put(std::vector<unsigned char> &buffer, T value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+/**
+ * @brief Append a packet: i32 worker, epoch, finished, numRoutes, numCities | f64 bestFitness | routes.
+ */
+void encodePacket(std::vector<unsigned char> &buffer, const MigrantPacket &packet) {
+    std::int32_t numCities = packet.routes.empty() ? 0 : static_cast<std::int32_t>(packet.routes.front().size());
+    put<std::int32_t>(buffer, packet.worker);
+    put<std::int32_t>(buffer, packet.epoch);
+    put<std::int32_t>(buffer, packet.finished ? 1 : 0);
+    put<std::int32_t>(buffer, static_cast<std::int32_t>(packet.routes.size()));
+    put<std::int32_t>(buffer, numCities);
+    put<double>(buffer, packet.bestFitness);
+    for (const auto &route : packet.routes) {
+        for (int city : route) {
+            put<std::int32_t>(buffer, city);
+        }
+    }
+}
+
+/**
+ * @brief The size of the routes following a packet header, or nothing if its counts
+ *        are negative or the routes would exceed MAX_PACKET_BYTES.
+ */
+std::optional<std::size_t> packetRouteBytes(const unsigned char *header) {
+    std::int32_t counts[2];
+    std::memcpy(counts, header + 3 * sizeof(std::int32_t), sizeof(counts));
+    if (counts[0] < 0 || counts[1] < 0) {
+        return std::nullopt;
+    }
+    std::size_t routeBytes = static_cast<std::size_t>(counts[1]) * sizeof(std::int32_t);
+    if (routeBytes > 0 && static_cast<std::size_t>(counts[0]) > MAX_PACKET_BYTES / routeBytes) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(counts[0]) * routeBytes;
+}
+
+/**
+ * @brief Decode a packet whose header has passed packetRouteBytes and whose routes follow it.
+ */
+void decodePacket(const unsigned char *data, MigrantPacket &packet) {
+    std::int32_t header[5];
+    double bestFitness;
+    std::memcpy(header, data, sizeof(header));
+    std::memcpy(&bestFitness, data + sizeof(header), sizeof(bestFitness));
+    packet.worker = header[0];
+    packet.epoch = header[1];
+    packet.finished = header[2] != 0;
+    packet.bestFitness = bestFitness;
+    packet.routes.assign(static_cast<std::size_t>(header[3]), std::vector<int>(static_cast<std::size_t>(header[4])));
+    const unsigned char *cities = data + PACKET_HEADER_BYTES;
+    for (auto &route : packet.routes) {
+        for (int &city : route) {
+            std::int32_t value;
+            std::memcpy(&value, cities, sizeof(value));
+            city = value;
+            cities += sizeof(value);
+        }
+    }
+}
+
+/**
+ * @brief Read one packet from a blocking socket, failing on a closed socket or a malformed header.
+ */
+bool readPacket(int fd, MigrantPacket &packet) {
+    std::vector<unsigned char> data(PACKET_HEADER_BYTES);
+    if (!readAll(fd, data.data(), data.size())) {
+        return false;
+    }
+    std::optional<std::size_t> routeBytes = packetRouteBytes(data.data());
+    if (!routeBytes) {
+        return false;
+    }
+    data.resize(PACKET_HEADER_BYTES + *routeBytes);
+    if (!readAll(fd, data.data() + PACKET_HEADER_BYTES, *routeBytes)) {
+        return false;
+    }
+    decodePacket(data.data(), packet);
+    return true;
+}
+
+}
+
+/**
+ * @brief Create a fresh mailbox; a stale object of the same name is replaced.
+ *
+ * The creating process owns the object and unlinks it on destruction.
+ *
+ * @param name The shared-memory object name, starting with '/'.
+ * @param numWorkers The number of worker slots.
+ * @param numCities The number of cities in every route.
+ * @param numMigrants The most routes a packet can carry.
+ * @throws std::runtime_error if the object cannot be created or mapped.
+ */
+SharedMemoryMailbox::SharedMemoryMailbox(const std::string &name, int numWorkers, int numCities, int numMigrants)
+    : name(name), owner(true), numWorkers(numWorkers), numCities(numCities), numMigrants(numMigrants) {
+    ::shm_unlink(name.c_str());
+    int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create shared-memory mailbox " + name);
+    }
+    slotBytes = roundToCacheLine(SLOT_ROUTES_OFFSET + static_cast<std::size_t>(numMigrants) * numCities * sizeof(std::int32_t));
+    std::size_t bytes = MAILBOX_HEADER_BYTES + static_cast<std::size_t>(numWorkers) * slotBytes;
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw std::runtime_error("Cannot size shared-memory mailbox " + name);
+    }
+    map(fd, bytes);
+
+    std::memcpy(base, MAILBOX_MAGIC, sizeof(MAILBOX_MAGIC));
+    std::uint32_t shape[3] = {static_cast<std::uint32_t>(numWorkers), static_cast<std::uint32_t>(numCities),
+                              static_cast<std::uint32_t>(numMigrants)};
+    std::memcpy(base + sizeof(MAILBOX_MAGIC), shape, sizeof(shape));
+}
+
+/**
+ * @brief Open a mailbox created by another process.
+ *
+ * @param name The shared-memory object name used by the creator.
+ * @throws std::runtime_error if the object does not exist or is not a mailbox.
+ */
+SharedMemoryMailbox::SharedMemoryMailbox(const std::string &name) : name(name) {
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open shared-memory mailbox " + name);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < MAILBOX_HEADER_BYTES) {
+        ::close(fd);
+        throw std::runtime_error("Shared-memory mailbox is too small: " + name);
+    }
+    map(fd, static_cast<std::size_t>(info.st_size));
+
+    std::uint32_t shape[3];
+    std::memcpy(shape, base + sizeof(MAILBOX_MAGIC), sizeof(shape));
+    numWorkers = static_cast<int>(shape[0]);
+    numCities = static_cast<int>(shape[1]);
+    numMigrants = static_cast<int>(shape[2]);
+    slotBytes = roundToCacheLine(SLOT_ROUTES_OFFSET + static_cast<std::size_t>(numMigrants) * numCities * sizeof(std::int32_t));
+    if (std::memcmp(base, MAILBOX_MAGIC, sizeof(MAILBOX_MAGIC)) != 0 ||
+        mappedBytes < MAILBOX_HEADER_BYTES + static_cast<std::size_t>(numWorkers) * slotBytes) {
+        ::munmap(base, mappedBytes);
+        throw std::runtime_error("Not a migration mailbox: " + name);
+    }
+}
+
+SharedMemoryMailbox::~SharedMemoryMailbox() {
+    if (base) {
+        ::munmap(base, mappedBytes);
+    }
+    if (owner) {
+        ::shm_unlink(name.c_str());
+    }
+}
+
+void SharedMemoryMailbox::map(int fd, std::size_t bytes) {
+    void *address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map shared-memory mailbox " + name);
+    }
+    base = static_cast<unsigned char *>(address);
+    mappedBytes = bytes;
+}
+
+unsigned char *SharedMemoryMailbox::slot(int worker) const {
+    if (worker < 0 || worker >= numWorkers) {
+        throw std::out_of_range("Mailbox worker index out of range");
+    }
+    return base + MAILBOX_HEADER_BYTES + static_cast<std::size_t>(worker) * slotBytes;
+}
+
+/**
+ * @brief Overwrite the publishing worker's slot. Only that worker may call this.
+ *
+ * Routes beyond the mailbox's numMigrants are dropped. The sequence is forced odd while
+ * writing and even afterwards, so a slot left odd by a crashed writer does not invert
+ * the meaning of later writes.
+ *
+ * @throws std::invalid_argument if a route that would be stored does not have numCities cities.
+ */
+void SharedMemoryMailbox::publish(const MigrantPacket &packet) {
+    unsigned char *s = slot(packet.worker);
+    int numRoutes = std::min(static_cast<int>(packet.routes.size()), numMigrants);
+    for (int r = 0; r < numRoutes; r++) {
+        if (static_cast<int>(packet.routes[r].size()) != numCities) {
+            throw std::invalid_argument("SharedMemoryMailbox: every route must have numCities cities");
+        }
+    }
+    auto sequence = field<std::uint64_t>(s, 0);
+    std::uint64_t writing = sequence.load(std::memory_order_relaxed) | 1;
+    sequence.store(writing, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    field<std::int32_t>(s, 8).store(packet.epoch, std::memory_order_relaxed);
+    field<std::int32_t>(s, 12).store(packet.finished ? 1 : 0, std::memory_order_relaxed);
+    field<std::int32_t>(s, 16).store(numRoutes, std::memory_order_relaxed);
+    field<double>(s, 24).store(packet.bestFitness, std::memory_order_relaxed);
+    for (int r = 0; r < numRoutes; r++) {
+        for (int c = 0; c < numCities; c++) {
+            std::size_t offset = SLOT_ROUTES_OFFSET + (static_cast<std::size_t>(r) * numCities + c) * sizeof(std::int32_t);
+            field<std::int32_t>(s, offset).store(packet.routes[r][c], std::memory_order_relaxed);
+        }
+    }
+
+    sequence.store(writing + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Copy a consistent snapshot of a worker's latest packet.
+ *
+ * A slot that stays mid-write for MAX_FETCH_RETRIES attempts, for example because its
+ * worker died while publishing, is treated as empty.
+ *
+ * @return false if the worker has not published yet or no consistent snapshot was read.
+ */
+bool SharedMemoryMailbox::fetch(int worker, MigrantPacket &packet) {
+    unsigned char *s = slot(worker);
+    auto sequence = field<std::uint64_t>(s, 0);
+    for (int attempt = 0; attempt < MAX_FETCH_RETRIES; attempt++) {
+        std::uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false;
+        }
+        if (before % 2 == 0) {
+            packet.worker = worker;
+            packet.epoch = field<std::int32_t>(s, 8).load(std::memory_order_relaxed);
+            packet.finished = field<std::int32_t>(s, 12).load(std::memory_order_relaxed) != 0;
+            int numRoutes = std::clamp(field<std::int32_t>(s, 16).load(std::memory_order_relaxed), 0, numMigrants);
+            packet.bestFitness = field<double>(s, 24).load(std::memory_order_relaxed);
+            packet.routes.assign(numRoutes, std::vector<int>(numCities));
+            for (int r = 0; r < numRoutes; r++) {
+                for (int c = 0; c < numCities; c++) {
+                    std::size_t offset = SLOT_ROUTES_OFFSET + (static_cast<std::size_t>(r) * numCities + c) * sizeof(std::int32_t);
+                    packet.routes[r][c] = field<std::int32_t>(s, offset).load(std::memory_order_relaxed);
+                }
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                return true;
+            }
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+/**
+ * @brief Make a dead worker's slot readable again before it is relaunched.
+ *
+ * A worker that died mid-publish leaves its slot odd and half written. That packet is
+ * discarded by resetting the slot to unpublished; a complete packet is kept, so a
+ * restarted worker can resume from it. Call only while the worker is not running.
+ *
+ * @param worker The dead worker's index.
+ */
+void SharedMemoryMailbox::recover(int worker) {
+    auto sequence = field<std::uint64_t>(slot(worker), 0);
+    if (sequence.load(std::memory_order_acquire) % 2 != 0) {
+        sequence.store(0, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Bind the socket and start serving connections on a background thread.
+ *
+ * @param path The filesystem path of the Unix socket; a stale socket file is replaced.
+ * @param numWorkers The number of worker slots.
+ * @param numCities The number of cities in every route.
+ * @param numMigrants The most routes a packet can carry.
+ * @throws std::runtime_error if the socket cannot be bound.
+ */
+SocketRelay::SocketRelay(const std::string &path, int numWorkers, int numCities, int numMigrants)
+    : path(path), numCities(numCities), numMigrants(numMigrants), latest(numWorkers) {
+    sockaddr_un address = socketAddress(path);
+    ::unlink(path.c_str());
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, 64) != 0) {
+        if (listenFd >= 0) {
+            ::close(listenFd);
+        }
+        throw std::runtime_error("Cannot listen on socket " + path);
+    }
+    server = std::thread([this]() { serve(); });
+}
+
+SocketRelay::~SocketRelay() {
+    stopping.store(true);
+    server.join();
+    ::close(listenFd);
+    ::unlink(path.c_str());
+}
+
+/**
+ * @brief Accept workers and answer their publish and fetch requests until stopped.
+ *
+ * A request is a type byte followed by a packet (publish) or an i32 worker index
+ * (fetch). A publish is acknowledged with one byte once stored, so a worker's later
+ * fetches see it. A fetch is answered with a found byte and, if found, the packet.
+ * Every connection is polled and read without blocking, and requests are handled once
+ * they have fully arrived, so a worker that stalls mid-request holds up no one else.
+ * A connection that closes, for example because its worker crashed, or that sends a
+ * request that cannot be framed is dropped.
+ */
+void SocketRelay::serve() {
+    std::vector<Connection> connections;
+    std::vector<pollfd> fds;
+    while (!stopping.load()) {
+        fds.assign(1, {listenFd, POLLIN, 0});
+        for (const Connection &connection : connections) {
+            fds.push_back({connection.fd, static_cast<short>(POLLIN | (connection.out.empty() ? 0 : POLLOUT)), 0});
+        }
+        if (::poll(fds.data(), fds.size(), 50) <= 0) {
+            continue;
+        }
+        std::size_t polled = connections.size();
+        if (fds[0].revents & POLLIN) {
+            int client = ::accept(listenFd, nullptr, nullptr);
+            if (client >= 0) {
+                connections.push_back({client, {}, {}});
+            }
+        }
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < connections.size(); i++) {
+            Connection &connection = connections[i];
+            bool open = true;
+            if (i < polled && (fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR))) {
+                open = receive(connection);
+                std::size_t consumed;
+                while (open && (consumed = handleRequest(connection)) != 0) {
+                    if (consumed == MALFORMED_REQUEST) {
+                        open = false;
+                    } else {
+                        connection.in.erase(connection.in.begin(), connection.in.begin() + static_cast<std::ptrdiff_t>(consumed));
+                    }
+                }
+            }
+            open = open && flush(connection);
+            if (open) {
+                connections[kept++] = std::move(connection);
+            } else {
+                ::close(connection.fd);
+            }
+        }
+        connections.resize(kept);
+    }
+    for (const Connection &connection : connections) {
+        ::close(connection.fd);
+    }
+}
+
+/**
+ * @brief Append whatever a connection has sent to its input without blocking.
+ *
+ * @return false if the peer has closed the connection.
+ */
+bool SocketRelay::receive(Connection &connection) {
+    unsigned char chunk[4096];
+    while (true) {
+        ssize_t n = ::recv(connection.fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (n > 0) {
+            connection.in.insert(connection.in.end(), chunk, chunk + n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+}
+
+/**
+ * @brief Send as much of a connection's pending replies as the socket takes without blocking.
+ *
+ * @return false if the connection has failed.
+ */
+bool SocketRelay::flush(Connection &connection) {
+    std::size_t sent = 0;
+    while (sent < connection.out.size()) {
+        ssize_t n = ::send(connection.fd, connection.out.data() + sent, connection.out.size() - sent,
+                           MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    connection.out.erase(connection.out.begin(), connection.out.begin() + static_cast<std::ptrdiff_t>(sent));
+    return true;
+}
+
+/**
+ * @brief Answer the first request in a connection's input if all of it has arrived.
+ *
+ * A published packet whose worker, route count or route length does not fit the relay
+ * is acknowledged but not stored.
+ *
+ * @return std::size_t The bytes the request took, 0 if it is still incomplete, or
+ *         MALFORMED_REQUEST if it cannot be framed.
+ */
+std::size_t SocketRelay::handleRequest(Connection &connection) {
+    const std::vector<unsigned char> &in = connection.in;
+    if (in.empty()) {
+        return 0;
+    }
+    if (in[0] == REQUEST_PUBLISH) {
+        if (in.size() < 1 + PACKET_HEADER_BYTES) {
+            return 0;
+        }
+        std::optional<std::size_t> routeBytes = packetRouteBytes(in.data() + 1);
+        if (!routeBytes) {
+            return MALFORMED_REQUEST;
+        }
+        std::size_t requestBytes = 1 + PACKET_HEADER_BYTES + *routeBytes;
+        if (in.size() < requestBytes) {
+            return 0;
+        }
+        MigrantPacket packet;
+        decodePacket(in.data() + 1, packet);
+        int numRoutes = static_cast<int>(packet.routes.size());
+        bool fits = packet.worker >= 0 && packet.worker < static_cast<int>(latest.size()) && numRoutes <= numMigrants &&
+                    (numRoutes == 0 || static_cast<int>(packet.routes.front().size()) == numCities);
+        if (fits) {
+            publish(packet);
+        }
+        connection.out.push_back(1);
+        return requestBytes;
+    }
+    if (in[0] == REQUEST_FETCH) {
+        if (in.size() < 1 + sizeof(std::int32_t)) {
+            return 0;
+        }
+        std::int32_t worker;
+        std::memcpy(&worker, in.data() + 1, sizeof(worker));
+        MigrantPacket packet;
+        bool found = worker >= 0 && worker < static_cast<int>(latest.size()) && fetch(worker, packet);
+        connection.out.push_back(found ? 1 : 0);
+        if (found) {
+            encodePacket(connection.out, packet);
+        }
+        return 1 + sizeof(std::int32_t);
+    }
+    return MALFORMED_REQUEST;
+}
+
+void SocketRelay::publish(const MigrantPacket &packet) {
+    std::lock_guard<std::mutex> lock(latestMutex);
+    latest.at(packet.worker) = packet;
+}
+
+bool SocketRelay::fetch(int worker, MigrantPacket &packet) {
+    std::lock_guard<std::mutex> lock(latestMutex);
+    if (!latest.at(worker)) {
+        return false;
+    }
+    packet = *latest[worker];
+    return true;
+}
+
+/**
+ * @brief Connect to a relay, retrying while it starts up.
+ *
+ * @param path The relay's socket path.
+ * @param connectTimeoutMs How long to keep retrying.
+ * @throws std::runtime_error if no connection could be made in time.
+ */
+SocketTransport::SocketTransport(const std::string &path, int connectTimeoutMs) {
+    sockaddr_un address = socketAddress(path);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(connectTimeoutMs);
+    while (true) {
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0) {
+            return;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            throw std::runtime_error("Cannot connect to migration relay " + path);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+SocketTransport::~SocketTransport() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+/**
+ * @throws std::runtime_error if the relay has gone away.
+ */
+void SocketTransport::publish(const MigrantPacket &packet) {
+    std::vector<unsigned char> request = {REQUEST_PUBLISH};
+    encodePacket(request, packet);
+    unsigned char ack;
+    if (!writeAll(fd, request.data(), request.size()) || !readAll(fd, &ack, 1)) {
+        throw std::runtime_error("Migration relay closed the connection");
+    }
+}
+
+/**
+ * @throws std::runtime_error if the relay has gone away.
+ */
+bool SocketTransport::fetch(int worker, MigrantPacket &packet) {
+    std::vector<unsigned char> request = {REQUEST_FETCH};
+    put<std::int32_t>(request, worker);
+    unsigned char found;
+    if (!writeAll(fd, request.data(), request.size()) || !readAll(fd, &found, 1) ||
+        (found && !readPacket(fd, packet))) {
+        throw std::runtime_error("Migration relay closed the connection");
+    }
+    return found != 0;
+}
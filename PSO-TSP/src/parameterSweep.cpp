@@ -0,0 +1,226 @@
+#include "psoDefinition.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief One point of a run's quality-vs-time curve.
+ */
+struct CurvePoint {
+    int iteration;
+    double elapsedMs;
+    double bestDistance;
+};
+
+/**
+ * @brief One solve of the sweep: a grid setting, a repeat and the seed it runs with.
+ */
+struct SweepRun {
+    int setting;
+    int repeat;
+    std::uint64_t seed;
+    std::vector<CurvePoint> curve;
+    StopReason stopReason = StopReason::MaxIterations;
+};
+
+/**
+ * @brief Split a `--name=a,b,c` argument into `--name=a`, `--name=b`, `--name=c`.
+ */
+std::vector<std::string> expandList(const std::string &argument) {
+    std::size_t equals = argument.find('=');
+    std::string prefix = argument.substr(0, equals + 1);
+    std::vector<std::string> values;
+    std::stringstream list(argument.substr(equals + 1));
+    std::string value;
+    while (std::getline(list, value, ',')) {
+        values.push_back(prefix + value);
+    }
+    return values;
+}
+
+/**
+ * @brief Build every combination of the given parameter lists.
+ */
+std::vector<PSOConfig> expandGrid(const std::vector<std::vector<std::string>> &axes) {
+    std::vector<PSOConfig> grid(1);
+    for (const auto &axis : axes) {
+        std::vector<PSOConfig> next;
+        for (const PSOConfig &base : grid) {
+            for (const std::string &argument : axis) {
+                PSOConfig config = base;
+                parseConfigArgument(config, argument);
+                config.validate();
+                next.push_back(config);
+            }
+        }
+        grid = std::move(next);
+    }
+    return grid;
+}
+
+/**
+ * @brief Solve one instance on the calling thread, sampling the global best at checkpoints.
+ *
+ * The run goes through runPSO, so the time budget, stall and target stop rules apply.
+ * The improvement callback records the first new best at or past each checkpoint, and
+ * the final best is recorded when the run stops. The clock starts after the distance
+ * matrix is built, so the curves compare the solver settings rather than the instance
+ * setup.
+ */
+void runOne(const PSOConfig &config, SweepRun &run, int checkpoints) {
+    using Clock = std::chrono::steady_clock;
+
+    PSO algo(config);
+    algo.setSeed(run.seed);
+    algo.setExecutionMode(ExecutionMode::Serial);
+    algo.setTraceSampling(TraceSampling::Off);
+    algo.generateCityCoordinates(config.numCities);
+    algo.initializeDistanceMatrix();
+
+    auto start = Clock::now();
+    auto elapsedMs = [&]() {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+    algo.initializeParticles(config.numParticles, config.numCities);
+    run.curve.push_back({0, elapsedMs(), algo.getGlobalBestFitness()});
+
+    int step = std::max(1, config.maxIterations / std::max(1, checkpoints));
+    int nextCheckpoint = step;
+    algo.setImprovementCallback([&](const BestImprovement &improvement) {
+        if (improvement.iteration >= nextCheckpoint) {
+            run.curve.push_back({improvement.iteration, elapsedMs(), improvement.fitness});
+            nextCheckpoint = (improvement.iteration / step + 1) * step;
+        }
+    });
+    std::ofstream discard;
+    run.stopReason = algo.runPSO(discard, config.numCities);
+    run.curve.push_back({algo.getIterationsRun(), elapsedMs(), algo.getGlobalBestFitness()});
+}
+
+}
+
+/**
+ * @brief Run a grid of PSO configurations concurrently and report quality against time.
+ *
+ * Usage: pso_sweep [--particles=4,16,64] [--iterations=100,1000] [--cities=40,200]
+ *                  [--inertia=..] [--cognitive=..] [--social=..] [--time-budget-ms=..]
+ *                  [--stall=..] [--target=..] [--target-gap=..] [--repeats=R]
+ *                  [--seed=S] [--jobs=N] [--checkpoints=K] [--out=sweep.csv]
+ *
+ * Every comma-separated parameter list is one axis of the grid; parameters that are not
+ * given keep their ObjectiveFunction.hpp defaults. Each setting is solved `--repeats`
+ * times with seeds S, S+1, ..., so all settings see the same instances. Runs are
+ * single-threaded and spread over `--jobs` cores (all cores by default). Every run's
+ * curve of best distance against elapsed time, sampled at about K points, is written
+ * to the CSV file with the reason the run stopped, and a per-setting summary is printed.
+ *
+ * @return int Returns 0 on success and 1 on a usage error.
+ */
+int main(int argc, char *argv[]) {
+    std::vector<std::vector<std::string>> axes;
+    int repeats = 3;
+    std::uint64_t seed = 1;
+    int jobs = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int checkpoints = 20;
+    std::string outPath = "sweep.csv";
+
+    std::vector<PSOConfig> grid;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            PSOConfig probe;
+            if (argument.rfind("--repeats=", 0) == 0) {
+                repeats = std::stoi(argument.substr(10));
+            } else if (argument.rfind("--seed=", 0) == 0) {
+                seed = std::stoull(argument.substr(7));
+            } else if (argument.rfind("--jobs=", 0) == 0) {
+                jobs = std::stoi(argument.substr(7));
+            } else if (argument.rfind("--checkpoints=", 0) == 0) {
+                checkpoints = std::stoi(argument.substr(14));
+            } else if (argument.rfind("--out=", 0) == 0) {
+                outPath = argument.substr(6);
+            } else if (parseConfigArgument(probe, expandList(argument).front())) {
+                axes.push_back(expandList(argument));
+            } else {
+                throw std::invalid_argument("unknown argument " + argument);
+            }
+        }
+        if (repeats < 1) {
+            throw std::invalid_argument("--repeats must be at least 1");
+        }
+        if (jobs < 1) {
+            throw std::invalid_argument("--jobs must be at least 1");
+        }
+        grid = expandGrid(axes);
+    } catch (const std::exception &error) {
+        std::cerr << "pso_sweep: " << error.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<SweepRun> runs;
+    for (int setting = 0; setting < static_cast<int>(grid.size()); setting++) {
+        for (int repeat = 0; repeat < repeats; repeat++) {
+            runs.push_back(SweepRun{setting, repeat, seed + repeat, {}});
+        }
+    }
+    std::cout << grid.size() << " settings x " << repeats << " repeats on " << jobs << " threads" << std::endl;
+
+    if (jobs == 1) {
+        for (SweepRun &run : runs) {
+            runOne(grid[run.setting], run, checkpoints);
+        }
+    } else {
+        // The thread calling parallelFor works too, so the pool gets one worker fewer.
+        ThreadPool pool(jobs - 1);
+        pool.parallelFor(static_cast<int>(runs.size()), [&](int r) {
+            runOne(grid[runs[r].setting], runs[r], checkpoints);
+        });
+    }
+
+    std::ofstream outFile(outPath);
+    outFile << "Setting,Particles,Iterations,Cities,Inertia,Cognitive,Social,TimeBudgetMs,Stall,Target,TargetGap,"
+               "Repeat,Seed,StopReason,Iteration,ElapsedMs,BestDistance\n";
+    for (const SweepRun &run : runs) {
+        const PSOConfig &config = grid[run.setting];
+        for (const CurvePoint &point : run.curve) {
+            outFile << run.setting << "," << config.numParticles << "," << config.maxIterations << ","
+                    << config.numCities << "," << config.inertiaWeight << "," << config.cognitiveWeight << ","
+                    << config.socialWeight << "," << config.timeBudgetMs << "," << config.stallIterations << ","
+                    << config.targetDistance << "," << config.targetGap << "," << run.repeat << "," << run.seed << ","
+                    << stopReasonName(run.stopReason) << "," << point.iteration << "," << point.elapsedMs << ","
+                    << point.bestDistance << "\n";
+        }
+    }
+
+    std::cout << std::left << std::setw(8) << "Setting" << std::right << std::setw(10) << "Particles"
+              << std::setw(11) << "Iterations" << std::setw(8) << "Cities" << std::setw(9) << "Inertia"
+              << std::setw(10) << "Cognitive" << std::setw(8) << "Social" << std::setw(12) << "Mean best"
+              << std::setw(12) << "Min best" << std::setw(11) << "Mean ms" << std::endl;
+    std::cout << std::fixed;
+    for (int setting = 0; setting < static_cast<int>(grid.size()); setting++) {
+        const PSOConfig &config = grid[setting];
+        double bestSum = 0.0, bestMin = std::numeric_limits<double>::max(), msSum = 0.0;
+        for (const SweepRun &run : runs) {
+            if (run.setting == setting) {
+                bestSum += run.curve.back().bestDistance;
+                bestMin = std::min(bestMin, run.curve.back().bestDistance);
+                msSum += run.curve.back().elapsedMs;
+            }
+        }
+        std::cout << std::left << std::setw(8) << setting << std::right << std::setw(10) << config.numParticles
+                  << std::setw(11) << config.maxIterations << std::setw(8) << config.numCities
+                  << std::setprecision(3) << std::setw(9) << config.inertiaWeight
+                  << std::setw(10) << config.cognitiveWeight << std::setw(8) << config.socialWeight
+                  << std::setw(12) << bestSum / repeats << std::setw(12) << bestMin
+                  << std::setprecision(2) << std::setw(11) << msSum / repeats << std::endl;
+    }
+    std::cout << "Curves written to " << outPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file profilerImplementation.cpp
+ * @brief Implementation of the per-thread solver profiler.
+ */
+
+#include "profilerDefinition.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+
+constexpr const char *PHASE_NAMES[] = {
+    "RandomDraws", "Velocity", "Swaps", "Validation", "Fitness", "LocalSearch", "GlobalBest",
+    "LockWait", "Trace", "Snapshot", "Resync", "TraceDrain"
+};
+static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == Profiler::PHASE_COUNT);
+
+constexpr const char *COUNTER_NAMES[] = {
+    "InvalidRoutes", "PersonalBestImprovements", "GlobalBestImprovements"
+};
+static_assert(sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == Profiler::COUNTER_COUNT);
+
+}
+
+const char *profilePhaseName(ProfilePhase phase) {
+    return PHASE_NAMES[static_cast<std::size_t>(phase)];
+}
+
+const char *profileCounterName(ProfileCounter counter) {
+    return COUNTER_NAMES[static_cast<std::size_t>(counter)];
+}
+
+/**
+ * @brief Discard all recorded data and size the profiler for a new run. Not thread-safe.
+ *
+ * @param numSlots The number of threads that will record, one slot each.
+ * @param maxEventsPerSlot How many timeline events each slot keeps for the Chrome trace.
+ */
+void Profiler::reset(int numSlots, std::size_t maxEventsPerSlot) {
+    this->numSlots = numSlots;
+    this->maxEventsPerSlot = maxEventsPerSlot;
+    slots = std::make_unique<Slot[]>(numSlots);
+    origin = Clock::now();
+}
+
+/**
+ * @brief Add one completed phase to a slot.
+ *
+ * @param slot The recording thread's slot.
+ * @param phase The phase that ran.
+ * @param startNanos When it started, from now().
+ * @param endNanos When it ended, from now().
+ */
+void Profiler::record(int slot, ProfilePhase phase, std::int64_t startNanos, std::int64_t endNanos) {
+    Slot &s = slots[slot];
+    std::size_t index = static_cast<std::size_t>(phase);
+    s.nanos[index] += endNanos - startNanos;
+    s.calls[index]++;
+    if (s.events.size() < maxEventsPerSlot) {
+        s.events.push_back(Event{startNanos, endNanos - startNanos, phase});
+    } else {
+        s.droppedEvents++;
+    }
+}
+
+/**
+ * @brief Whether anything was recorded since the last reset.
+ */
+bool Profiler::empty() const {
+    for (int i = 0; i < numSlots; i++) {
+        for (std::int64_t calls : slots[i].calls) {
+            if (calls != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Total time spent in a phase, summed over all threads.
+ */
+std::int64_t Profiler::getNanos(ProfilePhase phase) const {
+    std::int64_t total = 0;
+    for (int i = 0; i < numSlots; i++) {
+        total += slots[i].nanos[static_cast<std::size_t>(phase)];
+    }
+    return total;
+}
+
+/**
+ * @brief Number of times a phase ran, summed over all threads.
+ */
+std::int64_t Profiler::getCalls(ProfilePhase phase) const {
+    std::int64_t total = 0;
+    for (int i = 0; i < numSlots; i++) {
+        total += slots[i].calls[static_cast<std::size_t>(phase)];
+    }
+    return total;
+}
+
+/**
+ * @brief Value of a counter, summed over all threads.
+ */
+std::int64_t Profiler::getCount(ProfileCounter counter) const {
+    std::int64_t total = 0;
+    for (int i = 0; i < numSlots; i++) {
+        total += slots[i].counters[static_cast<std::size_t>(counter)];
+    }
+    return total;
+}
+
+/**
+ * @brief Number of timeline events kept across all slots.
+ */
+std::size_t Profiler::getEventCount() const {
+    std::size_t total = 0;
+    for (int i = 0; i < numSlots; i++) {
+        total += slots[i].events.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Write the timeline as Chrome trace event JSON.
+ *
+ * Every slot becomes one thread row; phases are complete ("X") events with
+ * microsecond timestamps. Counter totals are attached as a final counter event.
+ *
+ * @param out The stream to write to.
+ */
+void Profiler::writeChromeTrace(std::ostream &out) const {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    std::int64_t lastNanos = 0;
+    for (int i = 0; i < numSlots; i++) {
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i
+            << ",\"args\":{\"name\":\"slot " << i << "\"}}";
+        first = false;
+        for (const Event &event : slots[i].events) {
+            out << ",\n{\"name\":\"" << profilePhaseName(event.phase) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << i
+                << ",\"ts\":" << event.startNanos / 1000.0 << ",\"dur\":" << event.durationNanos / 1000.0 << "}";
+            lastNanos = std::max(lastNanos, event.startNanos + event.durationNanos);
+        }
+    }
+    out << (first ? "" : ",") << "\n{\"name\":\"counters\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":" << lastNanos / 1000.0
+        << ",\"args\":{";
+    for (std::size_t c = 0; c < COUNTER_COUNT; c++) {
+        out << (c ? "," : "") << "\"" << COUNTER_NAMES[c] << "\":" << getCount(static_cast<ProfileCounter>(c));
+    }
+    out << "}}\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+/**
+ * @brief Write a per-phase table and the counter totals.
+ *
+ * Times are summed over all threads, so the share column is the fraction of the
+ * total measured thread time rather than of wall time.
+ *
+ * @param out The stream to write to.
+ */
+void Profiler::writeSummary(std::ostream &out) const {
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    std::int64_t totalNanos = 0;
+    for (std::size_t p = 0; p < PHASE_COUNT; p++) {
+        totalNanos += getNanos(static_cast<ProfilePhase>(p));
+    }
+
+    out << std::left << std::setw(14) << "Phase" << std::right << std::setw(12) << "Total ms"
+        << std::setw(12) << "Calls" << std::setw(12) << "Mean ns" << std::setw(9) << "Share" << "\n";
+    for (std::size_t p = 0; p < PHASE_COUNT; p++) {
+        ProfilePhase phase = static_cast<ProfilePhase>(p);
+        std::int64_t nanos = getNanos(phase);
+        std::int64_t calls = getCalls(phase);
+        if (calls == 0) {
+            continue;
+        }
+        out << std::left << std::setw(14) << PHASE_NAMES[p] << std::right << std::fixed
+            << std::setprecision(3) << std::setw(12) << nanos / 1e6
+            << std::setw(12) << calls
+            << std::setprecision(0) << std::setw(12) << static_cast<double>(nanos) / calls
+            << std::setprecision(1) << std::setw(8) << (totalNanos ? 100.0 * nanos / totalNanos : 0.0) << "%\n";
+    }
+    for (std::size_t c = 0; c < COUNTER_COUNT; c++) {
+        out << std::left << std::setw(26) << COUNTER_NAMES[c] << std::right << std::setw(12)
+            << getCount(static_cast<ProfileCounter>(c)) << "\n";
+    }
+    std::int64_t dropped = 0;
+    for (int i = 0; i < numSlots; i++) {
+        dropped += slots[i].droppedEvents;
+    }
+    if (dropped > 0) {
+        out << std::left << std::setw(26) << "DroppedTimelineEvents" << std::right << std::setw(12) << dropped << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
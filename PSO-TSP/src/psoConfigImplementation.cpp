@@ -0,0 +1,100 @@
+/**
+ * @file psoConfigImplementation.cpp
+ * @brief Validation and command-line parsing of PSOConfig.
+ */
+
+#include "psoConfigDefinition.hpp"
+#include <stdexcept>
+
+/**
+ * @brief Check that the parameters describe a solvable run.
+ *
+ * @throws std::invalid_argument if a count is out of range or a weight or stopping rule is negative.
+ */
+void PSOConfig::validate() const {
+    if (numParticles < 1) {
+        throw std::invalid_argument("PSOConfig: numParticles must be at least 1");
+    }
+    if (maxIterations < 0) {
+        throw std::invalid_argument("PSOConfig: maxIterations must not be negative");
+    }
+    if (numCities < 2) {
+        throw std::invalid_argument("PSOConfig: numCities must be at least 2");
+    }
+    if (inertiaWeight < 0.0 || cognitiveWeight < 0.0 || socialWeight < 0.0) {
+        throw std::invalid_argument("PSOConfig: weights must not be negative");
+    }
+    if (timeBudgetMs < 0.0 || stallIterations < 0 || targetDistance < 0.0 || targetGap < 0.0) {
+        throw std::invalid_argument("PSOConfig: stopping rules must not be negative");
+    }
+    if (fitnessResync < 0) {
+        throw std::invalid_argument("PSOConfig: fitnessResync must not be negative");
+    }
+    if (neighbourCount < 1) {
+        throw std::invalid_argument("PSOConfig: neighbourCount must be at least 1");
+    }
+}
+
+/**
+ * @brief Apply one `--name=value` command-line argument to a config.
+ *
+ * Recognised names are particles, iterations, cities, inertia, cognitive, social,
+ * time-budget-ms, stall, target, target-gap, memetic (off, personal, global or both),
+ * neighbours and resync.
+ *
+ * @param config The config to update.
+ * @param argument The argument as given on the command line.
+ * @return true if the argument named a config parameter, false if it is not a config argument.
+ * @throws std::invalid_argument if the value cannot be parsed.
+ */
+bool parseConfigArgument(PSOConfig &config, const std::string &argument) {
+    auto valueOf = [&](const std::string &prefix, std::string &value) {
+        if (argument.rfind(prefix, 0) != 0) {
+            return false;
+        }
+        value = argument.substr(prefix.size());
+        return true;
+    };
+
+    std::string value;
+    if (valueOf("--particles=", value)) {
+        config.numParticles = std::stoi(value);
+    } else if (valueOf("--iterations=", value)) {
+        config.maxIterations = std::stoi(value);
+    } else if (valueOf("--cities=", value)) {
+        config.numCities = std::stoi(value);
+    } else if (valueOf("--inertia=", value)) {
+        config.inertiaWeight = std::stod(value);
+    } else if (valueOf("--cognitive=", value)) {
+        config.cognitiveWeight = std::stod(value);
+    } else if (valueOf("--social=", value)) {
+        config.socialWeight = std::stod(value);
+    } else if (valueOf("--time-budget-ms=", value)) {
+        config.timeBudgetMs = std::stod(value);
+    } else if (valueOf("--stall=", value)) {
+        config.stallIterations = std::stoi(value);
+    } else if (valueOf("--target=", value)) {
+        config.targetDistance = std::stod(value);
+    } else if (valueOf("--target-gap=", value)) {
+        config.targetGap = std::stod(value);
+    } else if (valueOf("--memetic=", value)) {
+        if (value == "off") {
+            config.memeticMode = MemeticMode::Off;
+        } else if (value == "personal") {
+            config.memeticMode = MemeticMode::PersonalBest;
+        } else if (value == "global") {
+            config.memeticMode = MemeticMode::GlobalBest;
+        } else if (value == "both") {
+            config.memeticMode = MemeticMode::Both;
+        } else {
+            throw std::invalid_argument("unknown memetic mode " + value);
+        }
+    } else if (valueOf("--neighbours=", value)) {
+        config.neighbourCount = std::stoi(value);
+    } else if (valueOf("--resync=", value)) {
+        config.fitnessResync = std::stoi(value);
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -4,7 +4,9 @@
  */
 
 #include "psoDefinition.hpp"
-#include "utils.cpp"
+#include "tourDeltaDefinition.hpp"
+#include "randomDefinition.hpp"
+#include "utils.hpp"
 #include <random>
 #include <numeric>
 #include <algorithm>
@@ -13,46 +15,89 @@
 #include <chrono>
 #include <iomanip>
 #include <cassert>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
 
 /**
  * @brief Generates random coordinates for a given number of cities.
  * 
  * This function initializes the `cityList` with random coordinates for each city.
- * The coordinates are generated within predefined ranges for x, y, and z.
+ * The coordinates are generated within predefined ranges for x, y, and z, from the
+ * city stream of the run's seed.
  * 
  * @param numCities The number of cities to generate coordinates for.
  */
 void PSO::generateCityCoordinates(int numCities) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> xDist(-1.0, 1.0);
-    std::uniform_real_distribution<> yDist(-1.5, 2.0);
-    std::uniform_real_distribution<> zDist(0.0, 1.8);
+    PhiloxStream stream(seed, RandomDomain::Cities, 0);
+    instanceDistances.reset();
+    cacheMetric = SolutionCache::EUCLIDEAN_METRIC;
 
     this->cityList.resize(numCities);
 
     for (int i = 0; i < numCities; i++) {
+        double x = -1.0 + 2.0 * stream.uniform();
+        double y = -1.5 + 3.5 * stream.uniform();
+        double z = 1.8 * stream.uniform();
         this->cityList[i] = std::make_shared<City>(i);
-        this->cityList[i]->setCoordinates(xDist(gen), yDist(gen), zDist(gen));
+        this->cityList[i]->setCoordinates(x, y, z);
     }
 }
 
+/**
+ * @brief Uses a loaded instance's cities instead of generated ones.
+ * 
+ * If the instance has its own distance table, as TSPLIB instances do, the next
+ * `initializeDistanceMatrix` stores that table rather than computing Euclidean
+ * distances. A known optimum is kept for the optimality gap in `printResults`.
+ * 
+ * @param instance The instance, from `loadInstance` or one of the format loaders.
+ */
+void PSO::loadInstance(const TSPInstance &instance) {
+    cityList = instance.cityList;
+    instanceDistances = instance.distances;
+    knownOptimum = instance.optimum;
+    cacheMetric = SolutionCache::metricOf(instance);
+}
+
 /**
  * @brief Initializes the distance matrix for all cities.
  * 
- * This function calculates and stores the Euclidean distance between every pair of cities
- * in the `distanceMatrix`. The diagonal elements (distance from a city to itself) are set to 0.
+ * Every pair of cities gets its Euclidean distance, stored in the layout chosen with
+ * `setDistanceStorage`; large instances are built tile by tile on a temporary pool.
+ * `OnDemand` keeps only the coordinates and computes each distance when it is read, so
+ * memory stays linear. `Float32`, `Fixed32` and `Fixed16` use 4, 4 or 2 bytes per entry;
+ * the search runs on those rounded distances and `getExactBestFitness` rescores its
+ * result. An instance loaded with its own table is stored as given, packed if packed
+ * storage was chosen and dense otherwise.
+ * 
+ * A fresh matrix is built each time, so solvers sharing the old one through
+ * `shareInstance` keep it, and the local search's candidate lists are rebuilt when next
+ * needed. Instances of `SmallTourKernel::MIN_CITIES` to `SmallTourKernel::MAX_CITIES`
+ * cities also get a kernel specialised for their size.
  */
 void PSO::initializeDistanceMatrix() {
-    distanceMatrix.resize(cityList.size(), std::vector<double>(cityList.size(), 0.0));
-    int numCities = cityList.size();
-    for (int i = 0; i < numCities; i++) {
-        for (int j = 0; j < numCities; j++) {
-            if (i != j) {
-                distanceMatrix[i][j] = euclideanDistance(this->cityList[i], this->cityList[j]);
-            }
-        }
+    auto matrix = std::make_shared<DistanceMatrix>();
+    if (instanceDistances) {
+        matrix->build(*instanceDistances, static_cast<int>(cityList.size()),
+                      distanceStorage == DistanceMatrix::Storage::PackedUpper ? DistanceMatrix::Storage::PackedUpper
+                                                                              : DistanceMatrix::Storage::Dense);
+        smallKernel = makeSmallTourKernel(*matrix);
+        distanceMatrix = std::move(matrix);
+        neighbourLists.reset();
+        return;
     }
+    bool tiled = distanceStorage != DistanceMatrix::Storage::OnDemand;
+    if (tiled && cityList.size() > DistanceMatrix::TILE_SIZE && numThreads > 1) {
+        ThreadPool pool(numThreads);
+        matrix->build(cityList, distanceStorage, &pool);
+    } else {
+        matrix->build(cityList, distanceStorage);
+    }
+    smallKernel = makeSmallTourKernel(*matrix);
+    distanceMatrix = std::move(matrix);
+    neighbourLists.reset();
 }
 
 /**
@@ -65,17 +110,67 @@ void PSO::initializeDistanceMatrix() {
  * @param numCities The number of cities in the route.
  * @return double The total distance of the route.
  */
-double PSO::calculateDistance(const std::vector<int> &route, int numCities) {
-    double distance = 0.0;
-    for (int i = 0; i < numCities - 1; i++) {
-        int city1 = route[i];
-        int city2 = route[i + 1];
-        distance += distanceMatrix[city1][city2];
+double PSO::calculateDistance(std::span<const int> route, int numCities) {
+    if (fixedSizeKernels && smallKernel && smallKernel->numCities() == numCities) {
+        return smallKernel->tourLength(route);
+    }
+    return distanceMatrix->visit([&](const auto &distances) {
+        double distance = 0.0;
+        for (int i = 0; i < numCities - 1; i++) {
+            distance += distances(route[i], route[i + 1]);
+        }
+        distance += distances(route[numCities - 1], route[0]);
+        return distance;
+    });
+}
+
+/**
+ * @brief Recomputes every particle's fitness from its current route in one batched pass.
+ * 
+ * The routes are scored straight from the swarm arena by `evaluateTours`, in blocks on
+ * the swarm executor when one is running. Personal and global bests are left alone.
+ * 
+ * @param numCities The number of cities in each route.
+ */
+void PSO::evaluateSwarm(int numCities) {
+    constexpr int BLOCK = 64;
+    int numBlocks = (swarm.size() + BLOCK - 1) / BLOCK;
+    std::vector<double> lengths(swarm.size());
+    auto evaluateBlock = [&](int block) {
+        int first = block * BLOCK;
+        int count = std::min(BLOCK, swarm.size() - first);
+        evaluateTours(*distanceMatrix, swarm.getRouteArena() + first * swarm.getRouteStride(), swarm.getRouteStride(),
+                      count, numCities, lengths.data() + first);
+    };
+    if (swarmExecutor && numBlocks > 1) {
+        swarmExecutor->parallelFor(numBlocks, evaluateBlock);
+    } else {
+        for (int block = 0; block < numBlocks; block++) {
+            evaluateBlock(block);
+        }
+    }
+    for (int pIdx = 0; pIdx < swarm.size(); pIdx++) {
+        swarm.getFitness(pIdx) = lengths[pIdx];
+    }
+}
+
+/**
+ * @brief Cross-checks an incrementally maintained fitness against a full recompute.
+ * 
+ * Used when `setFitnessCrossCheck(true)` is enabled to validate the delta evaluation.
+ * 
+ * @param route The route whose fitness was updated incrementally.
+ * @param fitness The incrementally computed fitness.
+ * @param numCities The number of cities in the route.
+ * @throws std::logic_error if the two values differ by more than rounding error.
+ */
+void PSO::checkFitness(std::span<const int> route, double fitness, int numCities) {
+    double expected = calculateDistance(route, numCities);
+    if (std::abs(expected - fitness) > 1e-9 * std::max(1.0, expected)) {
+        std::ostringstream message;
+        message << "Incremental fitness " << fitness << " does not match full recompute " << expected;
+        throw std::logic_error(message.str());
     }
-    int lastCity = route[numCities - 1];
-    int firstCity = route[0];
-    distance += distanceMatrix[lastCity][firstCity];
-    return distance;
 }
 
 /**
@@ -84,166 +179,804 @@ double PSO::calculateDistance(const std::vector<int> &route, int numCities) {
  * This function updates the particle's best fitness and route if the current route
  * has a better fitness value. It also updates the global best fitness and route if applicable.
  * 
- * @param p The particle to update.
+ * @param pIdx The index of the particle to update.
  * @param numCities The number of cities in the route.
  */
-void PSO::updateBestFitness(std::shared_ptr<Particle> p, int numCities) {
-    double fitness = calculateDistance(p->getRoute(), numCities);
-    if (fitness < p->getBestFitness()) {
-        p->setBestFitness(fitness);
-        std::vector<int> newBestRoute = p->getRoute();
-        p->setBestRoute(newBestRoute);
-    }
-    if (fitness < globalBestFitness) {
-        globalBestFitness = fitness;
-        globalBestRoute = p->getRoute();
+void PSO::updateBestFitness(int pIdx, int numCities) {
+    std::span<const int> route = swarm.getRoute(pIdx);
+    double fitness = calculateDistance(route, numCities);
+    swarm.getFitness(pIdx) = fitness;
+    if (fitness < swarm.getBestFitness(pIdx)) {
+        swarm.getBestFitness(pIdx) = fitness;
+        std::copy(route.begin(), route.end(), swarm.getBestRoute(pIdx).begin());
     }
+    globalBest.offer(fitness, route);
 }
 
 /**
  * @brief Initializes the particles for the PSO algorithm.
  * 
- * This function initializes the particles with random routes and velocities. It also sets
- * their initial best routes and fitness values.
+ * This function allocates the swarm arenas once and fills them with random routes and
+ * velocities, each particle from its own stream of the run's seed. The routes are then
+ * scored together by `evaluateSwarm` and become the particles' initial best routes.
  * 
  * @param numParticles The number of particles to initialize.
  * @param numCities The number of cities in the problem.
  */
 void PSO::initializeParticles(int numParticles, int numCities) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
+    swarm.resize(numParticles, numCities);
+    globalBest.reset(numCities);
+    iterationBestRoute.assign(numCities, 0);
+    polishedFitness = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < numParticles; i++) {
+        PhiloxStream stream(seed, RandomDomain::ParticleInit, static_cast<std::uint32_t>(i));
+
+        std::span<int> route = swarm.getRoute(i);
+        std::iota(route.begin(), route.end(), 0);
+        for (int k = numCities - 1; k > 0; k--) {
+            std::swap(route[k], route[stream.below(static_cast<std::uint32_t>(k + 1))]);
+        }
 
-    this->particleList.resize(numParticles);
+        for (double &v : swarm.getVelocity(i)) {
+            v = stream.uniform() * 2.0 - 1.0;
+        }
+    }
 
+    evaluateSwarm(numCities);
     for (int i = 0; i < numParticles; i++) {
-        this->particleList[i] = std::make_shared<Particle>(i);
+        std::span<const int> route = swarm.getRoute(i);
+        swarm.getBestFitness(i) = swarm.getFitness(i);
+        std::copy(route.begin(), route.end(), swarm.getBestRoute(i).begin());
+        globalBest.offer(swarm.getFitness(i), route);
+    }
+}
+
+/**
+ * @brief Updates the position and velocity of a single particle.
+ * 
+ * This function updates the particle's velocity and route based on its current state,
+ * personal best, and the global best as it stood at the start of the iteration, using
+ * the inertia, cognitive and social weights of the run's `PSOConfig`. The r1/r2
+ * draws come from the particle's own stream for this iteration, so the update does not
+ * depend on thread scheduling. It also logs the particle's state, through the
+ * asynchronous trace logger while `runPSO` is active and directly to the output file otherwise.
+ * All work happens in the particle's slices of the swarm arenas, so no memory is allocated.
+ * The fitness of the new route is updated incrementally from the swaps rather than by
+ * re-walking the tour. In the personal-best memetic modes a route that beats the
+ * particle's personal best is first polished by local search. Small instances run the
+ * velocity and swap steps through the `SmallTourKernel` for their size unless
+ * `setFixedSizeKernels(false)` was called; the results are the same. Each phase of the update
+ * is timed by the run's profiler when the library is built with PSO_PROFILING.
+ * 
+ * @param pIdx The index of the particle to update.
+ * @param iteration The current iteration number.
+ * @param outFile The output file stream to log particle data.
+ * @param numCities The number of cities in the problem.
+ */
+void PSO::updateParticle(int pIdx, int iteration, std::ofstream &outFile, int numCities) {
+    PSO_PROFILE_TIMER(timer, &profiler, threadSlot(pIdx), ProfilePhase::RandomDraws);
+    std::span<double> draws = swarm.getRandomDraws(pIdx);
+    PhiloxStream(seed, RandomDomain::ParticleUpdate, static_cast<std::uint32_t>(pIdx),
+                 static_cast<std::uint32_t>(iteration)).fillUniform(draws);
+
+    PSO_PROFILE_ENTER(timer, ProfilePhase::Velocity);
+    std::span<double> velocity = swarm.getVelocity(pIdx);
+    std::span<const int> bestRoute = swarm.getBestRoute(pIdx);
+    std::span<int> route = swarm.getRoute(pIdx);
+    std::span<const int> globalBestRoute = iterationBestRoute;
+    const SmallTourKernel *kernel =
+        fixedSizeKernels && smallKernel && smallKernel->numCities() == numCities ? smallKernel.get() : nullptr;
+    if (kernel) {
+        kernel->steer(velocity, draws, bestRoute, route, globalBestRoute, config);
+    } else {
+        for (int i = 0; i < numCities; i++) {
+            double r1 = draws[2 * i];
+            double r2 = draws[2 * i + 1];
+
+            velocity[i] = config.inertiaWeight * velocity[i] +
+                          config.cognitiveWeight * r1 * (bestRoute[i] - route[i]) +
+                          config.socialWeight * r2 * (globalBestRoute[i] - route[i]);
+        }
+    }
+
+    PSO_PROFILE_ENTER(timer, ProfilePhase::Swaps);
+    std::span<int> candidate = swarm.getCandidateRoute(pIdx);
+    double candidateFitness;
+    if (kernel) {
+        candidateFitness = kernel->applySwaps(velocity, route, candidate, swarm.getFitness(pIdx));
+    } else {
+        std::copy(route.begin(), route.end(), candidate.begin());
+        candidateFitness = distanceMatrix->visit([&](const auto &distances) {
+            IncrementalTour tour(distances, candidate, swarm.getFitness(pIdx));
+            for (int i = 0; i < numCities; i++) {
+                int swapIndex = (static_cast<int>(std::abs(velocity[i])) % numCities);
+                tour.swap(i, swapIndex);
+            }
+            return tour.getLength();
+        });
+    }
+
+    PSO_PROFILE_ENTER(timer, ProfilePhase::Validation);
+    bool isValid = true;
+    bool improvedGlobalBest = false;
+    std::span<unsigned char> visited = swarm.getVisited(pIdx);
+    std::fill(visited.begin(), visited.end(), 0);
+    for (int city : candidate) {
+        if (city < 0 || city >= numCities || visited[city]) {
+            isValid = false;
+            break;
+        }
+        visited[city] = 1;
+    }
 
-        std::vector<int> initializeRoute(numCities);
-        std::iota(initializeRoute.begin(), initializeRoute.end(), 0);
-        std::shuffle(initializeRoute.begin(), initializeRoute.end(), gen);
-        this->particleList[i]->setRoute(initializeRoute);
+    if (isValid) {
+        PSO_PROFILE_ENTER(timer, ProfilePhase::Fitness);
+        std::copy(candidate.begin(), candidate.end(), route.begin());
+        double currentFitness = candidateFitness;
+        if ((config.memeticMode == MemeticMode::PersonalBest || config.memeticMode == MemeticMode::Both) &&
+            currentFitness < swarm.getBestFitness(pIdx)) {
+            PSO_PROFILE_ENTER(timer, ProfilePhase::LocalSearch);
+            LocalSearch &search = localSearchers[threadSlot(pIdx)];
+            currentFitness = distanceMatrix->visit([&](const auto &distances) {
+                return search.optimize(distances, *neighbourLists, route, currentFitness);
+            });
+            PSO_PROFILE_ENTER(timer, ProfilePhase::Fitness);
+        }
+        if (fitnessCrossCheck) {
+            checkFitness(route, currentFitness, numCities);
+        }
+        swarm.getFitness(pIdx) = currentFitness;
 
-        std::vector<double> initializeVelocity(numCities);
-        for (auto &v : initializeVelocity) {
-            v = dis(gen) * 2.0 - 1.0;
+        if (currentFitness < swarm.getBestFitness(pIdx)) {
+            swarm.getBestFitness(pIdx) = currentFitness;
+            std::copy(route.begin(), route.end(), swarm.getBestRoute(pIdx).begin());
+            PSO_PROFILE_COUNT(timer, ProfileCounter::PersonalBestImprovements);
         }
-        this->particleList[i]->setVelocity(initializeVelocity);
+        PSO_PROFILE_ENTER(timer, ProfilePhase::GlobalBest);
+        improvedGlobalBest = globalBest.offer(currentFitness, route);
+        if (improvedGlobalBest) {
+            PSO_PROFILE_COUNT(timer, ProfileCounter::GlobalBestImprovements);
+        }
+    } else {
+        PSO_PROFILE_COUNT(timer, ProfileCounter::InvalidRoutes);
+    }
 
-        this->particleList[i]->setBestRoute(initializeRoute);
-        double fitness = calculateDistance(initializeRoute, numCities);
-        this->particleList[i]->setBestFitness(fitness);
+    if (traceSampling == TraceSampling::Off) {
+        return;
+    }
+    PSO_PROFILE_ENTER(timer, ProfilePhase::Trace);
+    if (traceLogger) {
+        if (traceLogger->wants(iteration, improvedGlobalBest)) {
+            traceLogger->log(threadSlot(pIdx), iteration, pIdx, swarm.getFitness(pIdx), route);
+        }
+        return;
+    }
+    PSO_PROFILE_ENTER(timer, ProfilePhase::LockWait);
+    std::lock_guard<std::mutex> lock(traceMutex);
+    PSO_PROFILE_ENTER(timer, ProfilePhase::Trace);
+    writeCsvTraceRow(outFile, TraceRecord{iteration, pIdx, swarm.getFitness(pIdx), route});
+}
+
+/**
+ * @brief Selects the per-thread slot the calling thread records into.
+ * 
+ * The slot picks the thread's trace ring and its profiler slot. Pool workers use their
+ * worker index and the thread driving the pool uses the slot after them. With one
+ * thread per particle each particle has its own slot.
+ * 
+ * @param pIdx The index of the particle being updated.
+ * @return int The slot for the trace logger and the profiler.
+ */
+int PSO::threadSlot(int pIdx) const {
+    if (executionMode == ExecutionMode::WorkStealingPool && swarmExecutor) {
+        int worker = ThreadPool::currentWorker();
+        return worker >= 0 ? worker : swarmExecutor->size();
+    }
+    return pIdx;
+}
 
-        updateBestFitness(this->particleList[i], numCities);
+/**
+ * @brief Makes the candidate lists and one local search per thread slot ready for use.
+ * 
+ * The lists are built from the city coordinates through a k-d tree the first time they
+ * are needed, or again after the matrix or the config's neighbour count changed. A
+ * matrix without matching cities, or one given by the instance, is scanned row by row instead.
+ * 
+ * @param numSlots The number of thread slots that may run a local search.
+ */
+void PSO::prepareLocalSearch(int numSlots) {
+    int count = std::min(config.neighbourCount, distanceMatrix->size() - 1);
+    if (!neighbourLists || neighbourLists->size() != distanceMatrix->size() || neighbourLists->getCount() != count) {
+        auto lists = std::make_shared<NeighbourLists>();
+        if (!instanceDistances && static_cast<int>(cityList.size()) == distanceMatrix->size()) {
+            lists->build(cityList, config.neighbourCount, swarmExecutor.get());
+        } else {
+            lists->build(*distanceMatrix, config.neighbourCount);
+        }
+        neighbourLists = std::move(lists);
+    }
+    if (static_cast<int>(localSearchers.size()) < numSlots) {
+        localSearchers.resize(numSlots);
+    }
+}
+
+/**
+ * @brief Polishes the global best with local search and offers the result back.
+ * 
+ * A global best that has already been polished is left alone, so an iteration that
+ * does not improve the best costs nothing.
+ * 
+ * @param slot The thread slot of the calling thread.
+ */
+void PSO::polishGlobalBest(int slot) {
+    double fitness = globalBest.snapshot(iterationBestRoute);
+    if (fitness >= polishedFitness) {
+        return;
+    }
+    LocalSearch &search = localSearchers[slot];
+    polishedFitness = distanceMatrix->visit([&](const auto &distances) {
+        return search.optimize(distances, *neighbourLists, iterationBestRoute, fitness);
+    });
+    if (fitnessCrossCheck) {
+        checkFitness(iterationBestRoute, polishedFitness, static_cast<int>(iterationBestRoute.size()));
     }
+    globalBest.offer(polishedFitness, iterationBestRoute);
 }
 
 /**
  * @brief Updates the particles' positions and velocities for a given iteration.
  * 
- * This function updates each particle's velocity and route based on its current state,
- * personal best, and the global best. It also logs the particle's state to the output file.
+ * The global best is snapshotted once before the particles are dispatched, so every
+ * particle steers towards the same route whatever order the threads run in. Every
+ * `fitnessResync` iterations, if set, the incrementally kept fitness values are first
+ * recomputed by `evaluateSwarm`.
+ * 
+ * `ExecutionMode::WorkStealingPool` spreads the particles over the swarm executor
+ * created by `beginRun` and `ExecutionMode::Serial` updates them in order on the
+ * calling thread. `ExecutionMode::ThreadPerParticle`, or any mode without an executor,
+ * starts and joins a thread per particle. In every mode an exception from a particle's
+ * update, such as a failed fitness cross-check, reaches the caller; the threads of
+ * `ThreadPerParticle` keep theirs until all are joined. In the global-best memetic
+ * modes the new global best is then polished by local search on the calling thread.
  * 
  * @param iteration The current iteration number.
  * @param outFile The output file stream to log particle data.
  * @param numCities The number of cities in the problem.
  */
 void PSO::updateParticles(int iteration, std::ofstream &outFile, int numCities) {
-    std::vector<std::thread> threads;
-
-    for (int pIdx = 0; pIdx < this->particleList.size(); pIdx++) {
-        // Lambda Function
-        threads.emplace_back([this, pIdx, iteration, numCities, &outFile]() {
-            auto &p = this->particleList[pIdx];
+    int driverSlot = swarmExecutor ? swarmExecutor->size() : swarm.size();
+    if (config.memeticMode != MemeticMode::Off) {
+        prepareLocalSearch(driverSlot + 1);
+    }
+    if (config.fitnessResync > 0 && iteration > 0 && iteration % config.fitnessResync == 0) {
+        PSO_PROFILE_TIMER(timer, &profiler, driverSlot, ProfilePhase::Resync);
+        evaluateSwarm(numCities);
+    }
+    {
+        PSO_PROFILE_TIMER(timer, &profiler, driverSlot, ProfilePhase::Snapshot);
+        globalBest.snapshot(iterationBestRoute);
+    }
 
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::uniform_real_distribution<> dis(0.0, 1.0);
+    if (executionMode == ExecutionMode::WorkStealingPool && swarmExecutor) {
+        // Capture a single pointer so the std::function below fits its small-buffer
+        // storage and the iteration does not allocate.
+        struct UpdateContext {
+            PSO *pso;
+            int iteration;
+            int numCities;
+            std::ofstream *outFile;
+        } context{this, iteration, numCities, &outFile};
+        swarmExecutor->parallelFor(swarm.size(), [&context](int pIdx) {
+            context.pso->updateParticle(pIdx, context.iteration, *context.outFile, context.numCities);
+        });
+    } else if (executionMode == ExecutionMode::Serial) {
+        for (int pIdx = 0; pIdx < swarm.size(); pIdx++) {
+            updateParticle(pIdx, iteration, outFile, numCities);
+        }
+    } else {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(swarm.size());
 
-            std::vector<double> updatedVelocity = p->getVelocity();
-            std::vector<int> currentBestRoute = p->getBestRoute();
-            std::vector<int> currentRoute = p->getRoute();
-            for (int i = 0; i < numCities; i++) {
-                double r1 = dis(gen);
-                double r2 = dis(gen);
+        for (int pIdx = 0; pIdx < swarm.size(); pIdx++) {
+            threads.emplace_back([this, pIdx, iteration, numCities, &outFile, &errors]() {
+                try {
+                    updateParticle(pIdx, iteration, outFile, numCities);
+                } catch (...) {
+                    errors[pIdx] = std::current_exception();
+                }
+            });
+        }
 
-                updatedVelocity[i] = INERTIA_WEIGHT * updatedVelocity[i] +
-                                     COGNITIVE_WEIGHT * r1 * (currentBestRoute[i] - currentRoute[i]) +
-                                     SOCIAL_WEIGHT * r2 * (globalBestRoute[i] - currentRoute[i]);
+        for (auto &t : threads) {
+            t.join();
+        }
+        for (const std::exception_ptr &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
             }
-            p->setVelocity(updatedVelocity);
-            for (int i = 0; i < NUM_CITIES; i++) {
-                int swapIndex = (static_cast<int>(std::abs(updatedVelocity[i])) % NUM_CITIES);
-                std::swap(currentRoute[i], currentRoute[swapIndex]);
+        }
+    }
+
+    if (config.memeticMode == MemeticMode::GlobalBest || config.memeticMode == MemeticMode::Both) {
+        PSO_PROFILE_TIMER(timer, &profiler, driverSlot, ProfilePhase::LocalSearch);
+        polishGlobalBest(driverSlot);
+    }
+
+    if (traceLogger) {
+        PSO_PROFILE_TIMER(timer, &profiler, driverSlot, ProfilePhase::TraceDrain);
+        traceLogger->endIteration(iteration);
+    }
+}
+
+/**
+ * @brief Starts the per-run machinery: the swarm executor and the trace logger.
+ * 
+ * In `ExecutionMode::WorkStealingPool` the swarm executor is created once here and
+ * kept alive until `endRun`. Particle states are written by a background trace logger
+ * according to `setTraceSampling`, to outFile as CSV unless another sink was installed
+ * with `setTraceSink`. The profiler is cleared and given one slot per recording thread.
+ * 
+ * @param outFile The output file stream to log particle data.
+ * @param numCities The number of cities in the problem.
+ */
+void PSO::beginRun(std::ofstream &outFile, int numCities) {
+    if (executionMode == ExecutionMode::WorkStealingPool) {
+        swarmExecutor = std::make_unique<ThreadPool>(numThreads);
+    }
+    profiler.reset(swarmExecutor ? swarmExecutor->size() + 1 : swarm.size() + 1);
+    if (traceSampling != TraceSampling::Off) {
+        int numProducers = swarmExecutor ? swarmExecutor->size() + 1 : swarm.size();
+        std::size_t ringCapacity = std::max<std::size_t>(1024, swarm.size());
+        TraceSink sink = traceSink ? traceSink : makeCsvTraceSink(outFile);
+        traceLogger = std::make_unique<TraceLogger>(sink, numProducers, numCities,
+                                                    traceSampling, traceInterval, ringCapacity);
+    }
+}
+
+/**
+ * @brief Flushes the trace logger and stops the swarm executor started by `beginRun`.
+ */
+void PSO::endRun() {
+    traceLogger.reset();
+    swarmExecutor.reset();
+}
+
+/**
+ * @brief Name of a stop reason, for printing.
+ */
+const char *stopReasonName(StopReason reason) {
+    switch (reason) {
+        case StopReason::MaxIterations: return "max iterations";
+        case StopReason::TimeBudget: return "time budget";
+        case StopReason::Stalled: return "stalled";
+        case StopReason::TargetReached: return "target reached";
+        case StopReason::CacheHit: return "cache hit";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Runs the PSO algorithm until the config's stopping rules end it.
+ * 
+ * This function executes the PSO algorithm, updating particles and logging their states
+ * for up to the config's `maxIterations` iterations between `beginRun` and `endRun`.
+ * Between iterations it also stops once the wall-clock budget is spent, once the global
+ * best has not improved for `stallIterations` iterations, or once the global best is
+ * within `targetGap` of `targetDistance`, so it can be used as an anytime solver.
+ * Every time an iteration improves the global best, the improvement callback is called
+ * on this thread with the new route, starting with the initial best as iteration 0.
+ * With a solution cache set, a cached tour of the same waypoints is reported as the
+ * iteration 0 best and ends the run at once with `StopReason::CacheHit`; a tour of
+ * mostly the same waypoints seeds the swarm (see `seedFromCache`), and the run's best
+ * tour is stored if it beats the cached one.
+ * 
+ * @param outFile The output file stream to log particle data.
+ * @param numCities The number of cities in the problem.
+ * @return StopReason Which rule ended the run; also available from `getStopReason`.
+ */
+StopReason PSO::runPSO(std::ofstream &outFile, int numCities) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    if (solutionCache && seedFromCache(numCities)) {
+        if (improvementCallback) {
+            std::vector<int> route = globalBest.getRoute();
+            improvementCallback(BestImprovement{0, elapsedMs(), globalBest.getFitness(), route});
+        }
+        stopReason = StopReason::CacheHit;
+        iterationsRun = 0;
+        return stopReason;
+    }
+    beginRun(outFile, numCities);
+    double best = std::numeric_limits<double>::max();
+    int lastImprovement = 0;
+    int iter = 0;
+    while (true) {
+        double current = globalBest.getFitness();
+        if (current < best) {
+            best = current;
+            lastImprovement = iter;
+            if (improvementCallback) {
+                double fitness = globalBest.snapshot(iterationBestRoute);
+                improvementCallback(BestImprovement{iter, elapsedMs(), fitness, iterationBestRoute});
             }
+        }
+        if (config.targetDistance > 0.0 && best <= config.targetDistance * (1.0 + config.targetGap)) {
+            stopReason = StopReason::TargetReached;
+            break;
+        }
+        if (iter >= config.maxIterations) {
+            stopReason = StopReason::MaxIterations;
+            break;
+        }
+        if (config.stallIterations > 0 && iter - lastImprovement >= config.stallIterations) {
+            stopReason = StopReason::Stalled;
+            break;
+        }
+        if (config.timeBudgetMs > 0.0 && elapsedMs() >= config.timeBudgetMs) {
+            stopReason = StopReason::TimeBudget;
+            break;
+        }
+        updateParticles(iter, outFile, numCities);
+        iter++;
+    }
+    iterationsRun = iter;
+    endRun();
+    if (solutionCache) {
+        solutionCache->store(cityList, cacheMetric, globalBest.getRoute(), getExactBestFitness());
+    }
+    return stopReason;
+}
 
-            bool isValid = true;
-            std::vector<bool> visited(NUM_CITIES, false);
-            for (int city : currentRoute) {
-                if (city < 0 || city >= NUM_CITIES || visited[city]) {
-                    isValid = false;
-                    break;
+/**
+ * @brief Puts the solution cache's tour for these waypoints into the swarm.
+ * 
+ * An exact hit replaces the worst particle's route and becomes the global best. A near
+ * hit sharing at least the configured fraction of waypoints is completed first: the
+ * waypoints it does not have are added at their cheapest insertion points, and the
+ * result replaces the worst particle's route, so the search starts from it.
+ * 
+ * @param numCities The number of cities in the problem.
+ * @return true if the hit was exact, so no search is needed.
+ */
+bool PSO::seedFromCache(int numCities) {
+    std::optional<CacheHit> hit = solutionCache->lookup(cityList, cacheMetric, cacheMinOverlap);
+    if (!hit) {
+        return false;
+    }
+    std::vector<int> route = std::move(hit->route);
+    if (!hit->exact) {
+        std::vector<bool> present(numCities, false);
+        for (int city : route) {
+            present[city] = true;
+        }
+        distanceMatrix->visit([&](const auto &distances) {
+            for (int city = 0; city < numCities; city++) {
+                if (!present[city]) {
+                    auto [position, delta] = cheapestInsertion(distances, std::span<const int>(route), city);
+                    route.insert(route.begin() + position, city);
                 }
-                visited[city] = true;
             }
+        });
+    }
+    injectRoutes({route}, numCities);
+    return hit->exact;
+}
 
-            if (isValid) {
-                p->setRoute(currentRoute);
-                double currentFitness = calculateDistance(currentRoute, numCities);
+/**
+ * @brief Uses another solver's cities and distance matrix for this solver.
+ * 
+ * The matrix and the local search's candidate lists, if the source has built them, are
+ * shared rather than copied, so many solvers can work on one large instance. The source
+ * must have built its distance matrix.
+ * 
+ * @param source The solver whose instance is shared.
+ */
+void PSO::shareInstance(const PSO &source) {
+    cityList = source.cityList;
+    distanceMatrix = source.distanceMatrix;
+    neighbourLists = source.neighbourLists;
+    smallKernel = source.smallKernel;
+    instanceDistances = source.instanceDistances;
+    knownOptimum = source.knownOptimum;
+    cacheMetric = source.cacheMetric;
+}
 
-                std::lock_guard<std::mutex> lock(globalMutex);
-                if (currentFitness < p->getBestFitness()) {
-                    p->setBestFitness(currentFitness);
-                    p->setBestRoute(currentRoute);
-                }
-                if (currentFitness < globalBestFitness) {
-                    globalBestFitness = currentFitness;
-                    globalBestRoute = currentRoute;
-                }
+/**
+ * @brief Copies out the global best route and the best personal-best routes of the swarm.
+ * 
+ * The global best comes first. After memetic polishing it can be better than every
+ * personal best, so it is not left to the personal bests to carry it. Personal bests
+ * that repeat it are skipped.
+ * 
+ * @param count The number of routes wanted; fewer are returned if the swarm is smaller.
+ * @return std::vector<std::vector<int>> The routes, global best first.
+ */
+std::vector<std::vector<int>> PSO::getEliteRoutes(int count) const {
+    count = std::min(count, swarm.size());
+    std::vector<std::vector<int>> elites;
+    if (count <= 0) {
+        return elites;
+    }
+    std::vector<int> best = globalBest.getRoute();
+    if (!best.empty()) {
+        elites.push_back(best);
+    }
+
+    std::vector<int> order(swarm.size());
+    std::iota(order.begin(), order.end(), 0);
+    int wanted = std::min(count + 1, swarm.size());
+    std::partial_sort(order.begin(), order.begin() + wanted, order.end(), [this](int a, int b) {
+        return swarm.getBestFitness(a) < swarm.getBestFitness(b);
+    });
+    for (int i = 0; i < wanted && static_cast<int>(elites.size()) < count; i++) {
+        std::span<const int> route = swarm.getBestRoute(order[i]);
+        if (!best.empty() && std::equal(route.begin(), route.end(), best.begin(), best.end())) {
+            continue;
+        }
+        elites.emplace_back(route.begin(), route.end());
+    }
+    return elites;
+}
+
+/**
+ * @brief Replaces the worst particles' positions with the given routes.
+ * 
+ * The particles with the longest current routes take the new routes; their personal
+ * bests and the global best are updated if the routes improve on them. Velocities are
+ * kept. Call between iterations only.
+ * 
+ * @param routes The routes to inject, each a permutation of the cities.
+ * @param numCities The number of cities in the problem.
+ */
+void PSO::injectRoutes(const std::vector<std::vector<int>> &routes, int numCities) {
+    std::vector<int> order(swarm.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return swarm.getFitness(a) > swarm.getFitness(b);
+    });
+
+    int count = std::min(static_cast<int>(routes.size()), swarm.size());
+    for (int i = 0; i < count; i++) {
+        std::copy(routes[i].begin(), routes[i].end(), swarm.getRoute(order[i]).begin());
+        updateBestFitness(order[i], numCities);
+    }
+}
+
+/**
+ * @brief The distance matrix, made private to this solver so it can be patched in place.
+ * 
+ * A matrix that other solvers still share through `shareInstance` is rebuilt for this
+ * solver first, so they keep the one they have.
+ */
+DistanceMatrix &PSO::ownMatrix() {
+    if (distanceMatrix.use_count() > 1) {
+        auto matrix = std::make_shared<DistanceMatrix>();
+        matrix->build(cityList, distanceMatrix->getStorage());
+        distanceMatrix = std::move(matrix);
+    }
+    return *std::const_pointer_cast<DistanceMatrix>(distanceMatrix);
+}
+
+/**
+ * @brief Re-publishes the global best and drops the per-instance helpers after the cities changed.
+ * 
+ * @param bestRoute The previous global best, repaired for the new cities.
+ * @param bestFitness Its length, or the largest double if there was none.
+ */
+void PSO::afterCitiesChanged(std::vector<int> &bestRoute, double bestFitness) {
+    int numCities = static_cast<int>(cityList.size());
+    config.numCities = numCities;
+    globalBest.reset(numCities);
+    polishedFitness = std::numeric_limits<double>::max();
+    if (bestFitness < std::numeric_limits<double>::max()) {
+        globalBest.offer(bestFitness, bestRoute);
+    }
+    for (int p = 0; p < swarm.size(); p++) {
+        globalBest.offer(swarm.getBestFitness(p), swarm.getBestRoute(p));
+    }
+    iterationBestRoute.assign(numCities, 0);
+    globalBest.snapshot(iterationBestRoute);
+    smallKernel = makeSmallTourKernel(*distanceMatrix);
+    neighbourLists.reset();
+}
+
+/**
+ * @brief Adds a waypoint to a solver that may already be part-way through a solve.
+ * 
+ * The new city gets the next index. Its distances are patched into the matrix (see
+ * `DistanceMatrix::insertCity`), and every particle's route, personal best and the
+ * global best take it at their cheapest insertion point, with their lengths updated
+ * by the detour. Velocities get a zero entry at the same position. The swarm keeps
+ * what it has learned, so `runPSO` can carry on from there. Call between runs only.
+ * 
+ * @param x The x-coordinate of the new city.
+ * @param y The y-coordinate of the new city.
+ * @param z The z-coordinate of the new city.
+ * @return int The index of the new city.
+ * @throws std::logic_error if the distance matrix was not built for the current cities,
+ *         or the instance came with its own distance table.
+ */
+int PSO::insertCity(double x, double y, double z) {
+    if (instanceDistances) {
+        throw std::logic_error("PSO: cities cannot be changed on an instance with its own distance table");
+    }
+    if (distanceMatrix->size() != static_cast<int>(cityList.size())) {
+        throw std::logic_error("PSO: initializeDistanceMatrix must run before cities are changed");
+    }
+    DistanceMatrix &matrix = ownMatrix();
+    int city = static_cast<int>(cityList.size());
+    std::vector<int> bestRoute = globalBest.getRoute();
+    double bestFitness = globalBest.getFitness();
+    cityList.push_back(std::make_shared<City>(city));
+    cityList.back()->setCoordinates(x, y, z);
+    matrix.insertCity(cityList);
+
+    if (swarm.size() > 0) {
+        swarm.setNumCities(city + 1);
+    }
+    matrix.visit([&](const auto &distances) {
+        auto insert = [&](std::span<int> route, std::span<double> velocity, double &length) {
+            auto [position, delta] = cheapestInsertion(distances, std::span<const int>(route.first(city)), city);
+            std::copy_backward(route.begin() + position, route.begin() + city, route.begin() + city + 1);
+            route[position] = city;
+            if (!velocity.empty()) {
+                std::copy_backward(velocity.begin() + position, velocity.begin() + city, velocity.begin() + city + 1);
+                velocity[position] = 0.0;
             }
-            std::lock_guard<std::mutex> lock(globalMutex);
-            outFile << iteration << "," << pIdx;
-            for (int city : p->getRoute()) {
-                outFile << "," << city;
+            length += delta;
+        };
+        for (int p = 0; p < swarm.size(); p++) {
+            insert(swarm.getRoute(p), swarm.getVelocity(p), swarm.getFitness(p));
+            insert(swarm.getBestRoute(p), {}, swarm.getBestFitness(p));
+        }
+        if (bestFitness < std::numeric_limits<double>::max()) {
+            bestRoute.push_back(city);
+            insert(bestRoute, {}, bestFitness);
+        }
+    });
+    afterCitiesChanged(bestRoute, bestFitness);
+    return city;
+}
+
+/**
+ * @brief Removes a waypoint from a solver that may already be part-way through a solve.
+ * 
+ * The city is cut out of every particle's route, personal best and the global best,
+ * joining its neighbours, and the lengths are updated by the shortcut; velocities lose
+ * the same position. The last city then takes the removed city's index, in the routes,
+ * the city list and the matrix (see `DistanceMatrix::removeCity`). Call between runs only.
+ * 
+ * @param city The index of the city to remove.
+ * @return int The previous index of the city now at index city, or -1 if the removed
+ *         city was the last one.
+ * @throws std::invalid_argument if city is out of range or fewer than three cities are left.
+ * @throws std::logic_error under the same conditions as `insertCity`.
+ */
+int PSO::removeCity(int city) {
+    if (instanceDistances) {
+        throw std::logic_error("PSO: cities cannot be changed on an instance with its own distance table");
+    }
+    int numCities = static_cast<int>(cityList.size());
+    if (distanceMatrix->size() != numCities) {
+        throw std::logic_error("PSO: initializeDistanceMatrix must run before cities are changed");
+    }
+    if (city < 0 || city >= numCities || numCities < 3) {
+        throw std::invalid_argument("PSO: removeCity needs a valid city and at least three cities");
+    }
+    DistanceMatrix &matrix = ownMatrix();
+    int last = numCities - 1;
+    std::vector<int> bestRoute = globalBest.getRoute();
+    double bestFitness = globalBest.getFitness();
+
+    matrix.visit([&](const auto &distances) {
+        auto remove = [&](std::span<int> route, std::span<double> velocity, double &length) {
+            int position = static_cast<int>(std::find(route.begin(), route.end(), city) - route.begin());
+            length += removalDelta(distances, std::span<const int>(route), position);
+            std::copy(route.begin() + position + 1, route.end(), route.begin() + position);
+            if (!velocity.empty()) {
+                std::copy(velocity.begin() + position + 1, velocity.end(), velocity.begin() + position);
             }
-            outFile << "," << calculateDistance(p->getRoute(), NUM_CITIES) << "\n";
-        });
+            std::replace(route.begin(), route.begin() + last, last, city);
+        };
+        for (int p = 0; p < swarm.size(); p++) {
+            remove(swarm.getRoute(p), swarm.getVelocity(p), swarm.getFitness(p));
+            remove(swarm.getBestRoute(p), {}, swarm.getBestFitness(p));
+        }
+        if (bestFitness < std::numeric_limits<double>::max()) {
+            remove(bestRoute, {}, bestFitness);
+            bestRoute.pop_back();
+        }
+    });
+    if (swarm.size() > 0) {
+        swarm.setNumCities(last);
     }
 
-    for (auto &t : threads) {
-        t.join();
+    if (city != last) {
+        auto [x, y, z] = cityList[last]->getCoordinates();
+        cityList[city] = std::make_shared<City>(city);
+        cityList[city]->setCoordinates(x, y, z);
     }
+    cityList.pop_back();
+    matrix.removeCity(city, cityList);
+    afterCitiesChanged(bestRoute, bestFitness);
+    return city == last ? -1 : last;
 }
 
 /**
- * @brief Runs the PSO algorithm for a fixed number of iterations.
+ * @brief Builds a snapshot of the swarm as individual Particle objects.
  * 
- * This function executes the PSO algorithm, updating particles and logging their states
- * for each iteration.
+ * The swarm itself is stored as structure-of-arrays; this copies each particle's
+ * slices out for callers that want the old per-particle view.
  * 
- * @param outFile The output file stream to log particle data.
- * @param numCities The number of cities in the problem.
+ * @return std::vector<std::shared_ptr<Particle>> One Particle per swarm member.
  */
-void PSO::runPSO(std::ofstream &outFile, int numCities) {
-    for (int iter = 0; iter < MAX_ITERATIONS; iter++) {
-        updateParticles(iter, outFile, numCities);
+std::vector<std::shared_ptr<Particle>> PSO::getParticleList() const {
+    std::vector<std::shared_ptr<Particle>> particles;
+    for (int i = 0; i < swarm.size(); i++) {
+        auto particle = std::make_shared<Particle>(i);
+        std::vector<int> route(swarm.getRoute(i).begin(), swarm.getRoute(i).end());
+        std::vector<double> velocity(swarm.getVelocity(i).begin(), swarm.getVelocity(i).end());
+        std::vector<int> bestRoute(swarm.getBestRoute(i).begin(), swarm.getBestRoute(i).end());
+        double bestFitness = swarm.getBestFitness(i);
+        particle->setRoute(route);
+        particle->setVelocity(velocity);
+        particle->setBestRoute(bestRoute);
+        particle->setBestFitness(bestFitness);
+        particles.push_back(particle);
+    }
+    return particles;
+}
+
+/**
+ * @brief The global best's length with full double-precision distances.
+ * 
+ * Equal to `getGlobalBestFitness` up to summation order on exact storage; on the
+ * reduced-precision layouts it is the true length of the route the search found.
+ * 
+ * @return double The exact length, or the largest double if no route was found yet.
+ */
+double PSO::getExactBestFitness() const {
+    if (globalBest.getFitness() == std::numeric_limits<double>::max()) {
+        return globalBest.getFitness();
     }
+    return distanceMatrix->exactTourLength(globalBest.getRoute());
 }
 
 /**
  * @brief Prints the results of the PSO algorithm.
  * 
- * This function prints the best route found, its distance, and the execution time.
+ * This function prints the best route found, its exact distance and, when the optimum
+ * is known, the gap to it. On a reduced-precision table it also prints the distance the
+ * search saw. The seed, the stop reason and the execution time follow, then the
+ * profiler's phase table when the run was profiled.
  * 
  * @param executionTime The total execution time of the PSO algorithm in milliseconds.
  */
 void PSO::printResults(double executionTime) {
     std::cout << "Best Path: ";
-    for (int city : globalBestRoute) {
+    for (int city : globalBest.getRoute()) {
         std::cout << city << " ";
     }
     std::cout << std::endl;
-    std::cout << "Best Distance: " << globalBestFitness << std::endl;
+    std::cout << "Best Distance: " << getExactBestFitness() << std::endl;
+    if (knownOptimum > 0.0) {
+        std::cout << "Optimality Gap: " << 100.0 * optimalityGap(getExactBestFitness(), knownOptimum)
+                  << "% (optimum " << knownOptimum << ")" << std::endl;
+    }
+    if (distanceMatrix->isReducedPrecision()) {
+        std::cout << "Searched Distance: " << globalBest.getFitness() << " (reduced-precision table, "
+                  << distanceMatrix->memoryBytes() / (1024.0 * 1024.0) << " MB)" << std::endl;
+    }
+    std::cout << "Seed: " << seed << std::endl;
+    std::cout << "Stopped: " << stopReasonName(stopReason) << " after " << iterationsRun << " iterations" << std::endl;
     std::cout << std::fixed << std::setprecision(2);
     std::cout << "Execution Time: " << executionTime << " milliseconds" << std::endl;
+    if (!profiler.empty()) {
+        std::cout << "Profile (summed over threads):" << std::endl;
+        profiler.writeSummary(std::cout);
+    }
 }
@@ -0,0 +1,110 @@
+/**
+ * @file randomImplementation.cpp
+ * @brief Implementation of the Philox4x32-10 random streams.
+ */
+
+#include "randomDefinition.hpp"
+
+namespace {
+
+constexpr std::uint32_t PHILOX_M0 = 0xD2511F53u;
+constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9u;
+constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85u;
+constexpr int PHILOX_ROUNDS = 10;
+
+inline void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t &hi, std::uint32_t &lo) {
+    std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+}
+
+inline std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> ctr, std::array<std::uint32_t, 2> key) {
+    for (int round = 0; round < PHILOX_ROUNDS; round++) {
+        std::uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(PHILOX_M0, ctr[0], hi0, lo0);
+        mulhilo(PHILOX_M1, ctr[2], hi1, lo1);
+        ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        key[0] += PHILOX_W0;
+        key[1] += PHILOX_W1;
+    }
+    return ctr;
+}
+
+inline double toUnit(std::uint32_t a, std::uint32_t b) {
+    std::uint64_t bits = ((static_cast<std::uint64_t>(a) << 32) | b) >> 11;
+    return static_cast<double>(bits) * 0x1.0p-53;
+}
+
+}
+
+/**
+ * @brief Open the stream for (domain, index, iteration) under a master seed.
+ *
+ * @param seed The master seed of the run.
+ * @param domain What the stream is used for.
+ * @param index The index within the domain, e.g. the particle id.
+ * @param iteration The iteration the stream belongs to.
+ */
+PhiloxStream::PhiloxStream(std::uint64_t seed, RandomDomain domain, std::uint32_t index, std::uint32_t iteration)
+    : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+      counter{0, iteration, index, static_cast<std::uint32_t>(domain)},
+      block{} {}
+
+void PhiloxStream::generateBlock() {
+    block = philox(counter, key);
+    counter[0]++;
+    available = 4;
+}
+
+/**
+ * @brief Next 32 random bits.
+ */
+PhiloxStream::result_type PhiloxStream::operator()() {
+    if (available == 0) {
+        generateBlock();
+    }
+    return block[4 - available--];
+}
+
+/**
+ * @brief Uniform double in [0, 1) with 53 random bits.
+ */
+double PhiloxStream::uniform() {
+    std::uint32_t a = (*this)();
+    std::uint32_t b = (*this)();
+    return toUnit(a, b);
+}
+
+/**
+ * @brief Uniform integer in [0, bound) by multiply-shift.
+ *
+ * @param bound The exclusive upper bound; must be positive.
+ */
+std::uint32_t PhiloxStream::below(std::uint32_t bound) {
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>((*this)()) * bound) >> 32);
+}
+
+/**
+ * @brief Fill a buffer with uniform doubles in [0, 1).
+ *
+ * Whole Philox blocks are turned into two doubles each without going through the
+ * per-call buffer, which is what makes batched draws cheap. The values are the
+ * same as calling uniform() out.size() times.
+ *
+ * @param out The buffer to fill.
+ */
+void PhiloxStream::fillUniform(std::span<double> out) {
+    std::size_t k = 0;
+    if (available == 0) {
+        for (; k + 2 <= out.size(); k += 2) {
+            std::array<std::uint32_t, 4> bits = philox(counter, key);
+            counter[0]++;
+            out[k] = toUnit(bits[0], bits[1]);
+            out[k + 1] = toUnit(bits[2], bits[3]);
+        }
+    }
+    for (; k < out.size(); k++) {
+        out[k] = uniform();
+    }
+}
@@ -0,0 +1,438 @@
+/**
+ * @file solutionCacheImplementation.cpp
+ * @brief On-disk cache of best tours keyed by a fingerprint of the quantized waypoints.
+ */
+
+#include "solutionCacheDefinition.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t FILE_HEADER_BYTES = 16;
+constexpr std::size_t RECORD_HEADER_BYTES = 32;
+
+void appendU32(std::vector<unsigned char> &buffer, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buffer.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+void appendU64(std::vector<unsigned char> &buffer, std::uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        buffer.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+void appendVarint(std::vector<unsigned char> &buffer, std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<unsigned char>(value));
+}
+
+std::uint64_t readLittleEndian(const unsigned char *p, int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Reads varints from a payload, failing on a truncated one.
+ */
+struct VarintReader {
+    const unsigned char *p;
+    const unsigned char *end;
+
+    std::uint64_t next() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p == end) {
+                throw std::runtime_error("Truncated solution cache record");
+            }
+            unsigned char byte = *p++;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed solution cache record");
+    }
+};
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+/**
+ * @brief 64-bit FNV-1a, fed one little-endian word at a time.
+ */
+struct Fnv1a {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    void mix(std::uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            hash = (hash ^ ((value >> (8 * i)) & 0xff)) * 0x100000001b3ULL;
+        }
+    }
+};
+
+}
+
+/**
+ * @brief Open a cache file, creating it if it does not exist.
+ *
+ * A record whose header does not fit the rest of the file, or claims more waypoints
+ * than its payload could hold, ends the scan, and the file is cut back to the last
+ * whole record before it.
+ *
+ * @param path The cache file.
+ * @param quantum The coordinate resolution of a new file; an existing file keeps its own.
+ * @throws std::invalid_argument if quantum is not positive.
+ * @throws std::runtime_error if the file cannot be created or is not a solution cache.
+ */
+SolutionCache::SolutionCache(const std::string &path, double quantum) : path(path), quantum(quantum) {
+    if (!(quantum > 0.0)) {
+        throw std::invalid_argument("SolutionCache: quantum must be positive");
+    }
+    std::error_code error;
+    std::uint64_t fileBytes = std::filesystem::exists(path, error) ? std::filesystem::file_size(path, error) : 0;
+    if (fileBytes == 0) {
+        std::vector<unsigned char> header(SOLUTION_CACHE_MAGIC, SOLUTION_CACHE_MAGIC + 4);
+        appendU32(header, SOLUTION_CACHE_VERSION);
+        appendU64(header, std::bit_cast<std::uint64_t>(quantum));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(header.data()), static_cast<std::streamsize>(header.size()));
+        if (!out) {
+            throw std::runtime_error("Cannot create solution cache " + path);
+        }
+        return;
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    unsigned char header[FILE_HEADER_BYTES];
+    if (!in.read(reinterpret_cast<char *>(header), FILE_HEADER_BYTES) ||
+        std::memcmp(header, SOLUTION_CACHE_MAGIC, 4) != 0 || readLittleEndian(header + 4, 4) != SOLUTION_CACHE_VERSION) {
+        throw std::runtime_error("Not a solution cache: " + path);
+    }
+    this->quantum = std::bit_cast<double>(readLittleEndian(header + 8, 8));
+
+    std::uint64_t offset = FILE_HEADER_BYTES;
+    unsigned char record[RECORD_HEADER_BYTES];
+    while (offset < fileBytes) {
+        if (!in.read(reinterpret_cast<char *>(record), RECORD_HEADER_BYTES)) {
+            break;
+        }
+        std::uint64_t payloadBytes = readLittleEndian(record, 4);
+        std::uint64_t numCities = readLittleEndian(record + 20, 4);
+        // Every waypoint takes at least three coordinate bytes and one tour byte.
+        if (offset + RECORD_HEADER_BYTES + payloadBytes > fileBytes || numCities == 0 ||
+            numCities > payloadBytes / 4) {
+            break;
+        }
+        Entry entry{offset, readLittleEndian(record + 4, 8), readLittleEndian(record + 12, 8),
+                    static_cast<int>(numCities), std::bit_cast<double>(readLittleEndian(record + 24, 8)),
+                    static_cast<std::uint32_t>(payloadBytes), nullptr};
+        auto found = best.find(entry.fingerprint);
+        if (found == best.end() || entry.fitness < entries[found->second].fitness) {
+            best[entry.fingerprint] = entries.size();
+        }
+        entries.push_back(entry);
+        offset += RECORD_HEADER_BYTES + payloadBytes;
+        in.seekg(static_cast<std::streamoff>(offset));
+    }
+    if (offset != fileBytes) {
+        in.close();
+        std::filesystem::resize_file(path, offset);
+    }
+}
+
+/**
+ * @brief The metric key for an instance's distances.
+ *
+ * Instances without a distance table use plain Euclidean distances and share one key.
+ * Otherwise the key hashes the table itself, so rounded TSPLIB distances and explicit
+ * tables never match each other or the Euclidean entries for the same points.
+ *
+ * @param instance The instance.
+ * @return std::uint64_t The key to pass to `lookup` and `store`.
+ */
+std::uint64_t SolutionCache::metricOf(const TSPInstance &instance) {
+    if (!instance.distances) {
+        return EUCLIDEAN_METRIC;
+    }
+    Fnv1a fnv;
+    for (double distance : *instance.distances) {
+        fnv.mix(std::bit_cast<std::uint64_t>(distance));
+    }
+    return fnv.hash == EUCLIDEAN_METRIC ? 1 : fnv.hash;
+}
+
+/**
+ * @brief Quantize the waypoints and sort them into the cache's canonical order.
+ *
+ * @param cityList The waypoints.
+ * @param points Filled with the quantized coordinates, sorted.
+ * @param order Filled with the index in cityList of each sorted point.
+ */
+void SolutionCache::canonicalize(const std::vector<std::shared_ptr<City>> &cityList, std::vector<Point> &points,
+                                 std::vector<int> &order) const {
+    int n = static_cast<int>(cityList.size());
+    std::vector<Point> quantized(n);
+    for (int i = 0; i < n; i++) {
+        auto [x, y, z] = cityList[i]->getCoordinates();
+        quantized[i] = {std::llround(x / quantum), std::llround(y / quantum), std::llround(z / quantum)};
+    }
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return quantized[a] < quantized[b]; });
+    points.resize(n);
+    for (int i = 0; i < n; i++) {
+        points[i] = quantized[order[i]];
+    }
+}
+
+/**
+ * @brief An entry's sorted points and tour, read from the file the first time they are needed.
+ *
+ * Called with the mutex held. A payload that does not decode marks the entry corrupt,
+ * and it is skipped from then on.
+ *
+ * @return std::shared_ptr<const Decoded> The points and tour, or null if the entry is corrupt.
+ */
+std::shared_ptr<const SolutionCache::Decoded> SolutionCache::decode(Entry &entry) {
+    if (entry.decoded || entry.corrupt) {
+        return entry.decoded;
+    }
+    try {
+        std::vector<unsigned char> payload(entry.payloadBytes);
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(entry.offset + RECORD_HEADER_BYTES));
+        if (!in.read(reinterpret_cast<char *>(payload.data()), static_cast<std::streamsize>(payload.size()))) {
+            throw std::runtime_error("Cannot read solution cache " + path);
+        }
+        auto decoded = std::make_shared<Decoded>();
+        VarintReader reader{payload.data(), payload.data() + payload.size()};
+        decoded->points.resize(entry.numCities);
+        Point previous = {0, 0, 0};
+        for (Point &point : decoded->points) {
+            for (int axis = 0; axis < 3; axis++) {
+                point[axis] = previous[axis] + unzigzag(reader.next());
+            }
+            previous = point;
+        }
+        decoded->tour.resize(entry.numCities);
+        for (int &position : decoded->tour) {
+            position = static_cast<int>(reader.next());
+            if (position < 0 || position >= entry.numCities) {
+                throw std::runtime_error("Malformed solution cache record");
+            }
+        }
+        entry.decoded = std::move(decoded);
+    } catch (const std::exception &) {
+        entry.corrupt = true;
+    }
+    return entry.decoded;
+}
+
+/**
+ * @brief 64-bit FNV-1a hash of the metric, the waypoint count and the sorted, quantized coordinates.
+ */
+std::uint64_t SolutionCache::fingerprint(const std::vector<Point> &points, std::uint64_t metric) const {
+    Fnv1a fnv;
+    fnv.mix(metric);
+    fnv.mix(points.size());
+    for (const Point &point : points) {
+        for (std::int64_t coordinate : point) {
+            fnv.mix(static_cast<std::uint64_t>(coordinate));
+        }
+    }
+    return fnv.hash;
+}
+
+/**
+ * @brief The cache key of these waypoints under this metric.
+ *
+ * @param cityList The waypoints.
+ * @param metric The metric key, `EUCLIDEAN_METRIC` or one from `metricOf`.
+ */
+std::uint64_t SolutionCache::fingerprint(const std::vector<std::shared_ptr<City>> &cityList,
+                                         std::uint64_t metric) const {
+    std::vector<Point> points;
+    std::vector<int> order;
+    canonicalize(cityList, points, order);
+    return fingerprint(points, metric);
+}
+
+/**
+ * @brief Find the best cached tour for these waypoints, or for a set that mostly matches them.
+ *
+ * Only entries with the same metric are considered. An entry with the same fingerprint
+ * and the same points is an exact hit. Otherwise every instance whose size could reach
+ * minOverlap is compared point by point, and the one sharing the largest fraction of
+ * waypoints (of the larger set) is a near hit. The comparisons run on the decoded
+ * entries outside the lock.
+ *
+ * @param cityList The waypoints to solve.
+ * @param metric The metric key, `EUCLIDEAN_METRIC` or one from `metricOf`.
+ * @param minOverlap The smallest shared fraction accepted as a near hit.
+ * @return std::optional<CacheHit> The hit, or nothing.
+ */
+std::optional<CacheHit> SolutionCache::lookup(const std::vector<std::shared_ptr<City>> &cityList,
+                                              std::uint64_t metric, double minOverlap) {
+    std::vector<Point> queryPoints;
+    std::vector<int> order;
+    canonicalize(cityList, queryPoints, order);
+    std::uint64_t key = fingerprint(queryPoints, metric);
+    int n = static_cast<int>(cityList.size());
+
+    std::vector<std::pair<double, std::shared_ptr<const Decoded>>> candidates;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto exact = best.find(key);
+        if (exact != best.end() && entries[exact->second].numCities == n) {
+            std::shared_ptr<const Decoded> decoded = decode(entries[exact->second]);
+            if (decoded && decoded->points == queryPoints) {
+                CacheHit hit{{}, entries[exact->second].fitness, 1.0, true};
+                for (int position : decoded->tour) {
+                    hit.route.push_back(order[position]);
+                }
+                return hit;
+            }
+        }
+        for (const auto &[fingerprint, index] : best) {
+            Entry &entry = entries[index];
+            if (entry.metric != metric || entry.numCities < minOverlap * n || entry.numCities * minOverlap > n) {
+                continue;
+            }
+            if (std::shared_ptr<const Decoded> decoded = decode(entry)) {
+                candidates.emplace_back(entry.fitness, std::move(decoded));
+            }
+        }
+    }
+
+    std::optional<CacheHit> nearest;
+    for (const auto &[fitness, decoded] : candidates) {
+        const std::vector<Point> &points = decoded->points;
+        int numCities = static_cast<int>(points.size());
+        // Both point lists are sorted, so shared points pair up in one merge pass.
+        std::vector<int> match(numCities, -1);
+        int shared = 0;
+        for (int i = 0, j = 0; i < numCities && j < n;) {
+            if (points[i] < queryPoints[j]) {
+                i++;
+            } else if (queryPoints[j] < points[i]) {
+                j++;
+            } else {
+                match[i++] = j++;
+                shared++;
+            }
+        }
+        double overlap = static_cast<double>(shared) / std::max(n, numCities);
+        if (overlap >= minOverlap && (!nearest || overlap > nearest->overlap)) {
+            nearest = CacheHit{{}, fitness, overlap, false};
+            for (int position : decoded->tour) {
+                if (match[position] >= 0) {
+                    nearest->route.push_back(order[match[position]]);
+                }
+            }
+        }
+    }
+    return nearest;
+}
+
+/**
+ * @brief Record a tour unless the cache already has one at least as short for these waypoints.
+ *
+ * @param cityList The waypoints.
+ * @param metric The metric key the tour was measured with.
+ * @param route The tour, a permutation of the waypoint indices.
+ * @param fitness Its length.
+ * @return true if the tour was written.
+ * @throws std::invalid_argument if route is not a permutation of the waypoints.
+ * @throws std::runtime_error if the file cannot be written.
+ */
+bool SolutionCache::store(const std::vector<std::shared_ptr<City>> &cityList, std::uint64_t metric,
+                          const std::vector<int> &route, double fitness) {
+    int n = static_cast<int>(cityList.size());
+    auto decoded = std::make_shared<Decoded>();
+    std::vector<int> order;
+    canonicalize(cityList, decoded->points, order);
+    std::vector<int> position(n, -1);
+    for (int i = 0; i < n; i++) {
+        position[order[i]] = i;
+    }
+    std::vector<bool> seen(n, false);
+    if (n == 0 || static_cast<int>(route.size()) != n) {
+        throw std::invalid_argument("SolutionCache: route must visit every waypoint once");
+    }
+    for (int city : route) {
+        if (city < 0 || city >= n || seen[city]) {
+            throw std::invalid_argument("SolutionCache: route must visit every waypoint once");
+        }
+        seen[city] = true;
+        decoded->tour.push_back(position[city]);
+    }
+    std::uint64_t key = fingerprint(decoded->points, metric);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = best.find(key);
+    if (found != best.end() && entries[found->second].fitness <= fitness) {
+        return false;
+    }
+
+    std::vector<unsigned char> payload;
+    Point previous = {0, 0, 0};
+    for (const Point &point : decoded->points) {
+        for (int axis = 0; axis < 3; axis++) {
+            appendVarint(payload, zigzag(point[axis] - previous[axis]));
+        }
+        previous = point;
+    }
+    for (int city : decoded->tour) {
+        appendVarint(payload, static_cast<std::uint64_t>(city));
+    }
+    std::vector<unsigned char> record;
+    appendU32(record, static_cast<std::uint32_t>(payload.size()));
+    appendU64(record, key);
+    appendU64(record, metric);
+    appendU32(record, static_cast<std::uint32_t>(n));
+    appendU64(record, std::bit_cast<std::uint64_t>(fitness));
+    record.insert(record.end(), payload.begin(), payload.end());
+
+    std::uint64_t offset = std::filesystem::file_size(path);
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    out.write(reinterpret_cast<const char *>(record.data()), static_cast<std::streamsize>(record.size()));
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Cannot write solution cache " + path);
+    }
+    if (found != best.end()) {
+        // The superseded tour is never looked up again.
+        entries[found->second].decoded.reset();
+    }
+    best[key] = entries.size();
+    entries.push_back({offset, key, metric, n, fitness, static_cast<std::uint32_t>(payload.size()), std::move(decoded)});
+    return true;
+}
+
+/**
+ * @brief The number of distinct instances in the cache.
+ */
+int SolutionCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(best.size());
+}
@@ -0,0 +1,384 @@
+#include "solveServiceDefinition.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+/**
+ * @brief Loads each instance file once, however many jobs name it.
+ *
+ * The first job to name a file loads it outside the lock, so different files load at
+ * the same time; later jobs naming the same file wait for that load. A file that fails
+ * to load is forgotten, so the next job naming it tries again.
+ */
+class InstanceCache {
+    private:
+        using Loaded = std::shared_future<std::shared_ptr<const TSPInstance>>;
+
+        std::mutex mutex;
+        std::map<std::string, Loaded> instances;
+
+    public:
+        std::shared_ptr<const TSPInstance> get(const std::string &path) {
+            std::promise<std::shared_ptr<const TSPInstance>> loading;
+            Loaded loaded;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto found = instances.find(path);
+                if (found != instances.end()) {
+                    loaded = found->second;
+                } else {
+                    instances[path] = loading.get_future().share();
+                }
+            }
+            if (loaded.valid()) {
+                return loaded.get();
+            }
+            try {
+                auto instance = std::make_shared<const TSPInstance>(loadInstance(path));
+                loading.set_value(instance);
+                return instance;
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    instances.erase(path);
+                }
+                loading.set_exception(std::current_exception());
+                throw;
+            }
+        }
+};
+
+/**
+ * @brief The open client connections, so an interrupt can end their reads.
+ */
+class ClientRegistry {
+    private:
+        std::mutex mutex;
+        std::set<int> fds;
+
+    public:
+        void add(int fd) {
+            std::lock_guard<std::mutex> lock(mutex);
+            fds.insert(fd);
+        }
+
+        void close(int fd) {
+            std::lock_guard<std::mutex> lock(mutex);
+            fds.erase(fd);
+            ::close(fd);
+        }
+
+        bool empty() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return fds.empty();
+        }
+
+        /**
+         * @brief Make every client's pending and future reads see end of input.
+         */
+        void shutdownReads() {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (int fd : fds) {
+                ::shutdown(fd, SHUT_RD);
+            }
+        }
+};
+
+/**
+ * @brief Writes the replies of one client in the order its jobs were submitted.
+ *
+ * Each reply is written as soon as its job and every earlier one have finished, so a
+ * long job holds back only the replies behind it.
+ */
+class ResultWriter {
+    private:
+        struct Pending {
+            std::string name;
+            std::future<SolveResult> result;
+            std::string error;
+        };
+
+        std::function<bool(const std::string &)> write;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<Pending> pending;
+        bool closed = false;
+        std::thread thread;
+
+        void run() {
+            while (true) {
+                Pending next;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ready.wait(lock, [this]() { return closed || !pending.empty(); });
+                    if (pending.empty()) {
+                        return;
+                    }
+                    next = std::move(pending.front());
+                    pending.pop_front();
+                }
+                std::string line;
+                if (next.error.empty()) {
+                    try {
+                        line = formatSolveResult(next.result.get());
+                    } catch (const std::exception &error) {
+                        next.error = error.what();
+                    }
+                }
+                if (!next.error.empty()) {
+                    line = next.name + " error " + next.error;
+                }
+                write(line + "\n");
+            }
+        }
+
+    public:
+        explicit ResultWriter(std::function<bool(const std::string &)> write) : write(std::move(write)) {
+            thread = std::thread([this]() { run(); });
+        }
+
+        ~ResultWriter() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = true;
+            }
+            ready.notify_one();
+            thread.join();
+        }
+
+        void add(std::string name, std::future<SolveResult> result, std::string error = "") {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending.push_back({std::move(name), std::move(result), std::move(error)});
+            }
+            ready.notify_one();
+        }
+};
+
+/**
+ * @brief Parse one job line and queue it, or queue the reason it was rejected.
+ *
+ * Blank lines and lines starting with '#' are ignored. A job without --name is named
+ * after its line number.
+ */
+void submitLine(const std::string &line, int lineNumber, SolveService &service, InstanceCache &instances,
+                const std::shared_ptr<SolutionCache> &solutions, ResultWriter &writer) {
+    std::istringstream words(line);
+    std::string argument;
+    if (line.empty() || line[0] == '#' || !(words >> argument)) {
+        return;
+    }
+    SolveRequest request;
+    request.name = "job" + std::to_string(lineNumber);
+    request.cache = solutions;
+    std::string name = request.name;
+    try {
+        do {
+            if (argument.rfind("--instance=", 0) == 0) {
+                request.instance = instances.get(argument.substr(11));
+            } else if (!parseSolveArgument(request, argument)) {
+                throw std::invalid_argument("unknown argument " + argument);
+            }
+            name = request.name;
+        } while (words >> argument);
+        writer.add(name, service.submit(std::move(request)));
+    } catch (const std::exception &error) {
+        writer.add(name, {}, error.what());
+    }
+}
+
+/**
+ * @brief Serve one socket client: read its job lines until it closes its end, reply to each.
+ */
+void serveClient(int fd, SolveService &service, InstanceCache &instances,
+                 const std::shared_ptr<SolutionCache> &solutions, ClientRegistry &registry) {
+    {
+        ResultWriter writer([fd](const std::string &line) {
+            std::size_t sent = 0;
+            while (sent < line.size()) {
+                ssize_t n = ::send(fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    return false;
+                }
+                sent += static_cast<std::size_t>(n);
+            }
+            return true;
+        });
+        std::string buffer;
+        char chunk[4096];
+        int lineNumber = 0;
+        while (true) {
+            ssize_t n = ::read(fd, chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            buffer.append(chunk, static_cast<std::size_t>(n));
+            std::size_t end;
+            while ((end = buffer.find('\n')) != std::string::npos) {
+                submitLine(buffer.substr(0, end), ++lineNumber, service, instances, solutions, writer);
+                buffer.erase(0, end + 1);
+            }
+        }
+        submitLine(buffer, ++lineNumber, service, instances, solutions, writer);
+    }
+    registry.close(fd);
+}
+
+/**
+ * @brief Accept clients on a Unix socket until interrupted or maxConnections have been served.
+ *
+ * SIGINT and SIGTERM interrupt the service. Clients still sending jobs then have their
+ * reads shut down, so each is answered for the jobs it sent so far and the service
+ * exits without waiting for them to disconnect.
+ */
+void serveSocket(const std::string &path, int maxConnections, SolveService &service, InstanceCache &instances,
+                 const std::shared_ptr<SolutionCache> &solutions) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    ::unlink(path.c_str());
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, 64) != 0) {
+        if (listenFd >= 0) {
+            ::close(listenFd);
+        }
+        throw std::runtime_error("Cannot listen on socket " + path);
+    }
+    std::cerr << "pso_service: listening on " << path << " with " << service.size() << " workers" << std::endl;
+    std::signal(SIGINT, [](int) { interrupted.store(true); });
+    std::signal(SIGTERM, [](int) { interrupted.store(true); });
+
+    ClientRegistry registry;
+    std::vector<std::thread> clients;
+    int accepted = 0;
+    pollfd listening = {listenFd, POLLIN, 0};
+    while (!interrupted.load() && (maxConnections <= 0 || accepted < maxConnections)) {
+        if (::poll(&listening, 1, 100) <= 0) {
+            continue;
+        }
+        int client = ::accept(listenFd, nullptr, nullptr);
+        if (client >= 0) {
+            accepted++;
+            registry.add(client);
+            clients.emplace_back(serveClient, client, std::ref(service), std::ref(instances), std::cref(solutions),
+                                 std::ref(registry));
+        }
+    }
+    while (!interrupted.load() && !registry.empty()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (interrupted.load()) {
+        registry.shutdownReads();
+    }
+    for (std::thread &client : clients) {
+        client.join();
+    }
+    ::close(listenFd);
+    ::unlink(path.c_str());
+}
+
+}
+
+/**
+ * @brief Solve many independent jobs concurrently, read one per line from stdin or a Unix socket.
+ *
+ * Usage: pso_service [--workers=N] [--socket=PATH] [--max-connections=K] [--solution-cache=FILE]
+ *
+ * Every input line is one job, written as the arguments of that job: `--name=`,
+ * `--priority=` (higher starts first), `--seed=`, `--instance=FILE` (loaded once and
+ * shared by every job naming it), `--distances=` and the solver arguments of pso,
+ * such as `--cities=`, `--iterations=` and `--time-budget-ms=` for the job's budget.
+ * Jobs run on N workers (all cores by default), each solved serially. One reply line
+ * per job is written in the order the jobs were read:
+ *
+ *   NAME ok distance=D gap=G stop=REASON iterations=N queued_ms=Q solve_ms=S route=C0,C1,...
+ *   NAME error MESSAGE
+ *
+ * Without `--socket`, jobs are read from stdin until it ends and replies go to stdout.
+ * With `--socket`, every client connection is served the same way until the client shuts
+ * down its sending side; the service runs until interrupted or until K clients have been
+ * served. With `--solution-cache`, every job first looks its waypoints up in the
+ * solution cache FILE, so a repeat of an earlier job returns its tour without solving,
+ * and every job stores its tour there. Totals are printed to stderr at the end.
+ *
+ * @return int Returns 0 on success and 1 on a usage or socket error.
+ */
+int main(int argc, char *argv[]) {
+    int numWorkers = static_cast<int>(std::thread::hardware_concurrency());
+    std::string socketPath;
+    int maxConnections = 0;
+    std::string cachePath;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string argument = argv[i];
+            if (argument.rfind("--workers=", 0) == 0) {
+                numWorkers = std::stoi(argument.substr(10));
+            } else if (argument.rfind("--socket=", 0) == 0) {
+                socketPath = argument.substr(9);
+            } else if (argument.rfind("--max-connections=", 0) == 0) {
+                maxConnections = std::stoi(argument.substr(18));
+            } else if (argument.rfind("--solution-cache=", 0) == 0) {
+                cachePath = argument.substr(17);
+            } else {
+                throw std::invalid_argument("unknown argument " + argument);
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        SolveService service(std::max(1, numWorkers));
+        InstanceCache instances;
+        std::shared_ptr<SolutionCache> solutions;
+        if (!cachePath.empty()) {
+            solutions = std::make_shared<SolutionCache>(cachePath);
+        }
+        if (socketPath.empty()) {
+            ResultWriter writer([](const std::string &line) {
+                std::cout << line << std::flush;
+                return true;
+            });
+            std::string line;
+            int lineNumber = 0;
+            while (std::getline(std::cin, line)) {
+                submitLine(line, ++lineNumber, service, instances, solutions, writer);
+            }
+        } else {
+            serveSocket(socketPath, maxConnections, service, instances, solutions);
+        }
+        service.waitIdle();
+
+        SolveServiceStats stats = service.getStats();
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << "pso_service: " << stats.completed << " solved, " << stats.failed << " failed in "
+                  << elapsedMs << " ms (" << stats.busyMs << " ms of solving on " << service.size()
+                  << " workers)" << std::endl;
+    } catch (const std::exception &error) {
+        std::cerr << "pso_service: " << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file solveServiceImplementation.cpp
+ * @brief Priority job queue that solves many independent instances on shared workers.
+ */
+
+#include "solveServiceDefinition.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+/**
+ * @brief Solve one request to completion on the calling thread.
+ *
+ * The solver runs serially with tracing off, and builds its distance matrix on this
+ * thread too; the job's parallelism comes from the service running many jobs at once.
+ *
+ * @param request The instance, parameters and budget of the job.
+ * @return SolveResult The best route found and the run's statistics; queuedMs is left zero.
+ * @throws std::invalid_argument if the config is invalid.
+ */
+SolveResult solveRequest(const SolveRequest &request) {
+    auto start = std::chrono::steady_clock::now();
+    PSOConfig config = request.config;
+    if (request.instance) {
+        config.numCities = request.instance->size();
+    }
+    PSO algo(config);
+    algo.setSeed(request.seed);
+    algo.setExecutionMode(ExecutionMode::Serial);
+    algo.setNumThreads(1);
+    algo.setTraceSampling(TraceSampling::Off);
+    algo.setDistanceStorage(request.distanceStorage);
+    if (request.cache) {
+        algo.setSolutionCache(request.cache);
+    }
+    if (request.instance) {
+        algo.loadInstance(*request.instance);
+    } else {
+        algo.generateCityCoordinates(config.numCities);
+    }
+    algo.initializeDistanceMatrix();
+    algo.initializeParticles(config.numParticles, config.numCities);
+    std::ofstream discard;
+    algo.runPSO(discard, config.numCities);
+
+    SolveResult result;
+    result.name = request.name;
+    result.seed = request.seed;
+    result.route = algo.getGlobalBestRoute();
+    result.fitness = algo.getExactBestFitness();
+    result.gap = algo.getKnownOptimum() > 0.0 ? optimalityGap(result.fitness, algo.getKnownOptimum()) : 0.0;
+    result.stopReason = algo.getStopReason();
+    result.iterations = algo.getIterationsRun();
+    result.solveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/**
+ * @brief Start the worker threads.
+ *
+ * @param numWorkers The number of jobs solved at once.
+ * @throws std::invalid_argument if numWorkers is less than one.
+ */
+SolveService::SolveService(int numWorkers) {
+    if (numWorkers < 1) {
+        throw std::invalid_argument("SolveService needs at least one worker");
+    }
+    for (int i = 0; i < numWorkers; i++) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+SolveService::~SolveService() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Queue a job.
+ *
+ * @param request The job; its config is checked now, so a bad job fails here rather
+ *        than on a worker.
+ * @return std::future<SolveResult> The job's result once a worker has solved it.
+ * @throws std::invalid_argument if the config is invalid.
+ */
+std::future<SolveResult> SolveService::submit(SolveRequest request) {
+    request.config.validate();
+    auto job = std::make_unique<Job>();
+    job->request = std::move(request);
+    job->submittedAt = std::chrono::steady_clock::now();
+    std::future<SolveResult> future = job->result.get_future();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        job->sequence = nextSequence++;
+        stats.submitted++;
+        queue.push(std::move(job));
+    }
+    queueCondition.notify_one();
+    return future;
+}
+
+/**
+ * @brief Block until the queue is empty and no job is running.
+ */
+void SolveService::waitIdle() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    idleCondition.wait(lock, [this]() { return queue.empty() && running == 0; });
+}
+
+int SolveService::queued() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return static_cast<int>(queue.size());
+}
+
+SolveServiceStats SolveService::getStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return stats;
+}
+
+/**
+ * @brief Take the highest-priority job, solve it and fulfil its future, until stopped.
+ *
+ * A stopping service keeps taking jobs until the queue is empty.
+ */
+void SolveService::workerLoop() {
+    while (true) {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            // top() is const, but the job is popped straight away
+            job = std::move(const_cast<std::unique_ptr<Job> &>(queue.top()));
+            queue.pop();
+            running++;
+        }
+
+        double queuedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job->submittedAt).count();
+        bool failed = false;
+        double solveMs = 0.0;
+        try {
+            SolveResult result = solveRequest(job->request);
+            result.queuedMs = queuedMs;
+            solveMs = result.solveMs;
+            job->result.set_value(std::move(result));
+        } catch (...) {
+            failed = true;
+            job->result.set_exception(std::current_exception());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            running--;
+            stats.completed += failed ? 0 : 1;
+            stats.failed += failed ? 1 : 0;
+            stats.busyMs += solveMs;
+        }
+        idleCondition.notify_all();
+    }
+}
+
+/**
+ * @brief Apply one `--name=value` job argument, including config arguments.
+ *
+ * Job-specific names are name, seed, priority and distances (dense, packed, on-demand,
+ * float32, fixed32 or fixed16).
+ *
+ * @return true if the argument was recognised.
+ * @throws std::invalid_argument if the value cannot be parsed.
+ */
+bool parseSolveArgument(SolveRequest &request, const std::string &argument) {
+    if (argument.rfind("--name=", 0) == 0) {
+        request.name = argument.substr(7);
+    } else if (argument.rfind("--seed=", 0) == 0) {
+        request.seed = std::stoull(argument.substr(7));
+    } else if (argument.rfind("--priority=", 0) == 0) {
+        request.priority = std::stoi(argument.substr(11));
+    } else if (argument.rfind("--distances=", 0) == 0) {
+        std::string storage = argument.substr(12);
+        if (storage == "dense") {
+            request.distanceStorage = DistanceMatrix::Storage::Dense;
+        } else if (storage == "packed") {
+            request.distanceStorage = DistanceMatrix::Storage::PackedUpper;
+        } else if (storage == "on-demand") {
+            request.distanceStorage = DistanceMatrix::Storage::OnDemand;
+        } else if (storage == "float32") {
+            request.distanceStorage = DistanceMatrix::Storage::Float32;
+        } else if (storage == "fixed32") {
+            request.distanceStorage = DistanceMatrix::Storage::Fixed32;
+        } else if (storage == "fixed16") {
+            request.distanceStorage = DistanceMatrix::Storage::Fixed16;
+        } else {
+            throw std::invalid_argument("unknown distance storage " + storage);
+        }
+    } else {
+        return parseConfigArgument(request.config, argument);
+    }
+    return true;
+}
+
+/**
+ * @brief One line describing a finished job, as the pso_service front end prints it.
+ *
+ * The stop reason has its spaces replaced by dashes, so every field is one word.
+ *
+ *   NAME ok distance=D gap=G stop=REASON iterations=N queued_ms=Q solve_ms=S route=C0,C1,...
+ */
+std::string formatSolveResult(const SolveResult &result) {
+    std::string stop = stopReasonName(result.stopReason);
+    std::replace(stop.begin(), stop.end(), ' ', '-');
+    std::ostringstream line;
+    line << result.name << " ok distance=" << result.fitness << " gap=" << result.gap
+         << " stop=" << stop << " iterations=" << result.iterations
+         << " queued_ms=" << result.queuedMs << " solve_ms=" << result.solveMs << " route=";
+    for (std::size_t i = 0; i < result.route.size(); i++) {
+        line << (i == 0 ? "" : ",") << result.route[i];
+    }
+    return line.str();
+}
@@ -0,0 +1,301 @@
+/**
+ * @file swarmHistoryImplementation.cpp
+ * @brief Implementation of the binary swarm-history writer, mmap reader and CSV converter.
+ */
+
+#include "swarmHistoryDefinition.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+void appendU32(std::vector<unsigned char> &buffer, std::uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        buffer.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+void appendU64(std::vector<unsigned char> &buffer, std::uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        buffer.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+std::uint64_t doubleBits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+}
+
+/**
+ * @brief Create a history file and write its header.
+ *
+ * @param path The file to create.
+ * @param cityList The instance the swarm is solving; stored in the header.
+ * @param numParticles The number of particles in the swarm.
+ * @throws std::runtime_error if the file cannot be opened.
+ */
+SwarmHistoryWriter::SwarmHistoryWriter(const std::string &path, const std::vector<std::shared_ptr<City>> &cityList,
+                                       int numParticles)
+    : out(path, std::ios::binary), numCities(static_cast<int>(cityList.size())), previousRoutes(numParticles),
+      previousFitness(numParticles, 0) {
+    if (!out) {
+        throw std::runtime_error("Cannot open swarm history file " + path);
+    }
+    for (char c : SWARM_HISTORY_MAGIC) {
+        buffer.push_back(static_cast<unsigned char>(c));
+    }
+    appendU32(buffer, SWARM_HISTORY_VERSION);
+    appendU32(buffer, static_cast<std::uint32_t>(numCities));
+    appendU32(buffer, static_cast<std::uint32_t>(numParticles));
+    for (const auto &city : cityList) {
+        auto [x, y, z] = city->getCoordinates();
+        appendU64(buffer, doubleBits(x));
+        appendU64(buffer, doubleBits(y));
+        appendU64(buffer, doubleBits(z));
+    }
+    out.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+SwarmHistoryWriter::~SwarmHistoryWriter() {
+    flush();
+}
+
+void SwarmHistoryWriter::putVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<unsigned char>(value));
+}
+
+/**
+ * @brief Append one record, delta-encoded against the particle's previous record.
+ *
+ * The route is stored in full the first time a particle is seen, or when more than
+ * half of its positions changed. The fitness is stored as the XOR of its bits with
+ * the previous fitness, so an unchanged value takes one byte.
+ *
+ * @param record The record to append.
+ * @throws std::invalid_argument if the particle id or route length does not fit the header.
+ */
+void SwarmHistoryWriter::write(const TraceRecord &record) {
+    if (record.particleId < 0 || record.particleId >= static_cast<int>(previousRoutes.size()) ||
+        static_cast<int>(record.route.size()) != numCities) {
+        throw std::invalid_argument("SwarmHistoryWriter: record does not fit the history's swarm");
+    }
+    std::vector<int> &previous = previousRoutes[record.particleId];
+    std::uint64_t fitnessBits = doubleBits(record.fitness);
+    putVarint(static_cast<std::uint64_t>(record.iteration));
+    putVarint(static_cast<std::uint64_t>(record.particleId));
+    putVarint(fitnessBits ^ previousFitness[record.particleId]);
+    previousFitness[record.particleId] = fitnessBits;
+
+    int changes = 0;
+    if (!previous.empty()) {
+        for (int i = 0; i < numCities; i++) {
+            changes += previous[i] != record.route[i];
+        }
+    }
+    if (previous.empty() || 2 * changes > numCities) {
+        putVarint(2 * static_cast<std::uint64_t>(numCities) + 1);
+        for (int city : record.route) {
+            putVarint(static_cast<std::uint64_t>(city));
+        }
+        previous.assign(record.route.begin(), record.route.end());
+    } else {
+        putVarint(2 * static_cast<std::uint64_t>(changes));
+        int lastPosition = 0;
+        for (int i = 0; i < numCities; i++) {
+            if (previous[i] != record.route[i]) {
+                putVarint(static_cast<std::uint64_t>(i - lastPosition));
+                putVarint(static_cast<std::uint64_t>(record.route[i]));
+                previous[i] = record.route[i];
+                lastPosition = i;
+            }
+        }
+    }
+    out.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+void SwarmHistoryWriter::flush() {
+    out.flush();
+}
+
+void SwarmHistoryReader::MappingDeleter::operator()(const unsigned char *address) const {
+    ::munmap(const_cast<unsigned char *>(address), bytes);
+}
+
+/**
+ * @brief Memory-map a history file and parse its header.
+ *
+ * The city and particle counts are checked against the file size before anything is
+ * sized from them. A particle's route is allocated at its first full record.
+ *
+ * @param path The history file to open.
+ * @throws std::runtime_error if the file cannot be mapped, is not a version 2 history
+ *         or its header counts do not fit the file.
+ */
+SwarmHistoryReader::SwarmHistoryReader(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open swarm history file " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < 16) {
+        ::close(fd);
+        throw std::runtime_error("Swarm history file is too short: " + path);
+    }
+    mappedBytes = static_cast<std::size_t>(info.st_size);
+    void *address = ::mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Cannot map swarm history file " + path);
+    }
+    mapped = {static_cast<const unsigned char *>(address), MappingDeleter{mappedBytes}};
+    ::madvise(address, mappedBytes, MADV_SEQUENTIAL);
+
+    auto readU32 = [this](std::size_t at) {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            value |= static_cast<std::uint32_t>(mapped.get()[at + i]) << (8 * i);
+        }
+        return value;
+    };
+    if (std::memcmp(mapped.get(), SWARM_HISTORY_MAGIC, 4) != 0 || readU32(4) != SWARM_HISTORY_VERSION) {
+        throw std::runtime_error("Not a version 2 swarm history file: " + path);
+    }
+    // Every city takes 24 header bytes; a particle count above the file size is corrupt
+    std::uint32_t cities = readU32(8);
+    std::uint32_t particles = readU32(12);
+    if (cities > (mappedBytes - 16) / 24 || particles > mappedBytes) {
+        throw std::runtime_error("Swarm history header counts do not fit the file: " + path);
+    }
+    numCities = static_cast<int>(cities);
+    numParticles = static_cast<int>(particles);
+    offset = 16;
+    for (int i = 0; i < numCities; i++) {
+        double x = getDouble();
+        double y = getDouble();
+        double z = getDouble();
+        coordinates.emplace_back(x, y, z);
+    }
+    recordsBegin = offset;
+    rewind();
+}
+
+std::uint64_t SwarmHistoryReader::getVarint() {
+    std::uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= mappedBytes) {
+            throw std::runtime_error("Truncated swarm history record");
+        }
+        unsigned char byte = mapped.get()[offset++];
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Malformed varint in swarm history");
+}
+
+double SwarmHistoryReader::getDouble() {
+    if (offset + 8 > mappedBytes) {
+        throw std::runtime_error("Truncated swarm history record");
+    }
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        bits |= static_cast<std::uint64_t>(mapped.get()[offset + i]) << (8 * i);
+    }
+    offset += 8;
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Decode the next record.
+ *
+ * The returned route views the reader's reconstruction of that particle's route and
+ * stays valid until the next record for the same particle is decoded.
+ *
+ * @param record Receives the decoded record.
+ * @return true if a record was decoded, false at the end of the file.
+ * @throws std::runtime_error if the record is malformed.
+ */
+bool SwarmHistoryReader::next(TraceRecord &record) {
+    if (offset >= mappedBytes) {
+        return false;
+    }
+    int iteration = static_cast<int>(getVarint());
+    std::uint64_t particle = getVarint();
+    if (particle >= static_cast<std::uint64_t>(numParticles)) {
+        throw std::runtime_error("Swarm history record has an invalid particle id");
+    }
+    int particleId = static_cast<int>(particle);
+    currentFitness[particleId] ^= getVarint();
+    double fitness;
+    std::memcpy(&fitness, &currentFitness[particleId], sizeof(fitness));
+    std::uint64_t tag = getVarint();
+    std::vector<int> &route = currentRoutes[particleId];
+    std::uint64_t count = tag >> 1;
+    if (tag & 1) {
+        if (count != static_cast<std::uint64_t>(numCities)) {
+            throw std::runtime_error("Swarm history full record has the wrong length");
+        }
+        route.resize(numCities);
+        for (int i = 0; i < numCities; i++) {
+            route[i] = static_cast<int>(getVarint());
+        }
+    } else {
+        if (route.empty()) {
+            throw std::runtime_error("Swarm history delta record precedes the particle's full record");
+        }
+        std::uint64_t position = 0;
+        for (std::uint64_t k = 0; k < count; k++) {
+            position += getVarint();
+            if (position >= static_cast<std::uint64_t>(numCities)) {
+                throw std::runtime_error("Swarm history delta position out of range");
+            }
+            route[position] = static_cast<int>(getVarint());
+        }
+    }
+    record = TraceRecord{iteration, particleId, fitness, route};
+    return true;
+}
+
+/**
+ * @brief Restart decoding from the first record.
+ */
+void SwarmHistoryReader::rewind() {
+    offset = recordsBegin;
+    currentRoutes.assign(numParticles, {});
+    currentFitness.assign(numParticles, 0);
+}
+
+/**
+ * @brief Write every record of a history in the particle_data.csv layout, header included.
+ *
+ * @param reader The history to convert; it is read from the beginning.
+ * @param particleCsv The stream to write the CSV to.
+ */
+void convertHistoryToCsv(SwarmHistoryReader &reader, std::ostream &particleCsv) {
+    reader.rewind();
+    particleCsv << "Iteration,ParticleID";
+    for (int i = 0; i < reader.getNumCities(); i++) {
+        particleCsv << ",City" << i;
+    }
+    particleCsv << ",Fitness\n";
+    TraceRecord record{};
+    while (reader.next(record)) {
+        writeCsvTraceRow(particleCsv, record);
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file swarmImplementation.cpp
+ * @brief Implementation of the structure-of-arrays Swarm storage.
+ */
+
+#include "swarmDefinition.hpp"
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+/**
+ * @brief Round a per-particle element count up to a whole number of cache lines.
+ */
+std::size_t paddedStride(int count, std::size_t elementBytes) {
+    std::size_t perLine = CacheAlignedAllocator<char>::CACHE_LINE_BYTES / elementBytes;
+    return (static_cast<std::size_t>(count) + perLine - 1) / perLine * perLine;
+}
+
+}
+
+/**
+ * @brief Allocate the arenas for a swarm of the given shape.
+ *
+ * All storage is allocated here once; the update loop only works on spans into
+ * these arenas. Existing contents are discarded.
+ *
+ * @param numParticles The number of particles in the swarm.
+ * @param numCities The number of cities in every route.
+ */
+void Swarm::resize(int numParticles, int numCities) {
+    this->numParticles = numParticles;
+    this->numCities = numCities;
+    routeStride = paddedStride(numCities, sizeof(int));
+    velocityStride = paddedStride(numCities, sizeof(double));
+    visitedStride = paddedStride(numCities, sizeof(unsigned char));
+    randomStride = paddedStride(2 * numCities, sizeof(double));
+
+    std::size_t particles = static_cast<std::size_t>(numParticles);
+    routes.assign(particles * routeStride, 0);
+    bestRoutes.assign(particles * routeStride, 0);
+    candidateRoutes.assign(particles * routeStride, 0);
+    visitedFlags.assign(particles * visitedStride, 0);
+    velocities.assign(particles * velocityStride, 0.0);
+    randomDraws.assign(particles * randomStride, 0.0);
+    fitness.assign(particles, std::numeric_limits<double>::max());
+    bestFitness.assign(particles, std::numeric_limits<double>::max());
+}
+
+/**
+ * @brief Change the number of cities in every route, keeping the particles.
+ *
+ * Each particle keeps the leading positions of its route, personal best and velocity
+ * that still fit; positions added at the end are zero. The scratch arenas are
+ * reallocated and the fitness values are left alone.
+ *
+ * @param numCities The new number of cities.
+ */
+void Swarm::setNumCities(int numCities) {
+    std::size_t newRouteStride = paddedStride(numCities, sizeof(int));
+    std::size_t newVelocityStride = paddedStride(numCities, sizeof(double));
+    std::size_t particles = static_cast<std::size_t>(numParticles);
+    std::size_t kept = static_cast<std::size_t>(std::min(numCities, this->numCities));
+    auto relayout = [&](auto &arena, std::size_t oldStride, std::size_t newStride) {
+        std::remove_reference_t<decltype(arena)> resized(particles * newStride);
+        for (std::size_t p = 0; p < particles; p++) {
+            std::copy_n(arena.begin() + p * oldStride, kept, resized.begin() + p * newStride);
+        }
+        arena.swap(resized);
+    };
+    relayout(routes, routeStride, newRouteStride);
+    relayout(bestRoutes, routeStride, newRouteStride);
+    relayout(velocities, velocityStride, newVelocityStride);
+
+    this->numCities = numCities;
+    routeStride = newRouteStride;
+    velocityStride = newVelocityStride;
+    visitedStride = paddedStride(numCities, sizeof(unsigned char));
+    randomStride = paddedStride(2 * numCities, sizeof(double));
+    candidateRoutes.assign(particles * routeStride, 0);
+    visitedFlags.assign(particles * visitedStride, 0);
+    randomDraws.assign(particles * randomStride, 0.0);
+}
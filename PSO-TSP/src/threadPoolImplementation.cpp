@@ -0,0 +1,188 @@
+/**
+ * @file threadPoolImplementation.cpp
+ * @brief Implementation of the work-stealing ThreadPool used to update the swarm.
+ */
+
+#include "threadPoolDefinition.hpp"
+#include <algorithm>
+
+namespace {
+
+thread_local int workerIndexOfThread = -1;
+
+}
+
+/**
+ * @brief Index of the pool worker running the calling thread.
+ *
+ * @return int The worker index, or -1 if the caller is not a pool worker.
+ */
+int ThreadPool::currentWorker() {
+    return workerIndexOfThread;
+}
+
+/**
+ * @brief Construct the pool and start its worker threads.
+ *
+ * Each worker owns a task deque. Workers pop their own tasks from the back and,
+ * once their deque is empty, steal from the front of the other workers' deques.
+ *
+ * @param numThreads The number of worker threads to keep alive (at least one is started).
+ */
+ThreadPool::ThreadPool(int numThreads) {
+    int count = std::max(1, numThreads);
+    for (int i = 0; i < count; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 0; i < count; i++) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+/**
+ * @brief Stop and join all worker threads.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Take the next task for a worker, stealing from other workers if needed.
+ *
+ * @param workerIndex The index of the calling worker, or -1 for a thread outside the pool.
+ * @param task Receives the task that was taken.
+ * @return true if a task was taken, false if every queue was empty.
+ */
+bool ThreadPool::popTask(int workerIndex, Task &task) {
+    int numQueues = static_cast<int>(queues.size());
+    if (workerIndex >= 0) {
+        WorkQueue &own = *queues[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    int start = workerIndex >= 0 ? workerIndex + 1 : 0;
+    for (int offset = 0; offset < numQueues; offset++) {
+        int victim = (start + offset) % numQueues;
+        if (victim == workerIndex) {
+            continue;
+        }
+        WorkQueue &other = *queues[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = other.tasks.front();
+            other.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Run a chunk of indices, record its batch's first exception and signal completion.
+ *
+ * The batch is only touched under its mutex, since its caller may return and destroy
+ * it as soon as the last chunk is counted.
+ *
+ * @param task The chunk to run.
+ */
+void ThreadPool::runTask(const Task &task) {
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    std::exception_ptr error;
+    try {
+        for (int i = task.begin; i < task.end; i++) {
+            (*task.body)(i);
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    Batch &batch = *task.batch;
+    std::lock_guard<std::mutex> lock(batch.mutex);
+    if (error && !batch.firstError) {
+        batch.firstError = error;
+    }
+    if (--batch.pendingTasks == 0) {
+        batch.done.notify_all();
+    }
+}
+
+/**
+ * @brief Main loop of a worker thread.
+ *
+ * The worker runs tasks until every queue is empty and then sleeps until new
+ * tasks are queued or the pool is stopped.
+ *
+ * @param workerIndex The index of the worker and of the deque it owns.
+ */
+void ThreadPool::workerLoop(int workerIndex) {
+    workerIndexOfThread = workerIndex;
+    Task task;
+    while (true) {
+        if (popTask(workerIndex, task)) {
+            runTask(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this]() { return stopping || queuedTasks.load() > 0; });
+        if (stopping && queuedTasks.load() == 0) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Run body(i) for every i in [0, count) on the pool and wait for completion.
+ *
+ * The range is split into chunks that are dealt round-robin to the worker deques.
+ * The calling thread helps by running queued chunks, of this call or any other,
+ * until none are left. Each call counts its own chunks and keeps its own first
+ * exception, so calls from several threads, or from inside a body, can run at once.
+ * The first exception thrown by body is rethrown here once all chunks have finished.
+ *
+ * @param count The number of indices to process.
+ * @param body The function to call for each index.
+ */
+void ThreadPool::parallelFor(int count, const std::function<void(int)> &body) {
+    if (count <= 0) {
+        return;
+    }
+    int numQueues = static_cast<int>(queues.size());
+    int chunkSize = std::max(1, count / (numQueues * 4));
+    int numChunks = (count + chunkSize - 1) / chunkSize;
+
+    Batch batch;
+    batch.pendingTasks = numChunks;
+    for (int chunk = 0; chunk < numChunks; chunk++) {
+        int begin = chunk * chunkSize;
+        int end = std::min(count, begin + chunkSize);
+        WorkQueue &queue = *queues[chunk % numQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{&body, &batch, begin, end});
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        queuedTasks.fetch_add(numChunks);
+    }
+    wakeCondition.notify_all();
+
+    Task task;
+    while (popTask(workerIndexOfThread, task)) {
+        runTask(task);
+    }
+
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.done.wait(lock, [&batch]() { return batch.pendingTasks == 0; });
+    if (batch.firstError) {
+        std::rethrow_exception(batch.firstError);
+    }
+}
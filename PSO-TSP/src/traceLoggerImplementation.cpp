@@ -0,0 +1,234 @@
+/**
+ * @file traceLoggerImplementation.cpp
+ * @brief Implementation of the asynchronous, ring-buffered particle-trace logger.
+ */
+
+#include "traceLoggerDefinition.hpp"
+#include <chrono>
+#include <climits>
+#include <cstring>
+
+/**
+ * @brief Write one trace record as a row of the particle_data.csv layout.
+ *
+ * @param out The stream to write to.
+ * @param record The record to write.
+ */
+void writeCsvTraceRow(std::ostream &out, const TraceRecord &record) {
+    out << record.iteration << "," << record.particleId;
+    for (int city : record.route) {
+        out << "," << city;
+    }
+    out << "," << record.fitness << "\n";
+}
+
+/**
+ * @brief Create a sink that writes records as particle_data.csv rows.
+ *
+ * @param out The stream to write to; it must outlive the sink.
+ * @return TraceSink The CSV sink.
+ */
+TraceSink makeCsvTraceSink(std::ostream &out) {
+    return [&out](const TraceRecord &record) { writeCsvTraceRow(out, record); };
+}
+
+/**
+ * @brief Construct a ring holding at least capacity records of numCities cities.
+ *
+ * @param capacity The minimum number of records; rounded up to a power of two.
+ * @param numCities The number of cities in every route.
+ */
+TraceRing::TraceRing(std::size_t capacity, int numCities) : numCities(static_cast<std::size_t>(numCities)) {
+    this->capacity = 1;
+    while (this->capacity < capacity) {
+        this->capacity <<= 1;
+    }
+    slotBytes = sizeof(RecordHeader) + this->numCities * sizeof(int);
+    slotBytes = (slotBytes + alignof(RecordHeader) - 1) / alignof(RecordHeader) * alignof(RecordHeader);
+    slots.resize(this->capacity * slotBytes);
+}
+
+/**
+ * @brief Append a record if there is room. Must only be called by the ring's producer.
+ *
+ * @return true if the record was stored, false if the ring is full.
+ */
+bool TraceRing::tryPush(int iteration, int particleId, double fitness, std::span<const int> route) {
+    std::size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == capacity) {
+        return false;
+    }
+    unsigned char *slot = slots.data() + (h & (capacity - 1)) * slotBytes;
+    RecordHeader header{iteration, particleId, fitness};
+    std::memcpy(slot, &header, sizeof(header));
+    std::memcpy(slot + sizeof(header), route.data(), numCities * sizeof(int));
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Read the iteration of the oldest queued record. Consumer side only.
+ *
+ * @param iteration Receives the iteration of the oldest record.
+ * @return true if the ring holds at least one record.
+ */
+bool TraceRing::peekIteration(int &iteration) const {
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+        return false;
+    }
+    RecordHeader header;
+    std::memcpy(&header, slots.data() + (t & (capacity - 1)) * slotBytes, sizeof(header));
+    iteration = header.iteration;
+    return true;
+}
+
+/**
+ * @brief Pass queued records up to and including maxIteration to the sink.
+ *
+ * Must only be called by the ring's consumer.
+ *
+ * @param maxIteration The last iteration whose records may be drained.
+ * @param sink The sink that receives each record.
+ * @return std::size_t The number of records drained.
+ */
+std::size_t TraceRing::drain(int maxIteration, const TraceSink &sink) {
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    std::size_t h = head.load(std::memory_order_acquire);
+    std::size_t drained = 0;
+    while (t != h) {
+        const unsigned char *slot = slots.data() + (t & (capacity - 1)) * slotBytes;
+        RecordHeader header;
+        std::memcpy(&header, slot, sizeof(header));
+        if (header.iteration > maxIteration) {
+            break;
+        }
+        const int *route = reinterpret_cast<const int *>(slot + sizeof(header));
+        sink(TraceRecord{header.iteration, header.particleId, header.fitness, {route, numCities}});
+        t++;
+        drained++;
+        tail.store(t, std::memory_order_release);
+    }
+    return drained;
+}
+
+/**
+ * @brief Create the logger and start its writer thread.
+ *
+ * ringCapacity should cover one full iteration of records for the whole swarm; a
+ * producer then only ever waits for the writer to catch up on finished iterations.
+ *
+ * @param sink Receives every logged record on the writer thread.
+ * @param numProducers The number of producer slots (one ring each).
+ * @param numCities The number of cities in every route.
+ * @param sampling Which particle updates are logged.
+ * @param interval The iteration interval for TraceSampling::EveryKth.
+ * @param ringCapacity The minimum number of records per ring.
+ */
+TraceLogger::TraceLogger(TraceSink sink, int numProducers, int numCities, TraceSampling sampling, int interval,
+                         std::size_t ringCapacity)
+    : sink(std::move(sink)), sampling(sampling), interval(interval < 1 ? 1 : interval) {
+    for (int i = 0; i < numProducers; i++) {
+        rings.push_back(std::make_unique<TraceRing>(ringCapacity, numCities));
+    }
+    writer = std::thread([this]() { writerLoop(); });
+}
+
+/**
+ * @brief Drain every outstanding record and stop the writer thread.
+ */
+TraceLogger::~TraceLogger() {
+    completedIteration.store(INT_MAX);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    writer.join();
+}
+
+/**
+ * @brief Whether an update in this iteration should be logged under the sampling policy.
+ *
+ * @param iteration The current iteration.
+ * @param improvedGlobalBest Whether the update improved the global best.
+ */
+bool TraceLogger::wants(int iteration, bool improvedGlobalBest) const {
+    switch (sampling) {
+        case TraceSampling::Off:
+            return false;
+        case TraceSampling::BestOnly:
+            return improvedGlobalBest;
+        case TraceSampling::EveryKth:
+        default:
+            return iteration % interval == 0;
+    }
+}
+
+/**
+ * @brief Queue a record from a producer. Waits only if the producer's ring is full.
+ *
+ * @param producer The producer slot of the calling thread; each slot must be used by
+ *                 one thread at a time.
+ */
+void TraceLogger::log(int producer, int iteration, int particleId, double fitness, std::span<const int> route) {
+    TraceRing &ring = *rings[producer];
+    if (ring.tryPush(iteration, particleId, fitness, route)) {
+        return;
+    }
+    stalledPushes.fetch_add(1, std::memory_order_relaxed);
+    wakeCondition.notify_one();
+    while (!ring.tryPush(iteration, particleId, fitness, route)) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Mark an iteration as complete so its records can be written.
+ *
+ * @param iteration The iteration that all producers have finished.
+ */
+void TraceLogger::endIteration(int iteration) {
+    completedIteration.store(iteration, std::memory_order_release);
+    wakeCondition.notify_one();
+}
+
+/**
+ * @brief Drain every ring up to the last completed iteration.
+ *
+ * Iterations are written oldest first across all rings, so the output stays
+ * ordered by iteration even when the writer falls behind.
+ */
+void TraceLogger::drainAll() {
+    int maxIteration = completedIteration.load(std::memory_order_acquire);
+    while (true) {
+        int oldest = INT_MAX;
+        for (auto &ring : rings) {
+            int iteration;
+            if (ring->peekIteration(iteration) && iteration < oldest) {
+                oldest = iteration;
+            }
+        }
+        if (oldest == INT_MAX || oldest > maxIteration) {
+            return;
+        }
+        for (auto &ring : rings) {
+            ring->drain(oldest, sink);
+        }
+    }
+}
+
+/**
+ * @brief Writer thread main loop.
+ */
+void TraceLogger::writerLoop() {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!stopping) {
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(2));
+        lock.unlock();
+        drainAll();
+        lock.lock();
+    }
+    lock.unlock();
+    drainAll();
+}
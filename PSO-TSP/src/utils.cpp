@@ -96,4 +96,30 @@ void saveRouteCoordinatesXYZ(const std::vector<int> &bestRoute,
 
     xyzFile.close();
     std::cout << "XYZ coordinates of best route saved to 'best_route_xyz.csv'" << std::endl;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Saves every drone's tour of a multi-drone plan to one CSV file.
+ * 
+ * Each row holds the drone, the position in its tour, the city ID and the city's
+ * coordinates. Every tour ends with its first city again, so it is closed.
+ * 
+ * @param routes One route (sequence of city IDs) per drone.
+ * @param cityList The list of cities with their coordinates.
+ */
+void saveDroneRoutes(const std::vector<std::vector<int>> &routes,
+                     const std::vector<std::shared_ptr<City>> &cityList) {
+    std::ofstream routeFile("../csv/drone_routes.csv");
+    routeFile << "Drone,Order,CityID,X,Y,Z\n";
+    for (std::size_t drone = 0; drone < routes.size(); drone++) {
+        for (std::size_t i = 0; i <= routes[drone].size(); i++) {
+            int cityId = routes[drone][i % routes[drone].size()];
+            routeFile << drone << "," << i << "," << cityId << ","
+                      << std::get<0>(cityList[cityId]->getCoordinates()) << ","
+                      << std::get<1>(cityList[cityId]->getCoordinates()) << ","
+                      << std::get<2>(cityList[cityId]->getCoordinates()) << "\n";
+        }
+    }
+    routeFile.close();
+    std::cout << "Drone routes saved to 'drone_routes.csv'" << std::endl;
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "testHelpers.hpp"
+#include <chrono>
+
+TEST(AnytimeTest, RunsToMaxIterationsByDefault) {
+    PSO pso;
+    PSOConfig config;
+    config.maxIterations = 30;
+    EXPECT_EQ(runSeededSolve(pso, config, 21), StopReason::MaxIterations);
+    EXPECT_EQ(pso.getIterationsRun(), 30);
+}
+
+TEST(AnytimeTest, StallWindowStopsEarly) {
+    PSO pso;
+    PSOConfig config;
+    config.maxIterations = 100000;
+    config.stallIterations = 25;
+    int lastImprovement = 0;
+    pso.setImprovementCallback([&](const BestImprovement &improvement) { lastImprovement = improvement.iteration; });
+    EXPECT_EQ(runSeededSolve(pso, config, 21), StopReason::Stalled);
+    EXPECT_EQ(pso.getIterationsRun(), lastImprovement + 25);
+}
+
+TEST(AnytimeTest, TargetGapStopsAsSoonAsItIsMet) {
+    PSO pso;
+    PSOConfig config;
+    config.maxIterations = 1000;
+    config.targetDistance = 1.0;
+    config.targetGap = 1000.0;
+    EXPECT_EQ(runSeededSolve(pso, config, 21), StopReason::TargetReached);
+    EXPECT_EQ(pso.getIterationsRun(), 0);
+}
+
+TEST(AnytimeTest, TimeBudgetBoundsTheRun) {
+    PSO pso;
+    PSOConfig config;
+    config.maxIterations = 100000000;
+    config.numCities = 200;
+    config.timeBudgetMs = 50.0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(runSeededSolve(pso, config, 21), StopReason::TimeBudget);
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(elapsed, 5000.0);
+    EXPECT_GT(pso.getIterationsRun(), 0);
+}
+
+TEST(AnytimeTest, CallbackStreamsStrictImprovements) {
+    PSO pso;
+    PSOConfig config;
+    config.maxIterations = 200;
+    std::vector<double> seen;
+    std::vector<int> lastRoute;
+    pso.setImprovementCallback([&](const BestImprovement &improvement) {
+        seen.push_back(improvement.fitness);
+        lastRoute.assign(improvement.route.begin(), improvement.route.end());
+    });
+    runSeededSolve(pso, config, 21);
+    ASSERT_FALSE(seen.empty());
+    for (std::size_t i = 1; i < seen.size(); i++) {
+        EXPECT_LT(seen[i], seen[i - 1]);
+    }
+    EXPECT_DOUBLE_EQ(seen.back(), pso.getGlobalBestFitness());
+    EXPECT_EQ(lastRoute, pso.getGlobalBestRoute());
+}
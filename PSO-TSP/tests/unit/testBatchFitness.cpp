@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "batchFitnessDefinition.hpp"
+#include "psoDefinition.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+class BatchFitnessTest : public::testing::Test {
+    protected:
+        static constexpr int NUM_ROUTES = 21;
+        static constexpr int NUM_CITIES = 37;
+        static constexpr std::size_t ROUTE_STRIDE = 48;
+        PSO pso;
+        std::vector<int> routes;
+
+        void SetUp() override {
+            pso.setSeed(8);
+            pso.generateCityCoordinates(NUM_CITIES);
+            routes.assign(NUM_ROUTES * ROUTE_STRIDE, -1);
+            std::mt19937 gen(4);
+            for (int r = 0; r < NUM_ROUTES; r++) {
+                std::iota(routes.begin() + r * ROUTE_STRIDE, routes.begin() + r * ROUTE_STRIDE + NUM_CITIES, 0);
+                std::shuffle(routes.begin() + r * ROUTE_STRIDE, routes.begin() + r * ROUTE_STRIDE + NUM_CITIES, gen);
+            }
+        }
+
+        void expectMatchesCalculateDistance() {
+            std::vector<double> lengths(NUM_ROUTES);
+            evaluateTours(pso.getDistanceMatrix(), routes.data(), ROUTE_STRIDE, NUM_ROUTES, NUM_CITIES,
+                          lengths.data());
+            for (int r = 0; r < NUM_ROUTES; r++) {
+                std::span<const int> route(routes.data() + r * ROUTE_STRIDE, NUM_CITIES);
+                EXPECT_EQ(lengths[r], pso.calculateDistance(route, NUM_CITIES)) << "route " << r;
+            }
+        }
+};
+
+TEST_F(BatchFitnessTest, EveryStorageMatchesCalculateDistanceExactly) {
+    for (DistanceMatrix::Storage storage : {DistanceMatrix::Storage::Dense, DistanceMatrix::Storage::PackedUpper,
+                                            DistanceMatrix::Storage::OnDemand, DistanceMatrix::Storage::Float32,
+                                            DistanceMatrix::Storage::Fixed16}) {
+        pso.setDistanceStorage(storage);
+        pso.initializeDistanceMatrix();
+        expectMatchesCalculateDistance();
+    }
+}
+
+TEST(BatchFitnessSwarmTest, ResyncKeepsFitnessExact) {
+    PSOConfig config;
+    config.numCities = 50;
+    config.numParticles = 13;
+    config.maxIterations = 40;
+    config.fitnessResync = 5;
+    PSO pso(config);
+    pso.setSeed(6);
+    pso.setExecutionMode(ExecutionMode::Serial);
+    pso.setTraceSampling(TraceSampling::Off);
+    pso.generateCityCoordinates(config.numCities);
+    pso.initializeDistanceMatrix();
+    pso.initializeParticles(config.numParticles, config.numCities);
+    for (int p = 0; p < config.numParticles; p++) {
+        EXPECT_EQ(pso.getSwarm().getFitness(p), pso.calculateDistance(pso.getSwarm().getRoute(p), config.numCities));
+        EXPECT_EQ(pso.getSwarm().getBestFitness(p), pso.getSwarm().getFitness(p));
+    }
+
+    std::ofstream discard;
+    pso.beginRun(discard, config.numCities);
+    for (int iteration = 0; iteration <= config.maxIterations; iteration++) {
+        pso.updateParticles(iteration, discard, config.numCities);
+    }
+    pso.endRun();
+    for (int p = 0; p < config.numParticles; p++) {
+        double expected = pso.calculateDistance(pso.getSwarm().getRoute(p), config.numCities);
+        EXPECT_NEAR(pso.getSwarm().getFitness(p), expected, 1e-9 * expected);
+    }
+#ifdef PSO_PROFILING
+    EXPECT_EQ(pso.getProfiler().getCalls(ProfilePhase::Resync), config.maxIterations / config.fitnessResync);
+#endif
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "testHelpers.hpp"
+#include <fstream>
+#include <memory>
+#include <set>
+#include <stdexcept>
+
+TEST(PSOConfigTest, DefaultsMatchCompileTimeValues) {
+    PSOConfig config;
+    EXPECT_EQ(config.numParticles, NUM_PARTICLES);
+    EXPECT_EQ(config.maxIterations, MAX_ITERATIONS);
+    EXPECT_EQ(config.numCities, NUM_CITIES);
+    EXPECT_DOUBLE_EQ(config.inertiaWeight, INERTIA_WEIGHT);
+    EXPECT_NO_THROW(config.validate());
+}
+
+TEST(PSOConfigTest, ParsesCommandLineArguments) {
+    PSOConfig config;
+    EXPECT_TRUE(parseConfigArgument(config, "--particles=16"));
+    EXPECT_TRUE(parseConfigArgument(config, "--iterations=250"));
+    EXPECT_TRUE(parseConfigArgument(config, "--cities=75"));
+    EXPECT_TRUE(parseConfigArgument(config, "--inertia=0.5"));
+    EXPECT_TRUE(parseConfigArgument(config, "--social=2"));
+    EXPECT_FALSE(parseConfigArgument(config, "--seed=3"));
+    EXPECT_EQ(config.numParticles, 16);
+    EXPECT_EQ(config.maxIterations, 250);
+    EXPECT_EQ(config.numCities, 75);
+    EXPECT_DOUBLE_EQ(config.inertiaWeight, 0.5);
+    EXPECT_DOUBLE_EQ(config.socialWeight, 2.0);
+    EXPECT_THROW(parseConfigArgument(config, "--particles=many"), std::invalid_argument);
+}
+
+TEST(PSOConfigTest, InvalidConfigIsRejected) {
+    PSOConfig config;
+    config.numParticles = 0;
+    EXPECT_THROW(PSO pso(config), std::invalid_argument);
+    config = PSOConfig{};
+    config.cognitiveWeight = -1.0;
+    PSO pso;
+    EXPECT_THROW(pso.setConfig(config), std::invalid_argument);
+}
+
+TEST(PSOConfigTest, RunUsesConfiguredShape) {
+    PSOConfig config;
+    config.numCities = 73;
+    config.numParticles = 6;
+    config.maxIterations = 17;
+    PSO pso;
+    std::set<int> iterations;
+    runSeededSolve(pso, config, 11, [&](PSO &p) {
+        p.setTraceSampling(TraceSampling::EveryKth);
+        p.setTraceSink([&](const TraceRecord &record) { iterations.insert(record.iteration); });
+        p.setFitnessCrossCheck(true);
+    });
+
+    EXPECT_EQ(iterations.size(), 17u);
+    EXPECT_TRUE(isPermutation(pso.getGlobalBestRoute(), config.numCities));
+}
+
+TEST(PSOConfigTest, SerialModeMatchesPool) {
+    auto solve = [](ExecutionMode mode) {
+        PSOConfig config;
+        config.numCities = 60;
+        config.numParticles = 8;
+        PSO pso;
+        runSeededSolve(pso, config, 5, [mode](PSO &p) {
+            p.setNumThreads(3);
+            p.setExecutionMode(mode);
+        });
+        return pso.getGlobalBestRoute();
+    };
+    EXPECT_EQ(solve(ExecutionMode::Serial), solve(ExecutionMode::WorkStealingPool));
+}
+
+TEST(PSOConfigTest, FailedCrossCheckThrowsInEveryMode) {
+    // Swapping a huge edge out cancels the short ones from the incremental length
+    PSOConfig config;
+    config.numCities = 40;
+    config.numParticles = 6;
+    config.maxIterations = 20;
+    TSPInstance instance{"cancelling", {}};
+    auto table = std::make_shared<std::vector<double>>(config.numCities * config.numCities);
+    for (int i = 0; i < config.numCities; i++) {
+        instance.cityList.push_back(std::make_shared<City>(i));
+        instance.cityList[i]->setCoordinates(i, 0.0, 0.0);
+        for (int j = 0; j < config.numCities; j++) {
+            (*table)[i * config.numCities + j] = i == j ? 0.0 : (i == 0 || j == 0) && i + j < 20 ? 1e20 : 1.0;
+        }
+    }
+    instance.distances = table;
+
+    for (ExecutionMode mode : {ExecutionMode::Serial, ExecutionMode::WorkStealingPool,
+                               ExecutionMode::ThreadPerParticle}) {
+        PSO pso(config);
+        pso.setSeed(3);
+        pso.setNumThreads(2);
+        pso.setExecutionMode(mode);
+        pso.setTraceSampling(TraceSampling::Off);
+        pso.setFitnessCrossCheck(true);
+        pso.loadInstance(instance);
+        pso.initializeDistanceMatrix();
+        pso.initializeParticles(config.numParticles, config.numCities);
+        std::ofstream discard;
+        EXPECT_THROW(pso.runPSO(discard, config.numCities), std::logic_error) << static_cast<int>(mode);
+    }
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "distanceMatrixDefinition.hpp"
+#include "threadPoolDefinition.hpp"
+#include "psoDefinition.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+class DistanceMatrixTest : public::testing::Test {
+    protected:
+        std::vector<std::shared_ptr<City>> cityList;
+
+        void SetUp() override {
+            std::mt19937 gen(7);
+            std::uniform_real_distribution<> dis(-5.0, 5.0);
+            for (int i = 0; i < 150; i++) {
+                cityList.push_back(std::make_shared<City>(i));
+                cityList[i]->setCoordinates(dis(gen), dis(gen), dis(gen));
+            }
+        }
+};
+
+TEST_F(DistanceMatrixTest, DenseMatchesEuclideanDistance) {
+    DistanceMatrix matrix;
+    matrix.build(cityList, DistanceMatrix::Storage::Dense);
+    for (int i = 0; i < 150; i++) {
+        for (int j = 0; j < 150; j++) {
+            double expected = i == j ? 0.0 : euclideanDistance(cityList[i], cityList[j]);
+            EXPECT_DOUBLE_EQ(matrix(i, j), expected);
+        }
+    }
+}
+
+TEST_F(DistanceMatrixTest, PackedMatchesDenseAndIsSmaller) {
+    ThreadPool pool(3);
+    DistanceMatrix dense, packed;
+    dense.build(cityList, DistanceMatrix::Storage::Dense, &pool);
+    packed.build(cityList, DistanceMatrix::Storage::PackedUpper, &pool);
+    for (int i = 0; i < 150; i++) {
+        for (int j = 0; j < 150; j++) {
+            EXPECT_DOUBLE_EQ(packed(i, j), dense(i, j));
+        }
+    }
+    EXPECT_LT(packed.memoryBytes(), dense.memoryBytes());
+}
+
+TEST_F(DistanceMatrixTest, OnDemandMatchesDenseInLinearMemory) {
+    DistanceMatrix dense, onDemand;
+    dense.build(cityList, DistanceMatrix::Storage::Dense);
+    onDemand.build(cityList, DistanceMatrix::Storage::OnDemand);
+    for (int i = 0; i < 150; i++) {
+        for (int j = 0; j < 150; j++) {
+            EXPECT_NEAR(onDemand(i, j), dense(i, j), 1e-12);
+        }
+    }
+    EXPECT_EQ(onDemand.getStorage(), DistanceMatrix::Storage::OnDemand);
+    EXPECT_LE(onDemand.memoryBytes(), 3 * 152 * sizeof(double));
+}
+
+TEST_F(DistanceMatrixTest, ReducedPrecisionIsWithinHalfAStepAndSmaller) {
+    ThreadPool pool(3);
+    DistanceMatrix dense;
+    dense.build(cityList, DistanceMatrix::Storage::Dense);
+    for (DistanceMatrix::Storage storage : {DistanceMatrix::Storage::Float32, DistanceMatrix::Storage::Fixed32,
+                                            DistanceMatrix::Storage::Fixed16}) {
+        DistanceMatrix reduced;
+        reduced.build(cityList, storage, &pool);
+        ASSERT_TRUE(reduced.isReducedPrecision());
+        // Float32 rounds relative to the distance; the fixed-point tables by half a unit
+        double tolerance = storage == DistanceMatrix::Storage::Float32 ? 1e-6 : reduced.getScale() / 2 + 1e-12;
+        reduced.visit([&](const auto &view) {
+            for (int i = 0; i < 150; i++) {
+                EXPECT_EQ(view(i, i), 0.0);
+                for (int j = 0; j < 150; j++) {
+                    EXPECT_NEAR(view(i, j), dense(i, j), tolerance) << i << " " << j;
+                    EXPECT_EQ(view(i, j), view(j, i));
+                    EXPECT_EQ(reduced(i, j), view(i, j));
+                }
+            }
+        });
+        EXPECT_LT(reduced.memoryBytes(), dense.memoryBytes());
+    }
+    DistanceMatrix fixed16;
+    fixed16.build(cityList, DistanceMatrix::Storage::Fixed16);
+    EXPECT_LE(fixed16.memoryBytes(), (3 * 152 * sizeof(double)) + 150 * 160 * sizeof(std::uint16_t));
+}
+
+TEST_F(DistanceMatrixTest, ExactTourLengthIgnoresTheRounding) {
+    std::vector<int> route(150);
+    std::iota(route.begin(), route.end(), 0);
+    std::shuffle(route.begin(), route.end(), std::mt19937(3));
+    DistanceMatrix dense, fixed16;
+    dense.build(cityList, DistanceMatrix::Storage::Dense);
+    fixed16.build(cityList, DistanceMatrix::Storage::Fixed16);
+    double expected = dense.exactTourLength(route);
+    EXPECT_NEAR(fixed16.exactTourLength(route), expected, 1e-9);
+    double rounded = 0.0;
+    for (int k = 0; k < 150; k++) {
+        rounded += fixed16(route[k], route[(k + 1) % 150]);
+    }
+    EXPECT_NEAR(rounded, expected, 150 * fixed16.getScale() / 2);
+}
+
+TEST(ReducedPrecisionSolveTest, BestRouteIsRescoredExactly) {
+    PSOConfig config;
+    config.numCities = 80;
+    config.numParticles = 10;
+    config.maxIterations = 30;
+    PSO pso(config);
+    pso.setSeed(17);
+    pso.setExecutionMode(ExecutionMode::Serial);
+    pso.setTraceSampling(TraceSampling::Off);
+    pso.setDistanceStorage(DistanceMatrix::Storage::Fixed16);
+    pso.setFitnessCrossCheck(true);
+    pso.generateCityCoordinates(config.numCities);
+    pso.initializeDistanceMatrix();
+    pso.initializeParticles(config.numParticles, config.numCities);
+    std::ofstream discard;
+    pso.runPSO(discard, config.numCities);
+
+    DistanceMatrix dense;
+    dense.build(pso.getCityList(), DistanceMatrix::Storage::Dense);
+    std::vector<int> route = pso.getGlobalBestRoute();
+    EXPECT_NEAR(pso.getExactBestFitness(), dense.exactTourLength(route), 1e-9);
+    EXPECT_NEAR(pso.getGlobalBestFitness(), pso.getExactBestFitness(),
+                config.numCities * pso.getDistanceMatrix().getScale() / 2 + 1e-6);
+}
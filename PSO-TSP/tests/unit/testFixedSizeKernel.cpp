@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+#include "fixedSizeKernelDefinition.hpp"
+#include "psoDefinition.hpp"
+#include "tourDeltaDefinition.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+TEST(FixedSizeKernelTest, CoversOnlyTheSmallSizes) {
+    for (int numCities : {SmallTourKernel::MIN_CITIES - 1, SmallTourKernel::MIN_CITIES, 17,
+                          SmallTourKernel::MAX_CITIES, SmallTourKernel::MAX_CITIES + 1}) {
+        PSO pso;
+        pso.setSeed(2);
+        pso.generateCityCoordinates(numCities);
+        pso.initializeDistanceMatrix();
+        std::unique_ptr<SmallTourKernel> kernel = makeSmallTourKernel(pso.getDistanceMatrix());
+        bool inRange = numCities >= SmallTourKernel::MIN_CITIES && numCities <= SmallTourKernel::MAX_CITIES;
+        ASSERT_EQ(kernel != nullptr, inRange) << numCities;
+        if (kernel) {
+            EXPECT_EQ(kernel->numCities(), numCities);
+        }
+    }
+}
+
+TEST(FixedSizeKernelTest, StepsMatchTheGenericUpdate) {
+    constexpr int NUM_CITIES = 23;
+    PSO pso;
+    pso.setSeed(5);
+    pso.setDistanceStorage(DistanceMatrix::Storage::PackedUpper);
+    pso.generateCityCoordinates(NUM_CITIES);
+    pso.initializeDistanceMatrix();
+    std::unique_ptr<SmallTourKernel> kernel = makeSmallTourKernel(pso.getDistanceMatrix());
+    ASSERT_NE(kernel, nullptr);
+
+    std::mt19937 gen(11);
+    std::vector<int> route(NUM_CITIES);
+    std::iota(route.begin(), route.end(), 0);
+    std::uniform_real_distribution<double> speed(-3.0 * NUM_CITIES, 3.0 * NUM_CITIES);
+    for (int trial = 0; trial < 20; trial++) {
+        std::shuffle(route.begin(), route.end(), gen);
+        double length = pso.getDistanceMatrix().visit([&](const auto &distances) {
+            double total = 0.0;
+            for (int i = 0; i < NUM_CITIES - 1; i++) {
+                total += distances(route[i], route[i + 1]);
+            }
+            return total + distances(route[NUM_CITIES - 1], route[0]);
+        });
+        EXPECT_EQ(kernel->tourLength(route), length);
+
+        std::vector<double> velocity(NUM_CITIES);
+        std::generate(velocity.begin(), velocity.end(), [&] {return speed(gen);});
+        std::vector<int> candidate(NUM_CITIES);
+        double candidateLength = kernel->applySwaps(velocity, route, candidate, length);
+
+        std::vector<int> expected = route;
+        double expectedLength = pso.getDistanceMatrix().visit([&](const auto &distances) {
+            IncrementalTour tour(distances, std::span<int>(expected), length);
+            for (int i = 0; i < NUM_CITIES; i++) {
+                tour.swap(i, static_cast<int>(std::abs(velocity[i])) % NUM_CITIES);
+            }
+            return tour.getLength();
+        });
+        EXPECT_EQ(candidate, expected);
+        EXPECT_EQ(candidateLength, expectedLength);
+    }
+}
+
+namespace {
+
+/**
+ * @brief Run a seeded serial solve and return its best fitness, filling the best route.
+ */
+double solve(const PSOConfig &config, bool fixedSizeKernels, std::vector<int> &bestRoute) {
+    PSO pso(config);
+    pso.setSeed(31);
+    pso.setExecutionMode(ExecutionMode::Serial);
+    pso.setTraceSampling(TraceSampling::Off);
+    pso.setFixedSizeKernels(fixedSizeKernels);
+    pso.setFitnessCrossCheck(true);
+    pso.generateCityCoordinates(config.numCities);
+    pso.initializeDistanceMatrix();
+    pso.initializeParticles(config.numParticles, config.numCities);
+    std::ofstream discard;
+    pso.runPSO(discard, config.numCities);
+    bestRoute = pso.getGlobalBestRoute();
+    return pso.getGlobalBestFitness();
+}
+
+}
+
+TEST(FixedSizeKernelTest, SeededRunIsUnchangedByTheKernels) {
+    PSOConfig config;
+    config.numCities = 16;
+    config.numParticles = 9;
+    config.maxIterations = 60;
+    std::vector<int> kernelRoute;
+    std::vector<int> genericRoute;
+    double kernelFitness = solve(config, true, kernelRoute);
+    double genericFitness = solve(config, false, genericRoute);
+    ASSERT_EQ(kernelRoute.size(), static_cast<std::size_t>(config.numCities));
+#ifndef __FMA__
+    // With FMA the compiler may contract the two velocity updates differently
+    EXPECT_EQ(kernelRoute, genericRoute);
+    EXPECT_EQ(kernelFitness, genericFitness);
+#endif
+}
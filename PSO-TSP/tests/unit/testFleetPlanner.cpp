@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "fleetPlannerDefinition.hpp"
+#include "utils.hpp"
+#include "testHelpers.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+PSOConfig droneConfig() {
+    PSOConfig config;
+    config.numCities = 80;
+    config.numParticles = 8;
+    config.maxIterations = 60;
+    return config;
+}
+
+/**
+ * @brief Four tight groups of waypoints, one holding far more than the others.
+ */
+std::vector<std::shared_ptr<City>> skewedCities() {
+    std::vector<std::shared_ptr<City>> cityList;
+    std::mt19937 gen(5);
+    std::normal_distribution<> spread(0.0, 0.3);
+    const double centres[4][2] = {{0.0, 0.0}, {10.0, 0.0}, {0.0, 10.0}, {10.0, 10.0}};
+    const int sizes[4] = {50, 6, 6, 6};
+    for (int group = 0; group < 4; group++) {
+        for (int i = 0; i < sizes[group]; i++) {
+            int id = static_cast<int>(cityList.size());
+            cityList.push_back(std::make_shared<City>(id));
+            cityList.back()->setCoordinates(centres[group][0] + spread(gen), centres[group][1] + spread(gen), 0.0);
+        }
+    }
+    return cityList;
+}
+
+}
+
+class FleetPlannerTest : public::testing::TestWithParam<PartitionMethod> {};
+
+TEST_P(FleetPlannerTest, EveryWaypointIsFlownOnce) {
+    FleetConfig fleetConfig;
+    fleetConfig.numDrones = 4;
+    fleetConfig.partition = GetParam();
+    FleetPlanner planner(droneConfig(), fleetConfig, 21);
+    planner.run();
+    ASSERT_EQ(planner.size(), 4);
+
+    PSO reference;
+    reference.setSeed(21);
+    reference.generateCityCoordinates(80);
+    std::vector<std::shared_ptr<City>> cityList = reference.getCityList();
+    std::vector<int> visited;
+    double makespan = 0.0, total = 0.0;
+    std::vector<DroneRoute> routes = planner.getRoutes();
+    for (int d = 0; d < 4; d++) {
+        EXPECT_GE(static_cast<int>(routes[d].route.size()), FleetPlanner::MIN_WAYPOINTS);
+        EXPECT_NEAR(routes[d].length, tourLength(routes[d].route, cityList), 1e-9);
+        for (int city : routes[d].route) {
+            EXPECT_EQ(planner.getAssignment()[city], d);
+        }
+        visited.insert(visited.end(), routes[d].route.begin(), routes[d].route.end());
+        makespan = std::max(makespan, routes[d].length);
+        total += routes[d].length;
+    }
+    std::sort(visited.begin(), visited.end());
+    std::vector<int> expected(80);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(visited, expected);
+    EXPECT_DOUBLE_EQ(planner.getMakespan(), makespan);
+    EXPECT_NEAR(planner.getTotalLength(), total, 1e-9);
+}
+
+TEST_P(FleetPlannerTest, SeededPlansAreReproducible) {
+    FleetConfig fleetConfig;
+    fleetConfig.numDrones = 3;
+    fleetConfig.partition = GetParam();
+    FleetPlanner first(droneConfig(), fleetConfig, 8);
+    FleetPlanner second(droneConfig(), fleetConfig, 8);
+    first.run();
+    second.run();
+    EXPECT_EQ(first.getAssignment(), second.getAssignment());
+    std::vector<DroneRoute> a = first.getRoutes();
+    std::vector<DroneRoute> b = second.getRoutes();
+    for (int d = 0; d < 3; d++) {
+        EXPECT_EQ(a[d].route, b[d].route);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Partitions, FleetPlannerTest,
+                         ::testing::Values(PartitionMethod::Clusters, PartitionMethod::Balanced));
+
+TEST(FleetPlannerBalanceTest, BalancedPartitionCapsEveryDrone) {
+    FleetConfig fleetConfig;
+    fleetConfig.numDrones = 4;
+    fleetConfig.partition = PartitionMethod::Balanced;
+    FleetPlanner planner(droneConfig(), fleetConfig, 3);
+    planner.setCities(skewedCities());
+    planner.initialize();
+    std::vector<int> counts(4, 0);
+    for (int drone : planner.getAssignment()) {
+        counts[drone]++;
+    }
+    for (int count : counts) {
+        EXPECT_LE(count, 17);
+        EXPECT_GE(count, FleetPlanner::MIN_WAYPOINTS);
+    }
+}
+
+TEST(FleetPlannerBalanceTest, RebalancingShortensTheLongestTour) {
+    FleetConfig fleetConfig;
+    fleetConfig.numDrones = 4;
+    fleetConfig.partition = PartitionMethod::Clusters;
+    FleetPlanner planner(droneConfig(), fleetConfig, 3);
+    planner.setCities(skewedCities());
+    planner.initialize();
+    double before = planner.getMakespan();
+    int moved = planner.rebalance();
+    EXPECT_GT(moved, 0);
+    EXPECT_LT(planner.getMakespan(), before);
+    // Later rounds never make the plan worse
+    for (int round = 0; round < 3; round++) {
+        double previous = planner.getMakespan();
+        planner.rebalance();
+        EXPECT_LE(planner.getMakespan(), previous + 1e-9);
+    }
+    EXPECT_EQ(planner.getRoundsRun(), 4);
+}
+
+TEST(FleetPlannerBalanceTest, RejectsTooFewWaypointsAndParsesArguments) {
+    FleetConfig fleetConfig;
+    fleetConfig.numDrones = 5;
+    PSOConfig config = droneConfig();
+    config.numCities = 14;
+    FleetPlanner planner(config, fleetConfig, 1);
+    EXPECT_THROW(planner.initialize(), std::invalid_argument);
+    fleetConfig.numDrones = 0;
+    EXPECT_THROW(FleetPlanner(config, fleetConfig, 1), std::invalid_argument);
+
+    FleetConfig parsed;
+    EXPECT_TRUE(parseFleetArgument(parsed, "--drones=6"));
+    EXPECT_TRUE(parseFleetArgument(parsed, "--partition=clusters"));
+    EXPECT_TRUE(parseFleetArgument(parsed, "--rebalance-rounds=2"));
+    EXPECT_TRUE(parseFleetArgument(parsed, "--rebalance-iterations=30"));
+    EXPECT_FALSE(parseFleetArgument(parsed, "--islands=2"));
+    EXPECT_EQ(parsed.numDrones, 6);
+    EXPECT_EQ(parsed.partition, PartitionMethod::Clusters);
+    EXPECT_EQ(parsed.rebalanceRounds, 2);
+    EXPECT_EQ(parsed.rebalanceIterations, 30);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "globalBestDefinition.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(GlobalBestTest, OnlyImprovementsArePublished) {
+    GlobalBest best;
+    best.reset(3);
+    std::vector<int> a = {0, 1, 2}, b = {2, 1, 0};
+    EXPECT_TRUE(best.offer(5.0, a));
+    EXPECT_FALSE(best.offer(6.0, b));
+    EXPECT_DOUBLE_EQ(best.getFitness(), 5.0);
+    EXPECT_EQ(best.getRoute(), a);
+    EXPECT_TRUE(best.offer(4.0, b));
+    EXPECT_EQ(best.getRoute(), b);
+}
+
+TEST(GlobalBestTest, ReadersSeeConsistentSnapshots) {
+    constexpr int numCities = 64;
+    GlobalBest best;
+    best.reset(numCities);
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    // Every published route is filled with a single value k and has fitness 100000 - k,
+    // so a reader can tell whether route and fitness belong together.
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&]() {
+            std::vector<int> route(numCities);
+            while (!done.load()) {
+                double fitness = best.snapshot(route);
+                if (fitness > 100000) {
+                    continue;
+                }
+                int k = 100000 - static_cast<int>(fitness);
+                for (int city : route) {
+                    if (city != k) {
+                        torn++;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; w++) {
+        writers.emplace_back([&, w]() {
+            std::vector<int> route(numCities);
+            for (int k = w; k < 20000; k += 2) {
+                std::fill(route.begin(), route.end(), k);
+                best.offer(100000.0 - k, route);
+            }
+        });
+    }
+    for (auto &t : writers) {
+        t.join();
+    }
+    done = true;
+    for (auto &t : readers) {
+        t.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_DOUBLE_EQ(best.getFitness(), 100000.0 - 19999);
+}
@@ -0,0 +1,67 @@
+#ifndef TEST_HELPERS_HPP
+#define TEST_HELPERS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "psoDefinition.hpp"
+#include "utils.hpp"
+
+/**
+ * @brief Set a solver up for a reproducible run on its own generated instance.
+ *
+ * The run is serial and writes no trace. `setup`, if given, runs after those defaults
+ * and before the instance is built, so it can override them or set the distance
+ * storage, a cache or callbacks.
+ */
+inline void prepareSeededSolve(PSO &pso, const PSOConfig &config, std::uint64_t seed,
+                               const std::function<void(PSO &)> &setup = {}) {
+    pso.setConfig(config);
+    pso.setSeed(seed);
+    pso.setExecutionMode(ExecutionMode::Serial);
+    pso.setTraceSampling(TraceSampling::Off);
+    if (setup) {
+        setup(pso);
+    }
+    pso.generateCityCoordinates(config.numCities);
+    pso.initializeDistanceMatrix();
+    pso.initializeParticles(config.numParticles, config.numCities);
+}
+
+/**
+ * @brief Prepare a seeded solve as `prepareSeededSolve` does and run it.
+ */
+inline StopReason runSeededSolve(PSO &pso, const PSOConfig &config, std::uint64_t seed,
+                                 const std::function<void(PSO &)> &setup = {}) {
+    prepareSeededSolve(pso, config, seed, setup);
+    std::ofstream discard;
+    return pso.runPSO(discard, config.numCities);
+}
+
+inline std::vector<int> identityRoute(int numCities) {
+    std::vector<int> route(numCities);
+    std::iota(route.begin(), route.end(), 0);
+    return route;
+}
+
+inline bool isPermutation(std::vector<int> route, int numCities) {
+    std::sort(route.begin(), route.end());
+    return route == identityRoute(numCities);
+}
+
+/**
+ * @brief Length of a closed tour on the cities' Euclidean distances.
+ */
+inline double tourLength(const std::vector<int> &route, const std::vector<std::shared_ptr<City>> &cityList) {
+    double length = 0.0;
+    for (std::size_t i = 0; i < route.size(); i++) {
+        length += euclideanDistance(cityList[route[i]], cityList[route[(i + 1) % route.size()]]);
+    }
+    return length;
+}
+
+#endif
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "instanceDefinition.hpp"
+#include "psoDefinition.hpp"
+#include <cstdio>
+#include <fstream>
+
+class InstanceTest : public::testing::Test {
+    protected:
+        std::vector<std::string> paths;
+
+        std::string write(const std::string &name, const std::string &text) {
+            std::ofstream(name) << text;
+            paths.push_back(name);
+            return name;
+        }
+
+        void TearDown() override {
+            for (const std::string &path : paths) {
+                std::remove(path.c_str());
+            }
+        }
+};
+
+TEST_F(InstanceTest, LoadsEuc2dWithRoundedDistances) {
+    std::string path = write("instance_test.tsp",
+                             "NAME : square\nTYPE : TSP\nDIMENSION : 4\nEDGE_WEIGHT_TYPE : EUC_2D\n"
+                             "NODE_COORD_SECTION\n1 0 0\n2 3.0 0\n3 3 4.2\n4 0e0 4\nEOF\n");
+    TSPInstance instance = loadInstance(path);
+    EXPECT_EQ(instance.name, "square");
+    ASSERT_EQ(instance.size(), 4);
+    EXPECT_DOUBLE_EQ(std::get<1>(instance.cityList[2]->getCoordinates()), 4.2);
+    ASSERT_TRUE(instance.distances);
+    const std::vector<double> &table = *instance.distances;
+    EXPECT_EQ(table[0 * 4 + 2], 5.0);  // sqrt(9 + 17.64) = 5.16 rounds to 5
+    EXPECT_EQ(table[1 * 4 + 2], 4.0);
+    EXPECT_EQ(table[3 * 4 + 3], 0.0);
+    EXPECT_EQ(instance.tourLength({0, 1, 2, 3}), 3.0 + 4.0 + 3.0 + 4.0);
+    EXPECT_EQ(instance.optimum, 0.0);
+}
+
+TEST_F(InstanceTest, KnownOptimumNeedsAWholeTour) {
+    std::string path = write("instance_test.tsp",
+                             "NAME : square\nTYPE : TSP\nDIMENSION : 4\nEDGE_WEIGHT_TYPE : EUC_2D\n"
+                             "NODE_COORD_SECTION\n1 0 0\n2 3 0\n3 3 4\n4 0 4\nEOF\n");
+    write("instance_test.opt.tour", "NAME : square.opt.tour\nTYPE : TOUR\nDIMENSION : 4\nTOUR_SECTION\n1 2 3 4\n-1\nEOF\n");
+    EXPECT_EQ(loadInstance(path).optimum, 14.0);
+
+    // Repeated, out-of-range or missing cities leave the optimum unknown
+    for (const auto &tour : {"DIMENSION : 4\nTOUR_SECTION\n1 2 2 4\n-1\n",
+                             "DIMENSION : 4\nTOUR_SECTION\n0 1 2 3\n-1\n",
+                             "TOUR_SECTION\n1 2 3 5\n-1\n",
+                             "DIMENSION : 3\nTOUR_SECTION\n1 2 3\n-1\n",
+                             "DIMENSION : 4\nTOUR_SECTION\n1 2 3\n-1\n"}) {
+        write("instance_test.opt.tour", tour);
+        EXPECT_EQ(loadInstance(path).optimum, 0.0) << tour;
+    }
+    EXPECT_THROW(loadTsplibTour("instance_test.opt.tour"), std::runtime_error);
+}
+
+TEST_F(InstanceTest, LoadsEveryExplicitLayout) {
+    const std::vector<double> expected = {0, 1, 2, 3, 1, 0, 4, 5, 2, 4, 0, 6, 3, 5, 6, 0};
+    const std::vector<std::pair<std::string, std::string>> layouts = {
+        {"FULL_MATRIX", "0 1 2 3\n1 0 4 5\n2 4 0 6\n3 5 6 0"},
+        {"UPPER_ROW", "1 2 3\n4 5\n6"},
+        {"LOWER_ROW", "1\n2 4\n3 5 6"},
+        {"UPPER_DIAG_ROW", "0 1 2 3 0 4 5 0 6 0"},
+        {"LOWER_DIAG_ROW", "0 1 0 2 4 0 3 5 6 0"},
+        {"UPPER_COL", "1 2 4 3 5 6"},
+    };
+    for (const auto &[format, weights] : layouts) {
+        std::string path = write("instance_test.tsp", "NAME: explicit\nTYPE: TSP\nDIMENSION: 4\n"
+                                                      "EDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: " + format +
+                                                      "\nEDGE_WEIGHT_SECTION\n" + weights + "\nEOF\n");
+        TSPInstance instance = loadTsplibInstance(path);
+        ASSERT_TRUE(instance.distances) << format;
+        EXPECT_EQ(*instance.distances, expected) << format;
+    }
+}
+
+TEST_F(InstanceTest, LoadsCsvWaypoints) {
+    std::string path = write("instance_test.csv", "City,X,Y,Z\r\n0,0.5,-1.25,1e-3\r\n1, 2,3 ,4\r\n2,-7,8.0,0\r\n");
+    TSPInstance instance = loadInstance(path);
+    ASSERT_EQ(instance.size(), 3);
+    EXPECT_FALSE(instance.distances);
+    auto [x, y, z] = instance.cityList[0]->getCoordinates();
+    EXPECT_DOUBLE_EQ(x, 0.5);
+    EXPECT_DOUBLE_EQ(y, -1.25);
+    EXPECT_DOUBLE_EQ(z, 1e-3);
+    EXPECT_DOUBLE_EQ(std::get<2>(instance.cityList[1]->getCoordinates()), 4.0);
+}
+
+TEST_F(InstanceTest, RejectsMalformedFiles) {
+    EXPECT_THROW(loadInstance("does_not_exist.tsp"), std::runtime_error);
+    std::string path = write("instance_test.tsp", "NAME: bad\nTYPE: TSP\nDIMENSION: 2\nEDGE_WEIGHT_TYPE: GEO\n");
+    EXPECT_THROW(loadTsplibInstance(path), std::runtime_error);
+    path = write("instance_test.csv", "City,X,Y,Z\n0,1,2,oops\n");
+    EXPECT_THROW(loadCsvInstance(path), std::runtime_error);
+}
+
+TEST(InstanceSolveTest, Berlin52ReportsItsKnownOptimum) {
+    TSPInstance instance = loadInstance(PSO_INSTANCE_DIR "/berlin52.tsp");
+    ASSERT_EQ(instance.size(), 52);
+    EXPECT_EQ(instance.optimum, 7542.0);
+
+    PSOConfig config;
+    config.numCities = instance.size();
+    config.numParticles = 16;
+    config.maxIterations = 50;
+    config.memeticMode = MemeticMode::GlobalBest;
+    PSO pso(config);
+    pso.setSeed(3);
+    pso.setExecutionMode(ExecutionMode::Serial);
+    pso.setTraceSampling(TraceSampling::Off);
+    pso.loadInstance(instance);
+    pso.initializeDistanceMatrix();
+    EXPECT_EQ(pso.getDistanceMatrix()(0, 48), (*instance.distances)[48]);
+    pso.initializeParticles(config.numParticles, config.numCities);
+    std::ofstream discard;
+    pso.runPSO(discard, config.numCities);
+
+    EXPECT_EQ(pso.getKnownOptimum(), 7542.0);
+    EXPECT_EQ(pso.getExactBestFitness(), instance.tourLength(pso.getGlobalBestRoute()));
+    double gap = optimalityGap(pso.getExactBestFitness(), pso.getKnownOptimum());
+    EXPECT_GE(gap, 0.0);
+    EXPECT_LT(gap, 0.5);
+}
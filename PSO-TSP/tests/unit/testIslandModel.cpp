@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "islandModelDefinition.hpp"
+#include "testHelpers.hpp"
+#include <stdexcept>
+
+namespace {
+
+PSOConfig smallConfig() {
+    PSOConfig config;
+    config.numCities = 50;
+    config.numParticles = 6;
+    config.maxIterations = 60;
+    return config;
+}
+
+}
+
+TEST(IslandModelTest, ElitesAreBestFirstAndInjectionReplacesTheWorst) {
+    PSO pso;
+    pso.setSeed(4);
+    pso.generateCityCoordinates(30);
+    pso.initializeDistanceMatrix();
+    pso.initializeParticles(8, 30);
+
+    std::vector<std::vector<int>> elites = pso.getEliteRoutes(3);
+    ASSERT_EQ(elites.size(), 3u);
+    EXPECT_LE(pso.calculateDistance(elites[0], 30), pso.calculateDistance(elites[1], 30));
+    EXPECT_LE(pso.calculateDistance(elites[1], 30), pso.calculateDistance(elites[2], 30));
+    EXPECT_DOUBLE_EQ(pso.calculateDistance(elites[0], 30), pso.getGlobalBestFitness());
+
+    const Swarm &swarm = pso.getSwarm();
+    int worst = 0;
+    for (int p = 1; p < swarm.size(); p++) {
+        if (swarm.getFitness(p) > swarm.getFitness(worst)) {
+            worst = p;
+        }
+    }
+    pso.injectRoutes({elites[0]}, 30);
+    std::span<const int> injected = swarm.getRoute(worst);
+    EXPECT_EQ(std::vector<int>(injected.begin(), injected.end()), elites[0]);
+    EXPECT_DOUBLE_EQ(swarm.getFitness(worst), pso.getGlobalBestFitness());
+}
+
+TEST(IslandModelTest, PolishedGlobalBestIsTheFirstElite) {
+    PSOConfig config;
+    config.numCities = 80;
+    config.numParticles = 8;
+    config.maxIterations = 20;
+    config.memeticMode = MemeticMode::GlobalBest;
+    PSO pso;
+    runSeededSolve(pso, config, 6);
+
+    std::vector<std::vector<int>> elites = pso.getEliteRoutes(3);
+    ASSERT_EQ(elites.size(), 3u);
+    EXPECT_EQ(elites[0], pso.getGlobalBestRoute());
+    EXPECT_NE(elites[1], elites[0]);
+    EXPECT_LE(pso.calculateDistance(elites[1], 80), pso.calculateDistance(elites[2], 80));
+}
+
+TEST(IslandModelTest, IslandsShareOneInstance) {
+    IslandConfig islandConfig;
+    islandConfig.numIslands = 3;
+    IslandModel model(smallConfig(), islandConfig, 99);
+    model.initialize();
+    ASSERT_EQ(model.size(), 3);
+    EXPECT_EQ(&model.getIsland(0).getDistanceMatrix(), &model.getIsland(2).getDistanceMatrix());
+    EXPECT_EQ(model.getIsland(1).getCityList(), model.getIsland(0).getCityList());
+    EXPECT_NE(model.getIsland(0).getSeed(), model.getIsland(1).getSeed());
+
+    PSO single;
+    single.setSeed(99);
+    single.generateCityCoordinates(50);
+    EXPECT_EQ(single.getCityList()[7]->getCoordinates(), model.getCityList()[7]->getCoordinates());
+}
+
+TEST(IslandModelTest, RunsAreReproducibleForEveryTopology) {
+    for (MigrationTopology topology : {MigrationTopology::Ring, MigrationTopology::FullyConnected}) {
+        IslandConfig islandConfig;
+        islandConfig.numIslands = 4;
+        islandConfig.migrationInterval = 7;
+        islandConfig.topology = topology;
+
+        auto solve = [&]() {
+            IslandModel model(smallConfig(), islandConfig, 123);
+            model.initialize();
+            EXPECT_EQ(model.run(), StopReason::MaxIterations);
+            EXPECT_EQ(model.getIterationsRun(), 60);
+            return model.getBestRoute();
+        };
+        std::vector<int> first = solve();
+        EXPECT_TRUE(isPermutation(first, 50));
+        EXPECT_EQ(solve(), first);
+    }
+}
+
+TEST(IslandModelTest, BestIslandHoldsTheLowestDistance) {
+    IslandConfig islandConfig;
+    islandConfig.numIslands = 3;
+    islandConfig.topology = MigrationTopology::FullyConnected;
+    IslandModel model(smallConfig(), islandConfig, 5);
+    model.initialize();
+    model.run();
+    for (int i = 0; i < model.size(); i++) {
+        EXPECT_LE(model.getBestFitness(), model.getIsland(i).getGlobalBestFitness());
+    }
+}
+
+TEST(IslandModelTest, ParsesAndValidatesIslandArguments) {
+    IslandConfig config;
+    EXPECT_TRUE(parseIslandArgument(config, "--islands=6"));
+    EXPECT_TRUE(parseIslandArgument(config, "--migration=full"));
+    EXPECT_TRUE(parseIslandArgument(config, "--migration-interval=25"));
+    EXPECT_TRUE(parseIslandArgument(config, "--migrants=3"));
+    EXPECT_FALSE(parseIslandArgument(config, "--seed=1"));
+    EXPECT_EQ(config.numIslands, 6);
+    EXPECT_EQ(config.topology, MigrationTopology::FullyConnected);
+    EXPECT_EQ(config.migrationInterval, 25);
+    EXPECT_EQ(config.numMigrants, 3);
+    config.migrationInterval = 0;
+    EXPECT_THROW(IslandModel(smallConfig(), config, 1), std::invalid_argument);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "kdTreeDefinition.hpp"
+#include "localSearchDefinition.hpp"
+#include "psoDefinition.hpp"
+#include "threadPoolDefinition.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+class KdTreeTest : public::testing::Test {
+    protected:
+        std::vector<std::shared_ptr<City>> cityList;
+
+        void SetUp() override {
+            std::mt19937 gen(11);
+            std::uniform_real_distribution<> dis(-5.0, 5.0);
+            for (int i = 0; i < 500; i++) {
+                cityList.push_back(std::make_shared<City>(i));
+                // Flat in z for the first half, to exercise degenerate splits
+                cityList[i]->setCoordinates(dis(gen), dis(gen), i < 250 ? 0.0 : dis(gen));
+            }
+        }
+};
+
+TEST_F(KdTreeTest, NearestMatchesBruteForce) {
+    KdTree tree;
+    tree.build(cityList);
+    ASSERT_EQ(tree.size(), 500);
+    std::vector<int> nearest;
+    for (int city = 0; city < 500; city += 7) {
+        auto [x, y, z] = cityList[city]->getCoordinates();
+        tree.nearest(x, y, z, 10, nearest, city);
+
+        std::vector<int> expected(500);
+        std::iota(expected.begin(), expected.end(), 0);
+        expected.erase(expected.begin() + city);
+        std::sort(expected.begin(), expected.end(), [&](int a, int b) {
+            return euclideanDistance(cityList[city], cityList[a]) < euclideanDistance(cityList[city], cityList[b]);
+        });
+        expected.resize(10);
+        EXPECT_EQ(nearest, expected);
+    }
+
+    tree.nearest(0.0, 0.0, 0.0, 1000, nearest);
+    EXPECT_EQ(nearest.size(), 500u);
+}
+
+TEST_F(KdTreeTest, CandidateListsMatchTheMatrixScan) {
+    DistanceMatrix matrix;
+    matrix.build(cityList, DistanceMatrix::Storage::Dense);
+    NeighbourLists fromMatrix, fromTree, fromPool;
+    fromMatrix.build(matrix, 8);
+    fromTree.build(cityList, 8);
+    ThreadPool pool(3);
+    fromPool.build(cityList, 8, &pool);
+    for (int city = 0; city < 500; city++) {
+        auto expected = fromMatrix[city];
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), fromTree[city].begin(), fromTree[city].end()));
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), fromPool[city].begin(), fromPool[city].end()));
+    }
+}
+
+TEST(OnDemandDistanceTest, MemeticSolveOnALargeInstanceWithoutATable) {
+    PSOConfig config;
+    config.numCities = 5000;
+    config.numParticles = 2;
+    config.maxIterations = 2;
+    config.memeticMode = MemeticMode::GlobalBest;
+    PSO pso(config);
+    pso.setSeed(9);
+    pso.setExecutionMode(ExecutionMode::Serial);
+    pso.setTraceSampling(TraceSampling::Off);
+    pso.setDistanceStorage(DistanceMatrix::Storage::OnDemand);
+    pso.setFitnessCrossCheck(true);
+    pso.generateCityCoordinates(config.numCities);
+    pso.initializeDistanceMatrix();
+    EXPECT_LT(pso.getDistanceMatrix().memoryBytes(), 4u * config.numCities * sizeof(double));
+    pso.initializeParticles(config.numParticles, config.numCities);
+    double initial = pso.getGlobalBestFitness();
+    std::ofstream discard;
+    pso.runPSO(discard, config.numCities);
+
+    std::vector<int> route = pso.getGlobalBestRoute();
+    std::sort(route.begin(), route.end());
+    std::vector<int> expected(config.numCities);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(route, expected);
+    EXPECT_LT(pso.getGlobalBestFitness(), 0.2 * initial);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "localSearchDefinition.hpp"
+#include "testHelpers.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace {
+
+/**
+ * @brief Build a seeded instance and return a random tour over it.
+ */
+std::vector<int> randomTour(PSO &pso, int numCities, unsigned shuffleSeed) {
+    pso.setSeed(5);
+    pso.generateCityCoordinates(numCities);
+    pso.initializeDistanceMatrix();
+    std::vector<int> route(numCities);
+    std::iota(route.begin(), route.end(), 0);
+    std::shuffle(route.begin(), route.end(), std::mt19937(shuffleSeed));
+    return route;
+}
+
+double solve(MemeticMode mode, bool crossCheck) {
+    PSOConfig config;
+    config.numCities = 60;
+    config.numParticles = 4;
+    config.maxIterations = 20;
+    config.memeticMode = mode;
+    PSO pso;
+    runSeededSolve(pso, config, 17, [&](PSO &p) { p.setFitnessCrossCheck(crossCheck); });
+
+    std::vector<int> route = pso.getGlobalBestRoute();
+    EXPECT_TRUE(isPermutation(route, config.numCities));
+    EXPECT_NEAR(pso.getGlobalBestFitness(), pso.calculateDistance(route, config.numCities), 1e-9);
+    return pso.getGlobalBestFitness();
+}
+
+}
+
+TEST(LocalSearchTest, NeighbourListsAreNearestFirst) {
+    PSO pso;
+    randomTour(pso, 30, 1);
+    const DistanceMatrix &distances = pso.getDistanceMatrix();
+    NeighbourLists lists;
+    lists.build(distances, 5);
+    ASSERT_EQ(lists.size(), 30);
+    ASSERT_EQ(lists.getCount(), 5);
+    for (int city = 0; city < 30; city++) {
+        std::vector<double> others;
+        for (int other = 0; other < 30; other++) {
+            if (other != city) {
+                others.push_back(distances(city, other));
+            }
+        }
+        std::sort(others.begin(), others.end());
+        for (int k = 0; k < 5; k++) {
+            EXPECT_NE(lists[city][k], city);
+            EXPECT_DOUBLE_EQ(distances(city, lists[city][k]), others[k]);
+        }
+    }
+
+    lists.build(distances, 100);
+    EXPECT_EQ(lists.getCount(), 29);
+}
+
+TEST(LocalSearchTest, OptimizeKeepsAPermutationAndTracksItsLength) {
+    PSO pso;
+    std::vector<int> route = randomTour(pso, 200, 2);
+    NeighbourLists lists;
+    lists.build(pso.getDistanceMatrix(), 8);
+    LocalSearch search;
+    double before = pso.calculateDistance(route, 200);
+    double after = search.optimize(pso.getDistanceMatrix(), lists, std::span<int>(route), before);
+
+    EXPECT_TRUE(isPermutation(route, 200));
+    EXPECT_NEAR(after, pso.calculateDistance(route, 200), 1e-9 * before);
+    // A random tour is several times longer than a 2-opt local optimum
+    EXPECT_LT(after, 0.5 * before);
+    EXPECT_GT(search.getMovesApplied(), 0);
+}
+
+TEST(LocalSearchTest, RepeatedPassesConvergeToAFixedPoint) {
+    PSO pso;
+    std::vector<int> route = randomTour(pso, 80, 3);
+    NeighbourLists lists;
+    lists.build(pso.getDistanceMatrix(), 10);
+    LocalSearch search;
+    // Don't-look bits only requeue move endpoints, so a later pass may still find a few moves
+    double length = pso.calculateDistance(route, 80);
+    long long moves = -1;
+    for (int pass = 0; pass < 20 && search.getMovesApplied() != moves; pass++) {
+        moves = search.getMovesApplied();
+        double next = search.optimize(pso.getDistanceMatrix(), lists, std::span<int>(route), length);
+        EXPECT_LE(next, length);
+        length = next;
+    }
+    EXPECT_EQ(search.getMovesApplied(), moves);
+    EXPECT_NEAR(length, pso.calculateDistance(route, 80), 1e-9 * length);
+}
+
+TEST(LocalSearchTest, MemeticModesBeatSwapOnlyUpdates) {
+    double plain = solve(MemeticMode::Off, false);
+    EXPECT_LT(solve(MemeticMode::PersonalBest, true), plain);
+    EXPECT_LT(solve(MemeticMode::GlobalBest, true), plain);
+    EXPECT_LT(solve(MemeticMode::Both, true), 0.6 * plain);
+}
+
+TEST(LocalSearchTest, ParsesMemeticArguments) {
+    PSOConfig config;
+    EXPECT_TRUE(parseConfigArgument(config, "--memetic=both"));
+    EXPECT_TRUE(parseConfigArgument(config, "--neighbours=12"));
+    EXPECT_EQ(config.memeticMode, MemeticMode::Both);
+    EXPECT_EQ(config.neighbourCount, 12);
+    EXPECT_THROW(parseConfigArgument(config, "--memetic=sometimes"), std::invalid_argument);
+    config.neighbourCount = 0;
+    EXPECT_THROW(config.validate(), std::invalid_argument);
+}
@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "islandWorkerDefinition.hpp"
+#include "testHelpers.hpp"
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+std::string uniqueName(const std::string &prefix) {
+    return prefix + std::to_string(getpid()) + "-" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+MigrantPacket samplePacket(int worker, int epoch) {
+    MigrantPacket packet;
+    packet.worker = worker;
+    packet.epoch = epoch;
+    packet.bestFitness = 12.5 + epoch;
+    packet.routes = {{3, 1, 0, 2, 4}, {0, 1, 2, 3, 4}};
+    return packet;
+}
+
+void expectSamePacket(const MigrantPacket &a, const MigrantPacket &b) {
+    EXPECT_EQ(a.worker, b.worker);
+    EXPECT_EQ(a.epoch, b.epoch);
+    EXPECT_EQ(a.finished, b.finished);
+    EXPECT_DOUBLE_EQ(a.bestFitness, b.bestFitness);
+    EXPECT_EQ(a.routes, b.routes);
+}
+
+WorkerOptions workerOptions(int worker, int numWorkers) {
+    WorkerOptions options;
+    options.worker = worker;
+    options.numWorkers = numWorkers;
+    options.seed = 77;
+    options.config.numCities = 30;
+    options.config.numParticles = 4;
+    options.config.maxIterations = 40;
+    options.islandConfig.migrationInterval = 5;
+    options.islandConfig.numMigrants = 2;
+    return options;
+}
+
+/**
+ * @brief A raw connection to a relay, for sending requests a SocketTransport never would.
+ */
+int connectRaw(const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void sendPublishHeader(int fd, std::int32_t worker, std::int32_t numRoutes, std::int32_t numCities) {
+    unsigned char request[1 + 5 * sizeof(std::int32_t) + sizeof(double)] = {1};
+    std::int32_t header[5] = {worker, 0, 0, numRoutes, numCities};
+    double bestFitness = 1.0;
+    std::memcpy(request + 1, header, sizeof(header));
+    std::memcpy(request + 1 + sizeof(header), &bestFitness, sizeof(bestFitness));
+    ASSERT_EQ(::send(fd, request, sizeof(request), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(request)));
+}
+
+}
+
+TEST(MigrationTransportTest, MailboxSlotsRoundTripAcrossHandles) {
+    std::string name = "/" + uniqueName("pso-test-");
+    SharedMemoryMailbox owner(name, 3, 5, 2);
+    SharedMemoryMailbox other(name);
+    EXPECT_EQ(other.getNumWorkers(), 3);
+    EXPECT_EQ(other.getNumCities(), 5);
+
+    MigrantPacket packet;
+    EXPECT_FALSE(other.fetch(1, packet));
+    owner.publish(samplePacket(1, 4));
+    ASSERT_TRUE(other.fetch(1, packet));
+    expectSamePacket(packet, samplePacket(1, 4));
+
+    MigrantPacket last = samplePacket(1, 5);
+    last.finished = true;
+    last.routes.resize(1);
+    other.publish(last);
+    ASSERT_TRUE(owner.fetch(1, packet));
+    expectSamePacket(packet, last);
+    EXPECT_FALSE(owner.fetch(2, packet));
+}
+
+TEST(MigrationTransportTest, MailboxSurvivesAWriterDyingMidPublish) {
+    std::string name = "/" + uniqueName("pso-test-");
+    SharedMemoryMailbox mailbox(name, 2, 5, 2);
+    mailbox.publish(samplePacket(1, 1));
+
+    // Leave worker 1's sequence odd, as a crash between its two stores would
+    int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void *address = ::mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    ASSERT_NE(address, MAP_FAILED);
+    std::size_t slotBytes = (32 + 2 * 5 * sizeof(std::int32_t) + 63) / 64 * 64;
+    std::atomic_ref<std::uint64_t> sequence(*reinterpret_cast<std::uint64_t *>(static_cast<unsigned char *>(address) +
+                                                                                64 + slotBytes));
+    sequence.store(sequence.load() + 1);
+
+    MigrantPacket packet;
+    EXPECT_FALSE(mailbox.fetch(1, packet));
+    // A writer that carries on from the odd value still ends on an even one
+    mailbox.publish(samplePacket(1, 2));
+    EXPECT_EQ(sequence.load() % 2, 0u);
+    ASSERT_TRUE(mailbox.fetch(1, packet));
+    expectSamePacket(packet, samplePacket(1, 2));
+
+    sequence.store(sequence.load() + 1);
+    mailbox.recover(1);
+    EXPECT_FALSE(mailbox.fetch(1, packet));
+    mailbox.publish(samplePacket(1, 3));
+    ASSERT_TRUE(mailbox.fetch(1, packet));
+    expectSamePacket(packet, samplePacket(1, 3));
+    ::munmap(address, 4096);
+
+    MigrantPacket wrongCities = samplePacket(0, 1);
+    wrongCities.routes[1] = {0, 1, 2};
+    EXPECT_THROW(mailbox.publish(wrongCities), std::invalid_argument);
+    EXPECT_FALSE(mailbox.fetch(0, packet));
+}
+
+TEST(MigrationTransportTest, SocketRelayServesLatestPackets) {
+    std::string path = "/tmp/" + uniqueName("pso-test-") + ".sock";
+    SocketRelay relay(path, 2, 5, 2);
+    SocketTransport a(path);
+    SocketTransport b(path);
+
+    MigrantPacket packet;
+    EXPECT_FALSE(b.fetch(0, packet));
+    a.publish(samplePacket(0, 1));
+    a.publish(samplePacket(0, 2));
+    ASSERT_TRUE(b.fetch(0, packet));
+    expectSamePacket(packet, samplePacket(0, 2));
+    ASSERT_TRUE(relay.fetch(0, packet));
+    expectSamePacket(packet, samplePacket(0, 2));
+}
+
+TEST(MigrationTransportTest, SocketRelayDropsMalformedPacketsAndStalledRequests) {
+    std::string path = "/tmp/" + uniqueName("pso-test-") + ".sock";
+    SocketRelay relay(path, 2, 5, 2);
+    SocketTransport worker(path);
+
+    // A client that stops halfway through a request holds up no one else
+    int stalled = connectRaw(path);
+    ASSERT_GE(stalled, 0);
+    sendPublishHeader(stalled, 1, 2, 5);
+    worker.publish(samplePacket(0, 1));
+    MigrantPacket packet;
+    ASSERT_TRUE(worker.fetch(0, packet));
+    expectSamePacket(packet, samplePacket(0, 1));
+
+    // Counts that cannot be framed close the connection; the relay keeps serving
+    int corrupt = connectRaw(path);
+    ASSERT_GE(corrupt, 0);
+    sendPublishHeader(corrupt, 1, -1, 1 << 30);
+    unsigned char reply;
+    EXPECT_EQ(::recv(corrupt, &reply, 1, 0), 0);
+    ::close(corrupt);
+
+    // Well-framed packets of the wrong shape are acknowledged but not stored
+    MigrantPacket wrongCities = samplePacket(1, 1);
+    wrongCities.routes = {{0, 1, 2}};
+    worker.publish(wrongCities);
+    MigrantPacket tooMany = samplePacket(1, 2);
+    tooMany.routes.push_back(tooMany.routes.front());
+    worker.publish(tooMany);
+    EXPECT_FALSE(worker.fetch(1, packet));
+    ::close(stalled);
+}
+
+TEST(MigrationTransportTest, WorkersSolveTogetherThroughTheMailbox) {
+    std::string name = "/" + uniqueName("pso-test-");
+    constexpr int numWorkers = 3;
+    SharedMemoryMailbox mailbox(name, numWorkers, 30, 2);
+
+    std::vector<MigrantPacket> results(numWorkers);
+    std::vector<std::thread> workers;
+    for (int w = 0; w < numWorkers; w++) {
+        workers.emplace_back([&, w]() {
+            SharedMemoryMailbox handle(name);
+            results[w] = runIslandWorker(workerOptions(w, numWorkers), handle);
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    for (int w = 0; w < numWorkers; w++) {
+        MigrantPacket packet;
+        ASSERT_TRUE(mailbox.fetch(w, packet));
+        EXPECT_TRUE(packet.finished);
+        EXPECT_EQ(packet.epoch, 8);
+        expectSamePacket(packet, results[w]);
+        EXPECT_TRUE(isPermutation(packet.routes.front(), 30));
+    }
+}
+
+TEST(MigrationTransportTest, ResumedWorkerContinuesFromItsLastPacket) {
+    std::string name = "/" + uniqueName("pso-test-");
+    SharedMemoryMailbox mailbox(name, 1, 30, 2);
+
+    WorkerOptions options = workerOptions(0, 1);
+    MigrantPacket earlier = runIslandWorker(options, mailbox);
+    earlier.finished = false;
+    earlier.epoch = 3;
+    mailbox.publish(earlier);
+
+    options.resume = true;
+    MigrantPacket resumed = runIslandWorker(options, mailbox);
+    EXPECT_EQ(resumed.epoch, 8);
+    EXPECT_LE(resumed.bestFitness, earlier.bestFitness + 1e-9);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "psoDefinition.hpp"
+#include <cstdint>
 #include <random>
 
 class PSOTest : public::testing::Test {
@@ -30,3 +31,30 @@ TEST_F(PSOTest, CheckValidRoute) {
     EXPECT_EQ(testAlgo.getParticleList()[0]->getRoute().size(), 40);
 }
 
+TEST(SwarmTest, ParticleSlicesStartOnCacheLines) {
+    Swarm swarm;
+    auto aligned = [](const void *p) {return reinterpret_cast<std::uintptr_t>(p) % 64 == 0;};
+    swarm.resize(3, 13);
+    for (int numCities : {13, 21}) {
+        swarm.setNumCities(numCities);
+        for (int p = 0; p < swarm.size(); p++) {
+            EXPECT_TRUE(aligned(swarm.getRoute(p).data()));
+            EXPECT_TRUE(aligned(swarm.getBestRoute(p).data()));
+            EXPECT_TRUE(aligned(swarm.getVelocity(p).data()));
+            EXPECT_TRUE(aligned(swarm.getCandidateRoute(p).data()));
+            EXPECT_TRUE(aligned(swarm.getVisited(p).data()));
+            EXPECT_TRUE(aligned(swarm.getRandomDraws(p).data()));
+        }
+    }
+}
+
+TEST_F(PSOTest, CheckSwarmMatchesParticleSnapshot) {
+    const Swarm &swarm = testAlgo.getSwarm();
+    auto particles = testAlgo.getParticleList();
+    for (int p = 0; p < swarm.size(); p++) {
+        std::vector<int> route(swarm.getRoute(p).begin(), swarm.getRoute(p).end());
+        EXPECT_EQ(route, particles[p]->getRoute());
+        EXPECT_DOUBLE_EQ(swarm.getBestFitness(p), particles[p]->getBestFitness());
+    }
+}
+
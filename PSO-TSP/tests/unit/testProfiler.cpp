@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "profilerDefinition.hpp"
+#include "psoDefinition.hpp"
+#include <fstream>
+#include <sstream>
+
+TEST(ProfilerTest, TimerRecordsConsecutivePhasesAndCounters) {
+    Profiler profiler;
+    profiler.reset(2);
+    EXPECT_TRUE(profiler.empty());
+    {
+        ProfileTimer timer(&profiler, 1, ProfilePhase::Velocity);
+        timer.enter(ProfilePhase::Swaps);
+        timer.count(ProfileCounter::InvalidRoutes);
+        timer.enter(ProfilePhase::Swaps);
+    }
+    EXPECT_FALSE(profiler.empty());
+    EXPECT_EQ(profiler.getCalls(ProfilePhase::Velocity), 1);
+    EXPECT_EQ(profiler.getCalls(ProfilePhase::Swaps), 2);
+    EXPECT_EQ(profiler.getCount(ProfileCounter::InvalidRoutes), 1);
+    EXPECT_EQ(profiler.getNanos(0, ProfilePhase::Swaps), 0);
+    EXPECT_EQ(profiler.getEventCount(), 3u);
+}
+
+TEST(ProfilerTest, OutOfRangeSlotIsIgnored) {
+    Profiler profiler;
+    profiler.reset(1);
+    {
+        ProfileTimer timer(&profiler, 1, ProfilePhase::Trace);
+        timer.count(ProfileCounter::GlobalBestImprovements);
+    }
+    ProfileTimer unsized(nullptr, 0, ProfilePhase::Trace);
+    EXPECT_TRUE(profiler.empty());
+    EXPECT_EQ(profiler.getCount(ProfileCounter::GlobalBestImprovements), 0);
+}
+
+TEST(ProfilerTest, EventsAreCappedButTotalsAreKept) {
+    Profiler profiler;
+    profiler.reset(1, 4);
+    for (int i = 0; i < 10; i++) {
+        profiler.record(0, ProfilePhase::Fitness, i * 100, i * 100 + 50);
+    }
+    EXPECT_EQ(profiler.getEventCount(), 4u);
+    EXPECT_EQ(profiler.getCalls(ProfilePhase::Fitness), 10);
+    EXPECT_EQ(profiler.getNanos(ProfilePhase::Fitness), 500);
+}
+
+TEST(ProfilerTest, ChromeTraceAndSummaryNameThePhases) {
+    Profiler profiler;
+    profiler.reset(2);
+    profiler.record(0, ProfilePhase::Snapshot, 0, 2000);
+    profiler.record(1, ProfilePhase::Validation, 1000, 1500);
+    profiler.count(1, ProfileCounter::PersonalBestImprovements, 3);
+
+    std::ostringstream trace;
+    profiler.writeChromeTrace(trace);
+    std::string json = trace.str();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"Snapshot\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.000,\"dur\":2.000"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Validation\",\"ph\":\"X\",\"pid\":0,\"tid\":1,\"ts\":1.000,\"dur\":0.500"), std::string::npos);
+    EXPECT_NE(json.find("\"PersonalBestImprovements\":3"), std::string::npos);
+
+    std::ostringstream summary;
+    profiler.writeSummary(summary);
+    EXPECT_NE(summary.str().find("Snapshot"), std::string::npos);
+    EXPECT_EQ(summary.str().find("Velocity"), std::string::npos);
+}
+
+#ifdef PSO_PROFILING
+TEST(ProfilerTest, RunRecordsEveryParticleUpdate) {
+    PSO pso;
+    pso.setSeed(7);
+    pso.setNumThreads(2);
+    pso.setTraceSampling(TraceSampling::Off);
+    pso.generateCityCoordinates(NUM_CITIES);
+    pso.initializeDistanceMatrix();
+    pso.initializeParticles(NUM_PARTICLES, NUM_CITIES);
+    std::ofstream discard;
+    pso.runPSO(discard, NUM_CITIES);
+
+    const Profiler &profiler = pso.getProfiler();
+    std::int64_t updates = static_cast<std::int64_t>(NUM_PARTICLES) * MAX_ITERATIONS;
+    EXPECT_EQ(profiler.getCalls(ProfilePhase::Velocity), updates);
+    EXPECT_EQ(profiler.getCalls(ProfilePhase::Validation), updates);
+    EXPECT_EQ(profiler.getCalls(ProfilePhase::Snapshot), MAX_ITERATIONS);
+    EXPECT_EQ(profiler.getCount(ProfileCounter::InvalidRoutes) + profiler.getCalls(ProfilePhase::Fitness), updates);
+    EXPECT_EQ(profiler.getCalls(ProfilePhase::GlobalBest), profiler.getCalls(ProfilePhase::Fitness));
+    EXPECT_LE(profiler.getCount(ProfileCounter::GlobalBestImprovements), profiler.getCount(ProfileCounter::PersonalBestImprovements));
+}
+#endif
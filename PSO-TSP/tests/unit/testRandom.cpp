@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "randomDefinition.hpp"
+#include <fstream>
+
+TEST(RandomTest, StreamsAreReproducibleAndIndependent) {
+    PhiloxStream a(42, RandomDomain::ParticleUpdate, 3, 7);
+    PhiloxStream b(42, RandomDomain::ParticleUpdate, 3, 7);
+    PhiloxStream c(42, RandomDomain::ParticleUpdate, 4, 7);
+    int same = 0;
+    for (int k = 0; k < 100; k++) {
+        std::uint32_t x = a();
+        EXPECT_EQ(x, b());
+        same += x == c();
+    }
+    EXPECT_LT(same, 3);
+}
+
+TEST(RandomTest, BatchedDrawsMatchSingleDraws) {
+    PhiloxStream batched(9, RandomDomain::Cities, 0);
+    PhiloxStream single(9, RandomDomain::Cities, 0);
+    std::vector<double> draws(17);
+    batched.fillUniform(draws);
+    for (double d : draws) {
+        EXPECT_EQ(d, single.uniform());
+        EXPECT_GE(d, 0.0);
+        EXPECT_LT(d, 1.0);
+    }
+}
+
+TEST(RandomTest, SeededRunsAreBitReproducibleAcrossExecutionModes) {
+    auto solve = [](ExecutionMode mode, int threads) {
+        PSO algo;
+        algo.setSeed(1234);
+        algo.setExecutionMode(mode);
+        algo.setNumThreads(threads);
+        algo.setTraceSampling(TraceSampling::Off);
+        algo.generateCityCoordinates(NUM_CITIES);
+        algo.initializeDistanceMatrix();
+        algo.initializeParticles(16, NUM_CITIES);
+        std::ofstream discard;
+        algo.runPSO(discard, NUM_CITIES);
+        return std::make_pair(algo.getGlobalBestRoute(), algo.getGlobalBestFitness());
+    };
+    auto reference = solve(ExecutionMode::WorkStealingPool, 1);
+    EXPECT_EQ(solve(ExecutionMode::WorkStealingPool, 4), reference);
+    EXPECT_EQ(solve(ExecutionMode::ThreadPerParticle, 1), reference);
+}
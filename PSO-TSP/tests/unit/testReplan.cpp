@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "testHelpers.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+namespace {
+
+/**
+ * @brief Check that every route in the swarm visits each city once and that the
+ *        stored lengths match a full recompute.
+ */
+void expectConsistent(PSO &pso, int numCities) {
+    const Swarm &swarm = pso.getSwarm();
+    auto expectPermutation = [&](std::span<const int> route) {
+        std::vector<int> sorted(route.begin(), route.end());
+        std::sort(sorted.begin(), sorted.end());
+        std::vector<int> expected(numCities);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_EQ(sorted, expected);
+    };
+    for (int p = 0; p < swarm.size(); p++) {
+        ASSERT_EQ(swarm.getRoute(p).size(), static_cast<std::size_t>(numCities));
+        expectPermutation(swarm.getRoute(p));
+        expectPermutation(swarm.getBestRoute(p));
+        EXPECT_NEAR(swarm.getFitness(p), pso.calculateDistance(swarm.getRoute(p), numCities), 1e-6);
+        EXPECT_NEAR(swarm.getBestFitness(p), pso.calculateDistance(swarm.getBestRoute(p), numCities), 1e-6);
+        EXPECT_GE(swarm.getBestFitness(p), pso.getGlobalBestFitness() - 1e-9);
+    }
+    std::vector<int> best = pso.getGlobalBestRoute();
+    expectPermutation(best);
+    EXPECT_NEAR(pso.getGlobalBestFitness(), pso.calculateDistance(best, numCities), 1e-6);
+}
+
+/**
+ * @brief Check the solver's matrix against one built from scratch for its cities.
+ */
+void expectFreshMatrix(const PSO &pso) {
+    DistanceMatrix fresh;
+    fresh.build(pso.getCityList(), DistanceMatrix::Storage::Dense);
+    const DistanceMatrix &matrix = pso.getDistanceMatrix();
+    ASSERT_EQ(matrix.size(), fresh.size());
+    for (int i = 0; i < fresh.size(); i++) {
+        for (int j = 0; j < fresh.size(); j++) {
+            EXPECT_NEAR(matrix(i, j), fresh(i, j), 1e-12) << i << " " << j;
+        }
+    }
+}
+
+}
+
+class ReplanTest : public::testing::TestWithParam<DistanceMatrix::Storage> {
+    protected:
+        PSOConfig config;
+        PSO pso;
+        std::ofstream discard;
+
+        void SetUp() override {
+            config.numCities = 40;
+            config.numParticles = 12;
+            config.maxIterations = 25;
+            runSeededSolve(pso, config, 23, [this](PSO &p) {
+                p.setDistanceStorage(GetParam());
+                p.setFitnessCrossCheck(true);
+            });
+        }
+};
+
+TEST_P(ReplanTest, InsertedCitiesJoinEveryRoute) {
+    double before = pso.getGlobalBestFitness();
+    EXPECT_EQ(pso.insertCity(0.5, -0.25, 0.75), 40);
+    EXPECT_EQ(pso.insertCity(9.0, 9.0, 9.0), 41);
+    EXPECT_EQ(pso.getConfig().numCities, 42);
+    expectConsistent(pso, 42);
+    expectFreshMatrix(pso);
+    EXPECT_GE(pso.getGlobalBestFitness(), before - 1e-9);
+
+    pso.runPSO(discard, 42);
+    expectConsistent(pso, 42);
+
+    // Enough cities to outgrow the padded rows and the fixed-size kernels
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<> dis(-10.0, 10.0);
+    for (int i = 42; i < 70; i++) {
+        EXPECT_EQ(pso.insertCity(dis(gen), dis(gen), dis(gen)), i);
+    }
+    expectConsistent(pso, 70);
+    expectFreshMatrix(pso);
+    pso.runPSO(discard, 70);
+    expectConsistent(pso, 70);
+}
+
+TEST_P(ReplanTest, RemovedCitiesLeaveEveryRoute) {
+    auto [x, y, z] = pso.getCityList()[39]->getCoordinates();
+    EXPECT_EQ(pso.removeCity(7), 39);
+    EXPECT_EQ(pso.removeCity(38), -1);
+    ASSERT_EQ(pso.getCityList().size(), 38u);
+    EXPECT_EQ(pso.getCityList()[7]->getCoordinates(), std::make_tuple(x, y, z));
+    expectConsistent(pso, 38);
+    expectFreshMatrix(pso);
+
+    pso.runPSO(discard, 38);
+    expectConsistent(pso, 38);
+    EXPECT_THROW(pso.removeCity(38), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(Storages, ReplanTest,
+                         ::testing::Values(DistanceMatrix::Storage::Dense, DistanceMatrix::Storage::PackedUpper,
+                                           DistanceMatrix::Storage::OnDemand));
+
+TEST(ReplanSharedTest, SharedMatrixIsLeftAlone) {
+    PSO source;
+    source.setSeed(4);
+    source.generateCityCoordinates(30);
+    source.initializeDistanceMatrix();
+    PSO replanned;
+    replanned.shareInstance(source);
+    replanned.insertCity(1.0, 2.0, 3.0);
+    EXPECT_EQ(source.getDistanceMatrix().size(), 30);
+    EXPECT_EQ(replanned.getDistanceMatrix().size(), 31);
+    expectFreshMatrix(replanned);
+}
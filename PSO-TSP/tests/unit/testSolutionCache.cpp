@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "solutionCacheDefinition.hpp"
+#include "utils.hpp"
+#include "testHelpers.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::uint64_t EUCLIDEAN = SolutionCache::EUCLIDEAN_METRIC;
+
+std::vector<std::shared_ptr<City>> randomCities(int numCities, unsigned seed) {
+    std::vector<std::shared_ptr<City>> cityList;
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> coordinate(-1.0, 1.0);
+    for (int i = 0; i < numCities; i++) {
+        cityList.push_back(std::make_shared<City>(i));
+        cityList.back()->setCoordinates(coordinate(gen), coordinate(gen), coordinate(gen));
+    }
+    return cityList;
+}
+
+}
+
+class SolutionCacheTest : public::testing::Test {
+    protected:
+        std::string path = "solution_cache_test.psoc";
+
+        void SetUp() override {
+            std::remove(path.c_str());
+        }
+
+        void TearDown() override {
+            std::remove(path.c_str());
+        }
+};
+
+TEST_F(SolutionCacheTest, ExactHitIgnoresWaypointOrder) {
+    std::vector<std::shared_ptr<City>> cityList = randomCities(30, 1);
+    std::vector<int> route = identityRoute(30);
+    std::shuffle(route.begin(), route.end(), std::mt19937(2));
+    double length = tourLength(route, cityList);
+
+    SolutionCache cache(path);
+    EXPECT_FALSE(cache.lookup(cityList, EUCLIDEAN).has_value());
+    EXPECT_TRUE(cache.store(cityList, EUCLIDEAN, route, length));
+    EXPECT_EQ(cache.size(), 1);
+
+    // The same waypoints listed in another order find the same tour, in their own indices
+    std::vector<int> permutation = identityRoute(30);
+    std::shuffle(permutation.begin(), permutation.end(), std::mt19937(3));
+    std::vector<std::shared_ptr<City>> shuffled(30);
+    for (int i = 0; i < 30; i++) {
+        shuffled[i] = cityList[permutation[i]];
+    }
+    EXPECT_EQ(cache.fingerprint(shuffled, EUCLIDEAN), cache.fingerprint(cityList, EUCLIDEAN));
+    std::optional<CacheHit> hit = cache.lookup(shuffled, EUCLIDEAN);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_TRUE(hit->exact);
+    EXPECT_DOUBLE_EQ(hit->overlap, 1.0);
+    EXPECT_DOUBLE_EQ(hit->fitness, length);
+    ASSERT_EQ(hit->route.size(), 30u);
+    EXPECT_NEAR(tourLength(hit->route, shuffled), length, 1e-9);
+}
+
+TEST_F(SolutionCacheTest, ReopeningKeepsEntriesAndRepairsATruncatedTail) {
+    std::vector<std::shared_ptr<City>> first = randomCities(20, 4);
+    std::vector<std::shared_ptr<City>> second = randomCities(25, 5);
+    {
+        SolutionCache cache(path);
+        cache.store(first, EUCLIDEAN, identityRoute(20), tourLength(identityRoute(20), first));
+        cache.store(second, EUCLIDEAN, identityRoute(25), tourLength(identityRoute(25), second));
+    }
+    std::uintmax_t whole = std::filesystem::file_size(path);
+    {
+        SolutionCache cache(path);
+        EXPECT_EQ(cache.size(), 2);
+        ASSERT_TRUE(cache.lookup(first, EUCLIDEAN).has_value());
+        EXPECT_TRUE(cache.lookup(first, EUCLIDEAN)->exact);
+    }
+
+    // A record cut short by a crash is dropped and the earlier ones still read
+    std::filesystem::resize_file(path, whole - 5);
+    SolutionCache cache(path);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_TRUE(cache.lookup(first, EUCLIDEAN).has_value());
+    EXPECT_FALSE(cache.lookup(second, EUCLIDEAN, 1.0).has_value());
+    EXPECT_TRUE(cache.store(second, EUCLIDEAN, identityRoute(25), tourLength(identityRoute(25), second)));
+    EXPECT_EQ(SolutionCache(path).size(), 2);
+
+    std::ofstream(path, std::ios::trunc) << "not a cache";
+    EXPECT_THROW(SolutionCache{path}, std::runtime_error);
+}
+
+TEST_F(SolutionCacheTest, OtherMetricsAndImplausibleRecordsDoNotMatch) {
+    std::vector<std::shared_ptr<City>> cityList = randomCities(20, 10);
+    TSPInstance rounded{"rounded", cityList, std::make_shared<const std::vector<double>>(400, 1.0)};
+    std::uint64_t metric = SolutionCache::metricOf(rounded);
+    EXPECT_EQ(SolutionCache::metricOf(TSPInstance{"plain", cityList}), EUCLIDEAN);
+    EXPECT_NE(metric, EUCLIDEAN);
+    {
+        SolutionCache cache(path);
+        EXPECT_NE(cache.fingerprint(cityList, metric), cache.fingerprint(cityList, EUCLIDEAN));
+        cache.store(cityList, metric, identityRoute(20), 20.0);
+        EXPECT_FALSE(cache.lookup(cityList, EUCLIDEAN, 0.5).has_value());
+        ASSERT_TRUE(cache.lookup(cityList, metric).has_value());
+        EXPECT_DOUBLE_EQ(cache.lookup(cityList, metric)->fitness, 20.0);
+    }
+    std::uintmax_t whole = std::filesystem::file_size(path);
+
+    // A header claiming more waypoints than its payload could encode ends the file
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        const unsigned char record[32] = {4, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+        out.write(reinterpret_cast<const char *>(record), sizeof(record));
+        out.write("\0\0\0\0", 4);
+    }
+    SolutionCache cache(path);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(std::filesystem::file_size(path), whole);
+    EXPECT_TRUE(cache.lookup(cityList, metric).has_value());
+}
+
+TEST_F(SolutionCacheTest, NearHitKeepsTheSharedWaypoints) {
+    std::vector<std::shared_ptr<City>> cityList = randomCities(40, 6);
+    std::vector<int> route = identityRoute(40);
+    SolutionCache cache(path);
+    cache.store(cityList, EUCLIDEAN, route, tourLength(route, cityList));
+
+    // Drop three waypoints and add two new ones
+    std::vector<std::shared_ptr<City>> changed(cityList.begin() + 3, cityList.end());
+    std::vector<std::shared_ptr<City>> extra = randomCities(2, 7);
+    changed.insert(changed.end(), extra.begin(), extra.end());
+    std::optional<CacheHit> hit = cache.lookup(changed, EUCLIDEAN);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_FALSE(hit->exact);
+    EXPECT_DOUBLE_EQ(hit->overlap, 37.0 / 40.0);
+    std::vector<int> expected(37);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(hit->route, expected);
+
+    EXPECT_FALSE(cache.lookup(changed, EUCLIDEAN, 0.95).has_value());
+    EXPECT_FALSE(cache.lookup(randomCities(40, 8), EUCLIDEAN).has_value());
+}
+
+TEST_F(SolutionCacheTest, StoreKeepsOnlyShorterValidTours) {
+    std::vector<std::shared_ptr<City>> cityList = randomCities(15, 9);
+    SolutionCache cache(path);
+    EXPECT_TRUE(cache.store(cityList, EUCLIDEAN, identityRoute(15), 10.0));
+    EXPECT_FALSE(cache.store(cityList, EUCLIDEAN, identityRoute(15), 12.0));
+    EXPECT_FALSE(cache.store(cityList, EUCLIDEAN, identityRoute(15), 10.0));
+    EXPECT_TRUE(cache.store(cityList, EUCLIDEAN, identityRoute(15), 8.0));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_DOUBLE_EQ(cache.lookup(cityList, EUCLIDEAN)->fitness, 8.0);
+    EXPECT_DOUBLE_EQ(SolutionCache(path).lookup(cityList, EUCLIDEAN)->fitness, 8.0);
+
+    std::vector<int> repeated = identityRoute(15);
+    repeated[3] = 4;
+    EXPECT_THROW(cache.store(cityList, EUCLIDEAN, repeated, 1.0), std::invalid_argument);
+    EXPECT_THROW(cache.store(cityList, EUCLIDEAN, identityRoute(14), 1.0), std::invalid_argument);
+    EXPECT_THROW(SolutionCache("unused.psoc", 0.0), std::invalid_argument);
+}
+
+TEST_F(SolutionCacheTest, RepeatRunsSkipTheSearch) {
+    PSOConfig config;
+    config.numCities = 30;
+    config.numParticles = 10;
+    config.maxIterations = 40;
+    auto cache = std::make_shared<SolutionCache>(path);
+    std::vector<std::pair<int, double>> reported;
+    auto solve = [&](std::uint64_t seed, int numCities) {
+        reported.clear();
+        config.numCities = numCities;
+        auto pso = std::make_unique<PSO>();
+        runSeededSolve(*pso, config, seed, [&](PSO &p) {
+            p.setSolutionCache(cache);
+            p.setImprovementCallback([&](const BestImprovement &improvement) {
+                reported.emplace_back(improvement.iteration, improvement.fitness);
+            });
+        });
+        return pso;
+    };
+
+    std::unique_ptr<PSO> first = solve(11, 30);
+    EXPECT_EQ(first->getStopReason(), StopReason::MaxIterations);
+    EXPECT_EQ(cache->size(), 1);
+
+    std::unique_ptr<PSO> repeat = solve(11, 30);
+    EXPECT_EQ(repeat->getStopReason(), StopReason::CacheHit);
+    EXPECT_EQ(repeat->getIterationsRun(), 0);
+    EXPECT_NEAR(repeat->getGlobalBestFitness(), first->getGlobalBestFitness(), 1e-9);
+    EXPECT_NEAR(repeat->calculateDistance(repeat->getGlobalBestRoute(), 30), first->getGlobalBestFitness(), 1e-9);
+    ASSERT_EQ(reported.size(), 1u);
+    EXPECT_EQ(reported[0].first, 0);
+    EXPECT_NEAR(reported[0].second, first->getGlobalBestFitness(), 1e-9);
+
+    // The same seed's generator draws the first 30 cities again, so 32 cities are a near hit
+    std::unique_ptr<PSO> grown = solve(11, 32);
+    EXPECT_EQ(grown->getStopReason(), StopReason::MaxIterations);
+    std::vector<int> sorted = grown->getGlobalBestRoute();
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted, identityRoute(32));
+    EXPECT_EQ(cache->size(), 2);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "solveServiceDefinition.hpp"
+#include "testHelpers.hpp"
+#include <stdexcept>
+
+namespace {
+
+SolveRequest smallRequest(const std::string &name, std::uint64_t seed) {
+    SolveRequest request;
+    request.name = name;
+    request.seed = seed;
+    request.config.numCities = 30;
+    request.config.numParticles = 8;
+    request.config.maxIterations = 40;
+    return request;
+}
+
+}
+
+TEST(SolveServiceTest, ConcurrentJobsMatchSolvingThemOneByOne) {
+    std::vector<std::future<SolveResult>> futures;
+    {
+        SolveService service(3);
+        for (int i = 0; i < 12; i++) {
+            futures.push_back(service.submit(smallRequest("job" + std::to_string(i), 100 + i)));
+        }
+        service.waitIdle();
+        SolveServiceStats stats = service.getStats();
+        EXPECT_EQ(stats.submitted, 12u);
+        EXPECT_EQ(stats.completed, 12u);
+        EXPECT_EQ(stats.failed, 0u);
+        EXPECT_EQ(service.queued(), 0);
+    }
+    for (int i = 0; i < 12; i++) {
+        SolveResult result = futures[i].get();
+        SolveResult expected = solveRequest(smallRequest("job" + std::to_string(i), 100 + i));
+        EXPECT_EQ(result.name, expected.name);
+        EXPECT_TRUE(isPermutation(result.route, 30));
+        EXPECT_EQ(result.route, expected.route);
+        EXPECT_DOUBLE_EQ(result.fitness, expected.fitness);
+        EXPECT_EQ(result.iterations, 40);
+        EXPECT_GE(result.queuedMs, 0.0);
+    }
+}
+
+TEST(SolveServiceTest, HigherPriorityJobsStartFirst) {
+    SolveService service(1);
+    SolveRequest blocker = smallRequest("blocker", 1);
+    blocker.config.numCities = 150;
+    blocker.config.maxIterations = 200;
+    std::future<SolveResult> first = service.submit(blocker);
+    SolveRequest low = smallRequest("low", 2);
+    low.priority = -1;
+    SolveRequest high = smallRequest("high", 3);
+    high.priority = 5;
+    std::future<SolveResult> lowResult = service.submit(low);
+    std::future<SolveResult> highResult = service.submit(high);
+    // The single worker runs high before low, so low waits through high as well
+    EXPECT_LT(highResult.get().queuedMs, lowResult.get().queuedMs);
+    first.get();
+}
+
+TEST(SolveServiceTest, BudgetsAndInstancesApplyPerJob) {
+    auto instance = std::make_shared<TSPInstance>(loadInstance(PSO_INSTANCE_DIR "/berlin52.tsp"));
+    SolveService service(2);
+    SolveRequest onInstance = smallRequest("berlin", 9);
+    onInstance.instance = instance;
+    SolveRequest stalled = smallRequest("stalled", 9);
+    stalled.config.maxIterations = 100000;
+    stalled.config.stallIterations = 5;
+    std::future<SolveResult> instanceResult = service.submit(onInstance);
+    std::future<SolveResult> stalledResult = service.submit(stalled);
+
+    SolveResult berlin = instanceResult.get();
+    EXPECT_TRUE(isPermutation(berlin.route, 52));
+    EXPECT_DOUBLE_EQ(berlin.fitness, instance->tourLength(berlin.route));
+    EXPECT_NEAR(berlin.gap, optimalityGap(berlin.fitness, 7542.0), 1e-12);
+    SolveResult early = stalledResult.get();
+    EXPECT_EQ(early.stopReason, StopReason::Stalled);
+    EXPECT_LT(early.iterations, 100000);
+}
+
+TEST(SolveServiceTest, RejectsInvalidJobsAtSubmission) {
+    EXPECT_THROW(SolveService(0), std::invalid_argument);
+    SolveService service(1);
+    SolveRequest invalid = smallRequest("invalid", 1);
+    invalid.config.numParticles = 0;
+    EXPECT_THROW(service.submit(invalid), std::invalid_argument);
+    EXPECT_EQ(service.getStats().submitted, 0u);
+}
+
+TEST(SolveServiceTest, ParsesJobLinesAndFormatsResults) {
+    SolveRequest request;
+    for (std::string argument : {"--name=drone7", "--priority=3", "--seed=42", "--cities=12",
+                                 "--distances=packed", "--time-budget-ms=25"}) {
+        EXPECT_TRUE(parseSolveArgument(request, argument)) << argument;
+    }
+    EXPECT_FALSE(parseSolveArgument(request, "--bogus=1"));
+    EXPECT_THROW(parseSolveArgument(request, "--distances=sparse"), std::invalid_argument);
+    EXPECT_EQ(request.name, "drone7");
+    EXPECT_EQ(request.priority, 3);
+    EXPECT_EQ(request.seed, 42u);
+    EXPECT_EQ(request.config.numCities, 12);
+    EXPECT_EQ(request.distanceStorage, DistanceMatrix::Storage::PackedUpper);
+    EXPECT_EQ(request.config.timeBudgetMs, 25.0);
+
+    SolveResult result;
+    result.name = "drone7";
+    result.route = {2, 0, 1};
+    result.fitness = 4.5;
+    result.stopReason = StopReason::MaxIterations;
+    result.iterations = 10;
+    std::string line = formatSolveResult(result);
+    EXPECT_EQ(line.rfind("drone7 ok distance=4.5 ", 0), 0u) << line;
+    EXPECT_NE(line.find(" stop=max-iterations iterations=10 "), std::string::npos) << line;
+    EXPECT_EQ(line.substr(line.size() - 12), " route=2,0,1");
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "swarmHistoryDefinition.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+class SwarmHistoryTest : public::testing::Test {
+    protected:
+        std::string path = "swarm_history_test.bin";
+        std::vector<std::shared_ptr<City>> cityList;
+
+        void SetUp() override {
+            for (int i = 0; i < 5; i++) {
+                cityList.push_back(std::make_shared<City>(i));
+                cityList[i]->setCoordinates(i, 2.0 * i, 0.5);
+            }
+        }
+
+        void TearDown() override {
+            std::remove(path.c_str());
+        }
+};
+
+TEST_F(SwarmHistoryTest, RoundTripsFullAndDeltaRecords) {
+    std::vector<std::vector<int>> routes = {{0, 1, 2, 3, 4}, {0, 1, 3, 2, 4}, {4, 3, 2, 1, 0}, {4, 3, 2, 1, 0}};
+    {
+        SwarmHistoryWriter writer(path, cityList, 2);
+        for (int k = 0; k < static_cast<int>(routes.size()); k++) {
+            writer.write(TraceRecord{k, k % 2, 10.0 + k, routes[k]});
+            writer.write(TraceRecord{k, 1 - k % 2, 20.0 + k, routes[k]});
+        }
+    }
+    SwarmHistoryReader reader(path);
+    EXPECT_EQ(reader.getNumCities(), 5);
+    EXPECT_EQ(reader.getNumParticles(), 2);
+    EXPECT_DOUBLE_EQ(std::get<1>(reader.getCoordinates()[3]), 6.0);
+
+    TraceRecord record{};
+    for (int k = 0; k < static_cast<int>(routes.size()); k++) {
+        ASSERT_TRUE(reader.next(record));
+        EXPECT_EQ(record.iteration, k);
+        EXPECT_DOUBLE_EQ(record.fitness, 10.0 + k);
+        EXPECT_EQ(std::vector<int>(record.route.begin(), record.route.end()), routes[k]);
+        ASSERT_TRUE(reader.next(record));
+        EXPECT_DOUBLE_EQ(record.fitness, 20.0 + k);
+        EXPECT_EQ(std::vector<int>(record.route.begin(), record.route.end()), routes[k]);
+    }
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(SwarmHistoryTest, UnchangedRecordsTakeFourBytesAndBadOnesAreRejected) {
+    std::vector<int> route = {0, 1, 2, 3, 4};
+    std::uintmax_t first;
+    {
+        SwarmHistoryWriter writer(path, cityList, 2);
+        writer.write(TraceRecord{0, 1, 123.456, route});
+        writer.flush();
+        first = std::filesystem::file_size(path);
+        // Iteration, particle, fitness XOR and an empty delta tag are one byte each
+        writer.write(TraceRecord{1, 1, 123.456, route});
+        writer.flush();
+        EXPECT_EQ(std::filesystem::file_size(path), first + 4);
+
+        EXPECT_THROW(writer.write(TraceRecord{2, 2, 1.0, route}), std::invalid_argument);
+        EXPECT_THROW(writer.write(TraceRecord{2, -1, 1.0, route}), std::invalid_argument);
+        std::vector<int> shorter = {0, 1, 2};
+        EXPECT_THROW(writer.write(TraceRecord{2, 0, 1.0, shorter}), std::invalid_argument);
+    }
+    SwarmHistoryReader reader(path);
+    TraceRecord record{};
+    ASSERT_TRUE(reader.next(record));
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.fitness, 123.456);
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(SwarmHistoryTest, HeaderCountsMustFitTheFile) {
+    {
+        SwarmHistoryWriter writer(path, cityList, 2);
+    }
+    auto patchU32 = [&](std::streamoff at, std::uint32_t value) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(at);
+        for (int i = 0; i < 4; i++) {
+            file.put(static_cast<char>(value >> (8 * i)));
+        }
+    };
+    patchU32(8, 6);
+    EXPECT_THROW(SwarmHistoryReader{path}, std::runtime_error);
+    patchU32(8, 0xffffffffu);
+    EXPECT_THROW(SwarmHistoryReader{path}, std::runtime_error);
+    patchU32(8, 5);
+    patchU32(12, 0x7fffffffu);
+    EXPECT_THROW(SwarmHistoryReader{path}, std::runtime_error);
+    patchU32(12, 2);
+    SwarmHistoryReader reader(path);
+    TraceRecord record{};
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(SwarmHistoryTest, ConvertsToParticleCsv) {
+    {
+        SwarmHistoryWriter writer(path, cityList, 1);
+        std::vector<int> route = {2, 0, 1, 4, 3};
+        writer.write(TraceRecord{0, 0, 1.5, route});
+    }
+    SwarmHistoryReader reader(path);
+    std::ostringstream csv;
+    convertHistoryToCsv(reader, csv);
+    EXPECT_EQ(csv.str(), "Iteration,ParticleID,City0,City1,City2,City3,City4,Fitness\n0,0,2,0,1,4,3,1.5\n");
+}
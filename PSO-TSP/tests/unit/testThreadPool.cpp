@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "threadPoolDefinition.hpp"
+#include "psoDefinition.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(1000);
+    pool.parallelFor(1000, [&](int i) { visits[i]++; });
+    for (auto &v : visits) {
+        EXPECT_EQ(v.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, WorkersAreReusedAcrossCalls) {
+    ThreadPool pool(2);
+    std::atomic<int> total{0};
+    for (int round = 0; round < 50; round++) {
+        pool.parallelFor(7, [&](int) { total++; });
+    }
+    EXPECT_EQ(total.load(), 350);
+    EXPECT_EQ(pool.size(), 2);
+}
+
+TEST(ThreadPoolTest, ExceptionIsRethrownToCaller) {
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallelFor(10, [](int i) {
+        if (i == 3) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, ConcurrentAndNestedCallsKeepTheirOwnResults) {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> visits(4 * 100);
+    auto caller = [&](int first, bool fail) {
+        return std::thread([&, first, fail]() {
+            for (int round = 0; round < 20; round++) {
+                try {
+                    pool.parallelFor(100, [&](int i) {
+                        visits[first + i]++;
+                        if (fail && i == 50) {
+                            throw std::runtime_error("task failed");
+                        }
+                    });
+                    EXPECT_FALSE(fail);
+                } catch (const std::runtime_error &) {
+                    EXPECT_TRUE(fail);
+                }
+            }
+        });
+    };
+    std::thread a = caller(0, false);
+    std::thread b = caller(100, true);
+    a.join();
+    b.join();
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(visits[i].load(), 20) << i;
+    }
+
+    // Every outer body waits on an inner call; the waiting workers run the inner chunks
+    pool.parallelFor(2, [&](int outer) {
+        pool.parallelFor(100, [&](int i) { visits[200 + 100 * outer + i]++; });
+    });
+    for (int i = 200; i < 400; i++) {
+        EXPECT_EQ(visits[i].load(), 1) << i;
+    }
+}
+
+TEST(ThreadPoolTest, BothExecutionModesProduceValidRoutes) {
+    for (ExecutionMode mode : {ExecutionMode::ThreadPerParticle, ExecutionMode::WorkStealingPool}) {
+        PSO algo;
+        algo.setExecutionMode(mode);
+        algo.setNumThreads(2);
+        algo.generateCityCoordinates(NUM_CITIES);
+        algo.initializeDistanceMatrix();
+        algo.initializeParticles(NUM_PARTICLES, NUM_CITIES);
+        std::ofstream discard;
+        algo.runPSO(discard, NUM_CITIES);
+
+        std::vector<int> route = algo.getGlobalBestRoute();
+        std::sort(route.begin(), route.end());
+        for (int i = 0; i < NUM_CITIES; i++) {
+            EXPECT_EQ(route[i], i);
+        }
+    }
+}
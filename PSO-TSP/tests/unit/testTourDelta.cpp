@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "psoDefinition.hpp"
+#include "tourDeltaDefinition.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <random>
+
+class TourDeltaTest : public::testing::Test {
+    protected:
+        PSO testAlgo;
+        std::vector<int> route;
+
+        void SetUp() override {
+            testAlgo.generateCityCoordinates(12);
+            testAlgo.initializeDistanceMatrix();
+            route.resize(12);
+            std::iota(route.begin(), route.end(), 0);
+        }
+};
+
+TEST_F(TourDeltaTest, SwapDeltaMatchesFullRecompute) {
+    const DistanceMatrix &distances = testAlgo.getDistanceMatrix();
+    double length = testAlgo.calculateDistance(route, 12);
+    IncrementalTour tour(distances, std::span<int>(route), length);
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<> pos(0, 11);
+    // Include adjacent and wrap-around swaps explicitly.
+    std::vector<std::pair<int, int>> moves = {{0, 1}, {11, 0}, {5, 6}, {3, 3}};
+    for (int k = 0; k < 200; k++) {
+        moves.emplace_back(pos(gen), pos(gen));
+    }
+    for (auto [i, j] : moves) {
+        tour.swap(i, j);
+        EXPECT_NEAR(tour.getLength(), testAlgo.calculateDistance(route, 12), 1e-9);
+    }
+}
+
+TEST_F(TourDeltaTest, TwoOptDeltaMatchesFullRecompute) {
+    const DistanceMatrix &distances = testAlgo.getDistanceMatrix();
+    double length = testAlgo.calculateDistance(route, 12);
+    IncrementalTour tour(distances, std::span<int>(route), length);
+    std::vector<std::pair<int, int>> moves = {{0, 11}, {0, 4}, {3, 11}, {2, 3}, {6, 9}};
+    for (auto [i, j] : moves) {
+        tour.twoOpt(i, j);
+        EXPECT_NEAR(tour.getLength(), testAlgo.calculateDistance(route, 12), 1e-9);
+    }
+}
+
+TEST(TourDeltaPSOTest, CrossCheckAcceptsIncrementalFitness) {
+    PSO algo;
+    algo.setFitnessCrossCheck(true);
+    algo.generateCityCoordinates(NUM_CITIES);
+    algo.initializeDistanceMatrix();
+    algo.initializeParticles(NUM_PARTICLES, NUM_CITIES);
+    std::ofstream discard;
+    EXPECT_NO_THROW(algo.runPSO(discard, NUM_CITIES));
+}
+
+TEST_F(TourDeltaTest, InsertionAndRemovalDeltasMatchFullRecompute) {
+    const DistanceMatrix &distances = testAlgo.getDistanceMatrix();
+    std::shuffle(route.begin(), route.end(), std::mt19937(5));
+    int city = route.back();
+    std::vector<int> partial(route.begin(), route.end() - 1);
+    double partialLength = 0.0;
+    for (int i = 0; i < 11; i++) {
+        partialLength += distances(partial[i], partial[(i + 1) % 11]);
+    }
+    auto [position, delta] = cheapestInsertion(distances, std::span<const int>(partial), city);
+    std::vector<int> inserted = partial;
+    inserted.insert(inserted.begin() + position, city);
+    EXPECT_NEAR(testAlgo.calculateDistance(inserted, 12), partialLength + delta, 1e-9);
+    // No other position is cheaper
+    for (int k = 0; k <= 11; k++) {
+        std::vector<int> other = partial;
+        other.insert(other.begin() + k, city);
+        EXPECT_GE(testAlgo.calculateDistance(other, 12), partialLength + delta - 1e-9);
+    }
+    EXPECT_NEAR(removalDelta(distances, std::span<const int>(inserted), position), -delta, 1e-9);
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "traceLoggerDefinition.hpp"
+#include <sstream>
+#include <vector>
+
+TEST(TraceLoggerTest, RecordsAreWrittenInIterationOrder) {
+    std::vector<std::pair<int, int>> written;
+    {
+        TraceLogger logger([&](const TraceRecord &r) { written.emplace_back(r.iteration, r.particleId); },
+                           2, 3, TraceSampling::EveryKth, 1, 4);
+        std::vector<int> route = {0, 1, 2};
+        for (int iter = 0; iter < 20; iter++) {
+            logger.log(0, iter, 0, 1.0, route);
+            logger.log(1, iter, 1, 1.0, route);
+            logger.endIteration(iter);
+        }
+    }
+    ASSERT_EQ(written.size(), 40u);
+    for (std::size_t k = 1; k < written.size(); k++) {
+        EXPECT_LE(written[k - 1].first, written[k].first);
+    }
+}
+
+TEST(TraceLoggerTest, CsvSinkMatchesParticleDataLayout) {
+    std::ostringstream out;
+    {
+        TraceLogger logger(makeCsvTraceSink(out), 1, 3);
+        std::vector<int> route = {2, 0, 1};
+        logger.log(0, 4, 1, 2.5, route);
+    }
+    EXPECT_EQ(out.str(), "4,1,2,0,1,2.5\n");
+}
+
+TEST(TraceLoggerTest, SamplingPolicies) {
+    TraceLogger off([](const TraceRecord &) {}, 1, 1, TraceSampling::Off);
+    TraceLogger every([](const TraceRecord &) {}, 1, 1, TraceSampling::EveryKth, 5);
+    TraceLogger best([](const TraceRecord &) {}, 1, 1, TraceSampling::BestOnly);
+    EXPECT_FALSE(off.wants(0, true));
+    EXPECT_TRUE(every.wants(10, false));
+    EXPECT_FALSE(every.wants(11, true));
+    EXPECT_TRUE(best.wants(11, true));
+    EXPECT_FALSE(best.wants(10, false));
+}